@@ -6,8 +6,9 @@
 
 #ifndef BOARD_H
 #define BOARD_H
+#include <cstdint>
 #include <set>
-#include <vector>
+#include "MoveList.h"
 
 /**
  * @class Board
@@ -16,20 +17,41 @@
  * The Board stores whether each square is covered and provides helpers to
  * calculate sums, validate combinations of squares for covering/uncovering,
  * and determine when throwing a single die is allowed.
+ *
+ * Covered squares are kept in a fixed-width bitmask where bit i represents
+ * square i (bit 0 is unused), so every state query is a mask test or a
+ * popcount and the covered sum is maintained incrementally.
  */
 class Board {
 public:
     static constexpr int ONE_DIE_RULE_START = 7; /**< Minimum board value where one-die rule applies */
+    static constexpr int MAX_SIZE = 31; /**< Largest board representable by the 32-bit mask */
+
+    /**
+     * @brief Undo token returned by applyMove(): the board state before the move.
+     */
+    struct Undo {
+        std::uint32_t coveredMask; /**< covered squares before the move */
+        int coveredSum; /**< covered sum before the move */
+    };
 
     /** Default constructor - creates an empty board. */
-    Board() : squares(), size(0) {}
+    Board() : Board(0) {}
 
     /**
      * @brief Constructs a board with n squares (1..n)
-     * @param n Number of squares on the board
+     * @param n Number of squares on the board (clamped to 0..MAX_SIZE)
      */
-    explicit Board(int n) : squares(n, false), size(n) {}
+    explicit Board(int n);
     Board(const Board&) = default;
+    Board& operator=(const Board&) = default;
+
+    /**
+     * @brief Returns the mask bit representing a square.
+     * @param square The square index (1..MAX_SIZE)
+     * @return Mask with only the bit for `square` set
+     */
+    static constexpr std::uint32_t bitOf(int square) { return std::uint32_t{1} << square; }
 
     /**
      * @brief Cover the given square index (1-based).
@@ -45,6 +67,24 @@ public:
      */
     bool uncoverSquare(int square);
 
+    /**
+     * @brief Cover or uncover every square of a combination in one step.
+     *        Squares off the board, and squares already in the requested state, are left alone.
+     * @param combo Combination mask (bit i == square i)
+     * @param covering true to cover the squares, false to uncover them
+     * @return Token that undoMove() takes to restore the board
+     */
+    Undo applyMove(std::uint32_t combo, bool covering);
+
+    /**
+     * @brief Take back a move made with applyMove(). Moves must be undone in reverse order.
+     * @param undo Token returned by the matching applyMove()
+     */
+    void undoMove(const Undo& undo) {
+        coveredMask = undo.coveredMask;
+        coveredSum  = undo.coveredSum;
+    }
+
     /**
      * @brief Query whether a square is covered.
      * @param square The square to query (1..size)
@@ -88,6 +128,24 @@ public:
      */
     std::set<std::set<int>> findValidCombinations(int sum, bool forCovering) const;
 
+    /**
+     * @brief Allocation-free variant of findValidCombinations for dice sums.
+     * @param sum Dice sum (1..MoveTable::MAX_SUM); other sums yield an empty list
+     * @param forCovering true when searching combinations for covering; false for uncovering
+     * @return Combination masks in the same order findValidCombinations iterates
+     */
+    MoveList findValidMoves(int sum, bool forCovering) const;
+
+    /**
+     * @brief Answers whether any legal combination exists without enumerating one,
+     *        using a shift-or subset-sum reachability bitset over the available squares.
+     * @param sum Target sum
+     * @param forCovering true when searching combinations for covering; false for uncovering
+     * @param excludedMask Squares that may not be used (e.g. a protected advantage square)
+     * @return true if at least one combination of eligible squares adds up to `sum`
+     */
+    bool hasValidMove(int sum, bool forCovering, std::uint32_t excludedMask = 0) const;
+
     /**
      * @brief Determines whether the given combination is valid for covering/uncovering.
      * @param combination Set of indices representing the combination
@@ -96,18 +154,53 @@ public:
      */
     bool isValidCombination(const std::set<int> &combination, bool forCovering) const;
 
+    /**
+     * @brief Mask form of isValidCombination, for replaying recorded moves.
+     * @param combo Squares of the combination (bit i == square i); each must be on the board
+     * @param forCovering true when validating for covering, false for uncovering
+     * @return true if the combination is valid
+     */
+    bool isValidCombination(std::uint32_t combo, bool forCovering) const {
+        return (combo & ~getAvailableMask(forCovering)) == 0;
+    }
+
     /**
      * @brief Returns whether the one-die rule applies (i.e. only one die may be thrown).
      * @return true if one-die throws are allowed for this board state
      */
     bool canThrowOneDie() const;
 
+    /**
+     * @brief Returns the covered squares as a bitmask (bit i == square i).
+     * @return Mask of covered squares
+     */
+    std::uint32_t getCoveredMask() const { return coveredMask; }
+
+    /**
+     * @brief Returns the mask of every square on the board (bits 1..size).
+     * @return Mask of all squares
+     */
+    std::uint32_t getFullMask() const { return fullMask; }
+
+    /**
+     * @brief Returns the squares eligible for a cover or uncover move.
+     * @param forCovering true for uncovered squares (cover candidates); false for covered squares
+     * @return Mask of squares available for the requested action
+     */
+    std::uint32_t getAvailableMask(bool forCovering) const {
+        return forCovering ? (fullMask & ~coveredMask) : coveredMask;
+    }
+
 protected:
     // Protected members (none currently, but place here if added)
 
 private:
-    std::vector<bool> squares; /**< true == covered */
+    std::uint32_t coveredMask; /**< bit i set == square i covered */
+    std::uint32_t fullMask; /**< bits 1..size set */
+    std::uint32_t oneDieMask; /**< bits ONE_DIE_RULE_START..size set */
     int size; /**< number of squares on the board */
+    int totalSum; /**< sum of 1..size */
+    int coveredSum; /**< running sum of covered square indices */
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,155 @@
+/**
+ * @file BoardSpec.h
+ * @brief Declares BoardSpec, the board-size-dependent constants and tables of
+ *        the engine generated at compile time for sizes 9, 10 and 11, its
+ *        runtime counterpart for other sizes, and the dispatcher between them.
+ */
+
+#ifndef BOARDSPEC_H
+#define BOARDSPEC_H
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include "Board.h"
+#include "MoveTable.h"
+
+inline constexpr int MAX_TABLED_BOARD_SIZE = 12; /**< Largest board given a square-sum table (as for the Solver) */
+
+/**
+ * @brief The MoveTable entries of one dice sum that fit on a board, in MoveTable order.
+ */
+struct SumCombos {
+    std::array<std::uint32_t, MoveTable::MAX_COMBOS_PER_SUM> masks{}; /**< combination masks */
+    int count = 0; /**< number of valid entries */
+
+    /** @return First mask. */
+    constexpr const std::uint32_t* begin() const { return masks.data(); }
+    /** @return One past the last mask. */
+    constexpr const std::uint32_t* end() const { return masks.data() + count; }
+};
+
+/**
+ * @brief Build the per-sum move lists of a board, ordered like MoveTable.
+ * @param fullMask Squares on the board
+ * @return Lists indexed by sum (0..MoveTable::MAX_SUM; sum 0 is empty)
+ */
+constexpr std::array<SumCombos, MoveTable::MAX_SUM + 1> makeSumCombos(const std::uint32_t fullMask) {
+    std::array<SumCombos, MoveTable::MAX_SUM + 1> table{};
+    for (std::uint32_t bits = 1; bits < (std::uint32_t{1} << MoveTable::MAX_SUM); ++bits) {
+        const std::uint32_t mask = bits << 1;
+        if ((mask & ~fullMask) != 0) continue;
+        int sum = 0;
+        for (std::uint32_t rest = mask; rest != 0; rest &= rest - 1) sum += std::countr_zero(rest);
+        if (sum > MoveTable::MAX_SUM) continue;
+        // Insertion sort keeps the std::set order MoveTable uses.
+        SumCombos& list = table[sum];
+        int at = list.count++;
+        for (; at > 0 && MoveTable::comboLess(mask, list.masks[at - 1]); --at) list.masks[at] = list.masks[at - 1];
+        list.masks[at] = mask;
+    }
+    return table;
+}
+
+/**
+ * @struct BoardSpec
+ * @brief Everything about a board of N squares that the engine's inner loops
+ *        need, as compile-time constants.
+ *
+ * Code written against a spec (the Simulator's rounds, the Solver's sweeps,
+ * the mask form of strategy::computeBestMove) is a template over the spec
+ * type. With a BoardSpec every mask, sum table and move list is a constant of
+ * the instantiation, so those loops carry no board-size checks or loads;
+ * RuntimeBoardSpec offers the same interface for the other sizes. The
+ * accessors are static, so they can be called on a spec object either way.
+ *
+ * @tparam N Squares on the board (1..MAX_TABLED_BOARD_SIZE)
+ */
+template <int N>
+struct BoardSpec {
+    static_assert(N >= 1 && N <= MAX_TABLED_BOARD_SIZE, "BoardSpec covers boards of 1 to 12 squares");
+
+    static constexpr std::uint32_t FULL_MASK = ((std::uint32_t{1} << N) - 1) << 1; /**< bits 1..N */
+    static constexpr std::uint32_t ONE_DIE_MASK =
+        FULL_MASK & ~((std::uint32_t{1} << Board::ONE_DIE_RULE_START) - 1); /**< squares that unlock one die */
+    static constexpr std::array<SumCombos, MoveTable::MAX_SUM + 1> COMBOS = makeSumCombos(FULL_MASK); /**< moves per sum */
+    /** @brief Sum of the squares in every mask, indexed by mask >> 1. */
+    static constexpr std::array<std::uint8_t, std::size_t{1} << N> SQUARE_SUMS = [] {
+        std::array<std::uint8_t, std::size_t{1} << N> sums{};
+        for (std::uint32_t bits = 1; bits < sums.size(); ++bits) {
+            const int square = std::bit_width(bits);
+            sums[bits] = static_cast<std::uint8_t>(sums[bits & ~(std::uint32_t{1} << (square - 1))] + square);
+        }
+        return sums;
+    }();
+
+    /** @return Squares on the board. */
+    static constexpr int size() { return N; }
+    /** @return Mask of every square. */
+    static constexpr std::uint32_t fullMask() { return FULL_MASK; }
+    /** @return Whether one die may be thrown with these squares covered. */
+    static constexpr bool canThrowOneDie(const std::uint32_t covered) { return (covered & ONE_DIE_MASK) == ONE_DIE_MASK; }
+    /** @return Sum of the squares in a mask of this board. */
+    static constexpr int squareSum(const std::uint32_t mask) { return SQUARE_SUMS[mask >> 1]; }
+    /** @return The board's moves for a dice sum (1..MoveTable::MAX_SUM). */
+    static constexpr const SumCombos& combos(const int sum) { return COMBOS[sum]; }
+};
+
+/**
+ * @class RuntimeBoardSpec
+ * @brief BoardSpec's interface for a board size known only at run time.
+ */
+class RuntimeBoardSpec {
+public:
+    /**
+     * @brief Build the tables for a board.
+     * @param boardSize Squares on the board (clamped to 0..Board::MAX_SIZE)
+     */
+    explicit RuntimeBoardSpec(int boardSize);
+
+    /**
+     * @brief Returns the process-wide spec of a size, building it on first use.
+     * @param boardSize Squares on the board (clamped to 0..Board::MAX_SIZE)
+     * @return Reference to the immutable spec
+     */
+    static const RuntimeBoardSpec& forSize(int boardSize);
+
+    /** @return Squares on the board. */
+    int size() const { return boardSize; }
+    /** @return Mask of every square. */
+    std::uint32_t fullMask() const { return full; }
+    /** @return Whether one die may be thrown with these squares covered. */
+    bool canThrowOneDie(const std::uint32_t covered) const { return (covered & oneDie) == oneDie; }
+    /** @return Sum of the squares in a mask of this board. */
+    int squareSum(std::uint32_t mask) const;
+    /** @return The board's moves for a dice sum (1..MoveTable::MAX_SUM). */
+    const SumCombos& combos(const int sum) const { return sumCombos[sum]; }
+
+private:
+    int boardSize; /**< squares on the board */
+    std::uint32_t full; /**< bits 1..boardSize */
+    std::uint32_t oneDie; /**< squares that unlock one die */
+    std::array<SumCombos, MoveTable::MAX_SUM + 1> sumCombos; /**< moves per sum */
+    std::vector<std::uint8_t> squareSums; /**< per mask >> 1; empty above MAX_TABLED_BOARD_SIZE */
+};
+
+/**
+ * @brief Run code written against a spec with the best spec for a board size:
+ *        the compile-time BoardSpec for 9, 10 and 11 squares (the sizes a
+ *        tournament offers), a RuntimeBoardSpec otherwise. Callers dispatch
+ *        once per round or solve, so the work inside runs specialised.
+ * @param boardSize Squares on the board
+ * @param visitor Callable taking `const auto& spec`
+ * @return Whatever the visitor returns
+ */
+template <typename Visitor>
+decltype(auto) visitBoardSpec(const int boardSize, Visitor&& visitor) {
+    switch (boardSize) {
+        case 9:  return visitor(BoardSpec<9>{});
+        case 10: return visitor(BoardSpec<10>{});
+        case 11: return visitor(BoardSpec<11>{});
+        default: return visitor(RuntimeBoardSpec::forSize(boardSize));
+    }
+}
+
+#endif //BOARDSPEC_H
@@ -28,8 +28,9 @@ public:
      * @brief Constructs a Computer player.
      * @param b Reference to the computer's board
      * @param humanBoard Reference to the human's board
+     * @param context Advantage state of the game
      */
-    Computer(Board &b, Board &humanBoard);
+    Computer(Board &b, Board &humanBoard, GameContext &context);
 
     /**
      * @brief Performs the computer's turn.
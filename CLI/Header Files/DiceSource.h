@@ -0,0 +1,102 @@
+/**
+ * @file DiceSource.h
+ * @brief Declares DiceSource, the counter-based dice generator every game
+ *        draws its rolls from.
+ */
+
+#ifndef DICESOURCE_H
+#define DICESOURCE_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class DiceSource
+ * @brief Reproducible dice keyed by (seed, game id, turn).
+ *
+ * Rolls come from Philox4x32-10, a counter-based generator: each 128-bit
+ * counter (draw block, turn, game id) is encrypted under the 64-bit seed, and
+ * each output block yields four dice. Nothing is carried from one turn to the
+ * next, so the rolls of any turn of any game depend only on those three
+ * numbers — a game from a large parallel run replays bit-exactly on its own,
+ * whatever thread or order it originally ran in.
+ *
+ * Dice are drawn without modulo bias (Lemire's multiply-shift with
+ * rejection); a roll is a buffer read and a multiply, with one Philox block
+ * computed every fourth roll.
+ */
+class DiceSource {
+public:
+    /**
+     * @brief Positions the source at turn 0 of a game.
+     * @param seed Key shared by every game of a run
+     * @param gameId Index of the game within the run
+     */
+    explicit DiceSource(std::uint64_t seed = 0, std::uint64_t gameId = 0);
+
+    /**
+     * @brief A seed from std::random_device, for games that need not be reproduced.
+     * @return 64-bit seed
+     */
+    static std::uint64_t randomSeed();
+
+    /**
+     * @brief Philox4x32-10 block function.
+     * @param counter 128-bit counter as four little-endian words
+     * @param key 64-bit key as two words
+     * @return Four 32-bit random words
+     */
+    static std::array<std::uint32_t, 4> philox(std::array<std::uint32_t, 4> counter,
+                                               std::array<std::uint32_t, 2> key);
+
+    /**
+     * @brief Roll one six-sided die.
+     * @return Value in [1..6]
+     */
+    int rollDie() { return static_cast<int>(uniform(6)) + 1; }
+
+    /**
+     * @brief Uniform integer from the current turn's stream, e.g. to pick among n moves.
+     * @param bound Number of outcomes (at least 1)
+     * @return Value in [0, bound)
+     */
+    std::uint32_t uniform(const std::uint32_t bound) {
+        // The low word of value * bound is below 2^32 mod bound for exactly the
+        // values that would bias the result; skip those (for dice, p = 2^-30).
+        const std::uint32_t threshold = (0u - bound) % bound;
+        while (true) {
+            if (next == block.size()) refill();
+            const std::uint64_t scaled = std::uint64_t{block[next++]} * bound;
+            if (static_cast<std::uint32_t>(scaled) >= threshold) return static_cast<std::uint32_t>(scaled >> 32);
+        }
+    }
+
+    /** @brief Starts the next turn's stream. */
+    void nextTurn() { seek(turn + 1); }
+
+    /**
+     * @brief Jumps to the start of a turn of the current game.
+     * @param turnIndex Turn to position at (0 is before the first turn)
+     */
+    void seek(std::uint32_t turnIndex);
+
+    /** @return Seed the source is keyed with. */
+    std::uint64_t getSeed() const { return seed; }
+    /** @return Game the source is drawing for. */
+    std::uint64_t getGameId() const { return gameId; }
+    /** @return Current turn index. */
+    std::uint32_t getTurn() const { return turn; }
+
+private:
+    /** @brief Compute the next output block of the current turn. */
+    void refill();
+
+    std::uint64_t seed; /**< Philox key */
+    std::uint64_t gameId; /**< upper half of the counter */
+    std::uint32_t turn = 0; /**< counter word selecting the turn */
+    std::uint32_t blockIndex = 0; /**< counter word selecting the block within the turn */
+    std::array<std::uint32_t, 4> block{}; /**< current output block */
+    std::size_t next = 4; /**< next unused word of block; 4 when exhausted */
+};
+
+#endif //DICESOURCE_H
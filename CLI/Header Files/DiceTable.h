@@ -0,0 +1,70 @@
+/**
+ * @file DiceTable.h
+ * @brief Declares DiceTable, exact per-board odds for rolling one die or two,
+ *        precomputed for every covered mask so the dice choice is one lookup.
+ */
+
+#ifndef DICETABLE_H
+#define DICETABLE_H
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class DiceTable
+ * @brief Per-mask move chances and race lengths for one die versus two.
+ *
+ * For every board size up to MAX_BOARD_SIZE and every covered mask, the table
+ * holds the probability that a roll of one die, or of two, leaves a legal
+ * cover, and the expected number of turns still needed to cover the whole
+ * board when that many dice are rolled now and every later roll and cover is
+ * chosen to minimise the same expectation. A roll without a cover costs a
+ * turn and the mover starts again from the same mask, so with f the chance of
+ * such a roll and S the chance-weighted turns still needed after the best
+ * cover of each other roll, a dice count is worth (f + S) / (1 - f) turns.
+ * Covers only add squares, so one pass from the full board down fills the
+ * table exactly.
+ *
+ * This is the race half of the game: the opponent's uncovers (and the
+ * mover's own uncover options) are not part of the state, which is what keeps
+ * the table to 2^size entries and a few kilobytes. The solved PolicyTable,
+ * when present, remains the exact two-board answer.
+ */
+class DiceTable {
+public:
+    static constexpr int MAX_BOARD_SIZE = 12; /**< Largest board with a table (as for the Solver) */
+
+    /** @brief Odds for one covered mask; index 0 is one die, index 1 two dice. */
+    struct Entry {
+        std::array<float, 2> moveChance; /**< probability that the roll has a legal cover */
+        std::array<float, 2> expectedTurns; /**< turns to cover the board; infinite when the count is not allowed */
+        std::uint8_t diceCount; /**< dice count with the fewer expected turns (2 on ties) */
+
+        /** @return Expected turns to cover the board with the better dice count. */
+        float turns() const { return expectedTurns[diceCount - 1]; }
+    };
+
+    /**
+     * @brief Returns the process-wide table, building it on first use.
+     * @return Reference to the immutable table
+     */
+    static const DiceTable& instance();
+
+    /**
+     * @brief Looks a board up.
+     * @param boardSize Squares on the board
+     * @param coveredMask Covered squares (bit i == square i)
+     * @return The mask's entry, or nullptr when the size has no table
+     */
+    const Entry* find(const int boardSize, const std::uint32_t coveredMask) const {
+        if (boardSize < 1 || boardSize > MAX_BOARD_SIZE) return nullptr;
+        return &tables[boardSize][(coveredMask >> 1) & ((std::uint32_t{1} << boardSize) - 1)];
+    }
+
+private:
+    DiceTable();
+
+    std::array<std::vector<Entry>, MAX_BOARD_SIZE + 1> tables; /**< per size, indexed by mask >> 1 */
+};
+
+#endif //DICETABLE_H
@@ -0,0 +1,122 @@
+/**
+ * @file EngineSession.h
+ * @brief Declares EngineSession, one game driven through a line-oriented
+ *        engine protocol in the style of UCI, for external front-ends.
+ */
+
+#ifndef ENGINESESSION_H
+#define ENGINESESSION_H
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "Board.h"
+#include "DiceSource.h"
+#include "GameContext.h"
+#include "Strategy.h"
+
+class RolloutSearch;
+
+/**
+ * @class EngineSession
+ * @brief The state of one game between protocol commands: both boards, the
+ *        side to move, the protected advantage square, the pending roll, the
+ *        tournament scores and the handicap earned for the next round.
+ *
+ * A command is one line of space-separated tokens; squares are written as a
+ * comma-separated list such as `1,2,9`, or `-` for none, and sides as `human`
+ * or `computer`. Every command replies with one or more lines, the last of
+ * which is the one named below; a rejected command replies `error MESSAGE`
+ * and changes nothing.
+ *
+ *   canoga                   replies `id name canoga`, `protocol 1`, `canogaok`
+ *   isready                  replies `readyok`
+ *   newround SIZE FIRST      starts a round on empty boards with FIRST to move and
+ *                            the last round's handicap applied; replies the position
+ *   position SIZE HUMAN COMPUTER MOVER [first SIDE] [advantage SIDE SQUARE]
+ *                            sets up a round; the advantage square is protected and
+ *                            the first player defaults to the mover; replies the position
+ *   score HUMAN COMPUTER     sets the tournament scores; replies `ok`
+ *   show                     replies the position, then `score HUMAN COMPUTER`, then
+ *                            `roll SUM` while a roll waits for its move
+ *   dice                     replies `dice N`, the dice the engine would throw for the mover
+ *   roll [SUM]               records the mover's roll, or throws the engine's choice of
+ *                            dice; replies `roll SUM`, and then `pass SIDE` when the
+ *                            roll has no legal move and the turn passes to SIDE
+ *   bestmove                 replies `bestmove cover|uncover SQUARES` for the roll
+ *   analyse                  replies `info move cover|uncover SQUARES [value P]` for every
+ *                            legal move (P: the mover's win chance after it, from the
+ *                            solved table when one is mapped), then the bestmove line
+ *   applymove cover|uncover SQUARES
+ *                            plays the mover's move for the roll; replies `ok`, then
+ *                            `pass SIDE` when the opponent has nothing left covered, or
+ *                            `roundover SIDE cover|uncover POINTS` when the move wins
+ *   quit                     replies `bye` and ends the session
+ *
+ * Rounds follow the rules the simulator and solver use: the mover rolls again
+ * after every move, wins, points and the end of a turn come from
+ * Round::outcomeOfMove, and protection lasts until the advantage owner's
+ * opponent has played a turn. Moves come from the rollout search when one is
+ * given, else from the solved policy table for the board size when mapped,
+ * else from the heuristic strategy engine, as the Computer chooses them.
+ */
+class EngineSession {
+public:
+    /**
+     * @brief Creates a session with no round in progress.
+     * @param seed Seed of the dice the engine throws for `roll`
+     * @param gameId Dice stream of this session, so sessions sharing a seed throw different dice
+     * @param rollout Rollout search to choose moves with, or nullptr
+     */
+    explicit EngineSession(std::uint64_t seed = 0, std::uint64_t gameId = 0, const RolloutSearch* rollout = nullptr);
+
+    /**
+     * @brief Runs one command line.
+     * @param line Command, without its line ending
+     * @param reply Receives the reply lines, each ending in '\n' (appended)
+     * @return false once the session has ended (`quit`)
+     */
+    bool execute(std::string_view line, std::string& reply);
+
+private:
+    using Side = GameContext::Side;
+    using StrategyResult = strategy::StrategyResult;
+
+    /** @brief Board of a side. */
+    Board& boardOf(Side side) { return boards[side == Side::Human ? 0 : 1]; }
+    const Board& boardOf(Side side) const { return boards[side == Side::Human ? 0 : 1]; }
+    /** @return Opponent square the mover may not uncover, or 0. */
+    int protectedSquare() const { return advantageOwner != Side::None && advantageOwner != mover ? advantageSquare : 0; }
+
+    /** @brief Command handlers; each appends its reply or returns an error message. */
+    const char* newRound(const std::string_view* tokens, int count, std::string& reply);
+    const char* setPosition(const std::string_view* tokens, int count, std::string& reply);
+    const char* roll(const std::string_view* tokens, int count, std::string& reply);
+    const char* analyse(std::string& reply) const;
+    const char* applyMove(const std::string_view* tokens, int count, std::string& reply);
+
+    /** @brief Engine's move for the pending roll. */
+    StrategyResult chooseMove() const;
+    /** @brief Engine's dice count for the mover. */
+    int chooseDiceCount() const;
+    /** @brief Pass the turn to the other side, expiring protection once the owner's opponent has played. */
+    void endTurn(std::string& reply);
+    /** @brief Append `position ...`, in the form `position` accepts. */
+    void appendPosition(std::string& reply) const;
+    /** @brief Append `bestmove ...` for the pending roll. */
+    void appendBestMove(std::string& reply) const;
+
+    Board boards[2]; /**< [0] Human, [1] Computer */
+    bool inRound = false; /**< a round is set up and not yet won */
+    Side mover = Side::Human; /**< side to move */
+    Side firstPlayer = Side::Human; /**< side that started the round */
+    Side advantageOwner = Side::None; /**< owner of the protected advantage square, None when unprotected */
+    int advantageSquare = 0; /**< protected advantage square */
+    int pendingRoll = 0; /**< roll waiting for its move (0 for none) */
+    int scores[2] = {0, 0}; /**< tournament scores: [0] Human, [1] Computer */
+    Side pendingFor = Side::None; /**< side the last round's handicap goes to */
+    int pendingSquare = 0; /**< square of the last round's handicap */
+    DiceSource dice; /**< dice for `roll` without a sum */
+    const RolloutSearch* rollout; /**< rollout search, or nullptr */
+};
+
+#endif //ENGINESESSION_H
@@ -0,0 +1,148 @@
+/**
+ * @file GameContext.h
+ * @brief Declares GameContext, the per-game advantage/handicap state and dice
+ *        source shared by the Tournament, the Round and both players.
+ */
+
+#ifndef GAMECONTEXT_H
+#define GAMECONTEXT_H
+#include <cstdint>
+#include "DiceSource.h"
+#include "GameJournal.h"
+
+class MctsSearch;
+class RolloutSearch;
+
+/**
+ * @class GameContext
+ * @brief Advantage state and dice for a single game, owned by its Tournament.
+ *
+ * Every Tournament carries its own context and hands it to its players, so any
+ * number of games can run in one process (and on different threads) without
+ * sharing advantage squares, protection flags or dice. Every automatic roll in
+ * the game is drawn from the context's DiceSource.
+ */
+class GameContext {
+public:
+    /**
+     * @brief Represents which side holds/should receive advantages.
+     */
+    enum class Side { None, Human, Computer };
+
+    /**
+     * @brief The advantage in play this round, as saved and restored with a game.
+     */
+    struct AdvantageState {
+        bool applied = false; /**< an advantage square is active this round */
+        int square = 0; /**< advantage square index (kept after the advantage ends) */
+        Side owner = Side::None; /**< side owning the active advantage */
+        bool protectHuman = false; /**< human's advantage square is protected */
+        bool protectComputer = false; /**< computer's advantage square is protected */
+
+        bool operator==(const AdvantageState&) const = default;
+    };
+
+    /** @brief Returns whether an advantage has been applied this round. */
+    bool getAdvantageApplied() const;
+    /** @brief Returns the currently configured advantage square index. */
+    int getAdvantageSquare() const;
+    /** @brief Returns which side currently owns the advantage. */
+    Side getAdvantageOwner() const;
+    /** @brief Returns true while the human's advantage square may not be uncovered. */
+    bool isHumanAdvantageProtected() const;
+    /** @brief Returns true while the computer's advantage square may not be uncovered. */
+    bool isComputerAdvantageProtected() const;
+
+    /**
+     * @brief Set the advantage square without applying it (used when queuing a handicap).
+     * @param square Advantage square index
+     */
+    void setAdvantageSquare(int square);
+
+    /**
+     * @brief Apply an advantage for the new round and protect it for one opponent turn.
+     * @param owner Side that receives the advantage
+     * @param square Advantage square index
+     */
+    void applyAdvantage(Side owner, int square);
+
+    /** @return Every advantage field, for saving the game. */
+    AdvantageState getAdvantageState() const;
+
+    /**
+     * @brief Put every advantage field back as saved.
+     * @param state Fields from getAdvantageState()
+     */
+    void restoreAdvantageState(const AdvantageState& state);
+
+    /** @brief Clear any applied advantage and its protection flags. */
+    void clearAdvantage();
+
+    /** @brief Clear protection for the human advantage and potentially reset advantage state. */
+    void clearAdvantageProtectionForHuman();
+    /** @brief Clear protection for the computer advantage and potentially reset advantage state. */
+    void clearAdvantageProtectionForComputer();
+
+    /** @return The dice source every automatic roll of this game is drawn from. */
+    DiceSource& getDice() { return dice; }
+    /** @return The game's dice source, read-only. */
+    const DiceSource& getDice() const { return dice; }
+
+    /**
+     * @brief Replace the dice source, e.g. to replay a game from a known seed.
+     * @param source Source positioned where the game should continue
+     */
+    void setDice(const DiceSource& source) { dice = source; }
+
+    /** @return The Monte Carlo search the Computer plays with, or nullptr for its usual strategy. */
+    const RolloutSearch* getRolloutSearch() const { return rolloutSearch; }
+
+    /**
+     * @brief Make the Computer choose its moves with a rollout search.
+     * @param search Search to use (owned by the caller), or nullptr for the usual strategy
+     */
+    void setRolloutSearch(const RolloutSearch* search) { rolloutSearch = search; }
+
+    /** @return The tree search the Computer's seat is played by, or nullptr for the Computer player. */
+    MctsSearch* getMctsSearch() const { return mctsSearch; }
+
+    /**
+     * @brief Have an MctsPlayer take the Computer's seat.
+     * @param search Search to play with (owned by the caller), or nullptr for the Computer player
+     */
+    void setMctsSearch(MctsSearch* search) { mctsSearch = search; }
+
+    /** @return The journal this game's events are appended to, or nullptr. */
+    GameJournal* getJournal() const { return journal; }
+
+    /**
+     * @brief Journal this game's events under a new game id, starting with GameStart.
+     * @param target Journal to append to (owned by the caller), or nullptr to stop journaling
+     */
+    void setJournal(GameJournal* target);
+
+    /**
+     * @brief Append an event of this game to its journal; does nothing without one.
+     * @param type Kind of event
+     * @param side Side the event concerns
+     * @param value Small operand (board size, dice count, sum or square)
+     * @param mask Squares or points
+     * @param flags JOURNAL_* bits
+     */
+    void record(JournalEvent type, Side side = Side::None, int value = 0, std::uint32_t mask = 0,
+                std::uint8_t flags = 0) const;
+
+private:
+    bool advantageApplied = false; /**< An advantage square is active this round */
+    int advantageSquare = 0; /**< Advantage square index */
+    bool protectHumanAdvantage = false; /**< Human's advantage square is protected */
+    bool protectComputerAdvantage = false; /**< Computer's advantage square is protected */
+    Side advantageOwner = Side::None; /**< Side owning the active advantage */
+    DiceSource dice{DiceSource::randomSeed()}; /**< Dice for this game; randomly seeded unless replaced */
+    const RolloutSearch* rolloutSearch = nullptr; /**< Computer's move search; null for table/heuristic play */
+    MctsSearch* mctsSearch = nullptr; /**< Search of the MctsPlayer seat; null for the Computer player */
+    GameJournal* journal = nullptr; /**< Journal of this game's events; null when not journaled */
+    std::uint64_t journalGameId = 0; /**< This game's id in the journal */
+};
+
+#endif //GAMECONTEXT_H
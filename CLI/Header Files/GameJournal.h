@@ -0,0 +1,163 @@
+/**
+ * @file GameJournal.h
+ * @brief Declares the on-disk layout of a game journal, the append-only record
+ *        of every event of every journaled game, and GameJournal, its buffered
+ *        writer.
+ */
+
+#ifndef GAMEJOURNAL_H
+#define GAMEJOURNAL_H
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Kinds of journal events.
+ *
+ * A round is journaled as RoundStart, the starting Position and Score of both
+ * sides, Advantage when one is in play, and FirstPlayer; then, per roll of
+ * every turn, DiceCount and Roll followed by Move unless the roll had no legal
+ * move; then RoundEnd. A turn is the run of rolls by one side, so protection
+ * of an advantage square, which lasts until the owner's opponent has played,
+ * follows from the events alone.
+ */
+enum class JournalEvent : std::uint8_t {
+    GameStart = 1, /**< a game started journaling */
+    RoundStart, /**< value: board size; flags: JOURNAL_RESUMED for a loaded game */
+    Position, /**< side's covered squares as the round starts; mask: covered mask */
+    Score, /**< side's tournament score as the round starts; mask: score */
+    Advantage, /**< side: owner; value: square; flags: JOURNAL_PROTECTED while protected */
+    FirstPlayer, /**< side: the side that started the round */
+    DiceCount, /**< side: roller; value: 1 or 2 */
+    Roll, /**< side: roller; value: dice sum; flags: JOURNAL_MANUAL for dice entered by hand */
+    Move, /**< side: mover; flags: JOURNAL_COVER or 0 for an uncover; mask: combination */
+    RoundEnd, /**< side: winner; flags: JOURNAL_BY_COVER; mask: points won */
+};
+
+constexpr std::uint8_t JOURNAL_RESUMED = 1u << 0; /**< RoundStart: the round continues a saved game */
+constexpr std::uint8_t JOURNAL_PROTECTED = 1u << 0; /**< Advantage: the square may not be uncovered yet */
+constexpr std::uint8_t JOURNAL_MANUAL = 1u << 0; /**< Roll: the dice were entered by hand */
+constexpr std::uint8_t JOURNAL_COVER = 1u << 0; /**< Move: a cover (an uncover otherwise) */
+constexpr std::uint8_t JOURNAL_BY_COVER = 1u << 0; /**< RoundEnd: won by covering (by uncovering otherwise) */
+
+/**
+ * @brief One journal event. All fields are little-endian; records are written
+ *        as they are laid out in memory, so only little-endian builds are allowed.
+ */
+struct JournalRecord {
+    std::uint64_t game; /**< id of the game the event belongs to */
+    std::uint32_t mask; /**< squares or points, by event */
+    JournalEvent type; /**< kind of event */
+    std::uint8_t side; /**< GameContext::Side the event concerns */
+    std::uint8_t value; /**< small operand, by event */
+    std::uint8_t flags; /**< JOURNAL_* bits, by event */
+};
+
+/**
+ * @brief Fixed-size header at the start of a journal file; records follow it back to back.
+ */
+struct JournalHeader {
+    char magic[8]; /**< GameJournal::MAGIC */
+    std::uint32_t version; /**< GameJournal::VERSION */
+    std::uint32_t recordSize; /**< sizeof(JournalRecord) */
+};
+
+/**
+ * @class GameJournal
+ * @brief Appends JournalRecords to a journal file in batches.
+ *
+ * Events are copied into an in-memory batch under a short lock; a full batch
+ * is written with a single append. With a background writer, full batches are
+ * queued to a writer thread instead, which also writes a partial batch every
+ * flush interval, so the game loop never waits on the disk. Batches reach the
+ * file in the order they were filled, so each game's events stay in order
+ * when many games share a journal; records of different games interleave and
+ * are told apart by their game id.
+ */
+class GameJournal {
+public:
+    static constexpr char MAGIC[8] = {'C', 'A', 'N', 'O', 'G', 'A', 'J', 'L'}; /**< File signature */
+    static constexpr std::uint32_t VERSION = 1; /**< Current format version */
+
+    /** @brief Writer settings. */
+    struct Options {
+        std::size_t batchRecords = 4096; /**< records per write */
+        bool background = false; /**< write on a background thread */
+        int flushIntervalMs = 200; /**< background writer: longest time a record waits in memory */
+    };
+
+    GameJournal() = default;
+    /** @brief Flushes and closes the journal. */
+    ~GameJournal();
+    GameJournal(const GameJournal&) = delete;
+    GameJournal& operator=(const GameJournal&) = delete;
+
+    /**
+     * @brief Opens a journal for appending, creating it with a header when new.
+     *        A record cut short by a crash is dropped so appends stay aligned.
+     * @param filename Path of the journal
+     * @param options Writer settings
+     * @return true on success; prints the reason and returns false otherwise
+     */
+    bool open(const std::string& filename, const Options& options);
+
+    /** @brief Writes everything still buffered, stops the writer and closes the file. */
+    void close();
+
+    /** @return true when a journal is open. */
+    bool isOpen() const { return fd >= 0; }
+
+    /**
+     * @brief Allocates the id of a new game. Ids are unique within the journal
+     *        across processes appending to it (random 32-bit session prefix).
+     * @return The id
+     */
+    std::uint64_t newGameId() { return nextGameId.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Buffers one event; may write a full batch unless writing in the background.
+     * @param record Event to append
+     */
+    void append(const JournalRecord& record);
+
+    /** @brief Writes every event appended so far and waits until it is in the file. */
+    void flush();
+
+private:
+    using Batch = std::vector<JournalRecord>;
+
+    /** @brief Append a batch to the file; on failure, report it and stop journaling. */
+    void write(const Batch& batch);
+    /** @brief Write the batch being filled in the caller's thread; `guard` holds lock and is released meanwhile. */
+    void writeFilled(std::unique_lock<std::mutex>& guard);
+    /** @brief Queue the batch being filled for the writer thread; requires lock. */
+    void queueFilled();
+    /** @brief An empty batch with room for a full one; requires lock. */
+    Batch takeSpare();
+    /** @brief Background writer thread. */
+    void writerLoop();
+
+    int fd = -1; /**< journal file, opened for appending */
+    Options options; /**< settings from open() */
+    std::atomic<std::uint64_t> nextGameId{0}; /**< next id newGameId() hands out */
+
+    std::mutex lock; /**< guards the batches and writer state below */
+    std::mutex fileLock; /**< orders writes from foreground flushes */
+    Batch filling; /**< batch events are appended to */
+    std::deque<Batch> queued; /**< full batches waiting for the writer thread */
+    std::vector<Batch> spare; /**< written batches kept for reuse */
+    std::condition_variable wake; /**< wakes the writer thread */
+    std::condition_variable drained; /**< signalled when the writer has emptied the queue */
+    bool writing = false; /**< the writer thread holds a batch */
+    bool stopping = false; /**< set by close() */
+    std::atomic<bool> failed{false}; /**< a write failed; later events are dropped */
+    std::thread writer; /**< background writer, when enabled */
+};
+
+#endif //GAMEJOURNAL_H
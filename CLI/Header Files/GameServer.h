@@ -0,0 +1,122 @@
+/**
+ * @file GameServer.h
+ * @brief Declares GameServer, which serves many independent EngineSessions
+ *        over a Unix domain socket or localhost TCP from one epoll loop.
+ */
+
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "EngineSession.h"
+
+/**
+ * @class GameServer
+ * @brief Non-blocking server for the engine protocol: every connection is its
+ *        own game session with its own boards, scores and advantage state.
+ *
+ * One thread waits on an epoll set holding the listening socket and every
+ * connection. Readable connections have their complete lines run through
+ * their EngineSession and the replies written straight back; a reply the
+ * socket cannot take yet is kept and written when it becomes writable, so a
+ * slow client never holds up the others. Nothing blocks but epoll_wait, so a
+ * command's latency is its own run time plus that of the commands ready
+ * before it, whatever the number of idle sessions. For the same reason
+ * sessions choose their moves greedily: a search would stall every other
+ * connection for as long as it ran.
+ *
+ * A connection runs at most MAX_LINES_PER_TURN lines before every other ready
+ * connection has had its turn, so a client pipelining a burst of commands
+ * delays the others by one turn at most. Once a connection's unwritten replies
+ * pass MAX_PENDING_OUTPUT it is not read again until the client has taken
+ * them, which bounds the memory a client that never reads can hold.
+ */
+class GameServer {
+public:
+    /** @brief Server settings. */
+    struct Options {
+        std::uint64_t seed = 0; /**< dice seed; each session draws from its own stream of it */
+        std::size_t maxLine = 4096; /**< longest command line; a longer one closes the connection */
+        std::size_t sessionTarget = 10000; /**< sessions to have room for; a lower open-file limit is reported */
+    };
+
+    static constexpr int MAX_LINES_PER_TURN = 32; /**< lines one connection runs before the others are served */
+    static constexpr std::size_t MAX_PENDING_OUTPUT = 65536; /**< unwritten reply bytes at which reading stops */
+
+    GameServer() = default;
+    /** @brief Closes every connection and the listening socket. */
+    ~GameServer();
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    /**
+     * @brief Starts listening.
+     * @param address A port number for TCP on 127.0.0.1, otherwise the path of a
+     *        Unix domain socket (a stale socket at that path is replaced)
+     * @param options Server settings
+     * @return true on success; prints the reason and returns false otherwise
+     */
+    bool listen(const std::string& address, const Options& options);
+
+    /**
+     * @brief Serves connections until stop() is called.
+     * @return false when the event loop fails (the reason is printed)
+     */
+    bool run();
+
+    /** @brief Makes run() return; safe to call from another thread or a signal handler. */
+    void stop();
+
+    /** @return Number of open sessions. */
+    std::size_t sessionCount() const { return sessions; }
+
+private:
+    /** @brief One client connection and its game. */
+    struct Connection {
+        Connection(int fd, std::uint64_t seed, std::uint64_t sessionId) : fd(fd), session(seed, sessionId) {}
+
+        int fd; /**< socket */
+        EngineSession session; /**< the client's game */
+        std::string input; /**< bytes read but not yet a complete line */
+        std::string output; /**< replies not yet written */
+        std::size_t written = 0; /**< bytes of `output` already written */
+        bool ended = false; /**< the client has finished sending; close once its lines are answered */
+        bool closing = false; /**< the session is over: close once `output` is written, running nothing more */
+        bool backlog = false; /**< `input` holds complete lines left for a later turn */
+        bool queued = false; /**< on the list of connections with a backlog to run */
+        std::uint32_t watched = 0; /**< epoll events currently requested */
+    };
+
+    /** @brief Accept every pending connection. */
+    void acceptAll();
+    /** @brief Stop or resume watching the listener, while no descriptor is free for a new session. */
+    void setAccepting(bool accept);
+    /** @brief Read what is available; false when the connection must close now. */
+    bool receive(Connection& connection);
+    /** @brief Run the complete lines a turn allows. */
+    void runLines(Connection& connection);
+    /** @brief Write pending replies and choose what to wait for next; false when the connection must close now. */
+    bool flush(Connection& connection);
+    /** @brief Give every connection with a backlog its next turn. */
+    void runBacklog();
+    /** @brief Close a connection and free its session. */
+    void close(Connection& connection);
+
+    int listener = -1; /**< listening socket */
+    int poller = -1; /**< epoll instance */
+    int wakeup = -1; /**< eventfd that stop() signals */
+    std::string unixPath; /**< path to remove on shutdown, for a Unix socket */
+    Options options; /**< settings from listen() */
+    std::vector<std::unique_ptr<Connection>> connections; /**< open connections, indexed by socket */
+    std::vector<int> backlogged; /**< sockets of connections queued with a backlog (closed ones are skipped) */
+    std::vector<int> backlogTurn; /**< the queue being run by runBacklog(), kept to reuse its storage */
+    std::size_t sessions = 0; /**< open connections */
+    std::uint64_t nextSessionId = 0; /**< dice stream of the next session */
+    bool accepting = true; /**< the listener is watched */
+    bool limitReported = false; /**< running out of descriptors has been reported */
+};
+
+#endif //GAMESERVER_H
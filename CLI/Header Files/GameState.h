@@ -0,0 +1,140 @@
+/**
+ * @file GameState.h
+ * @brief Declares GameState, both boards of a round plus the side to move, with
+ *        make/unmake moves and an incremental Zobrist hash so lookahead searches
+ *        can walk a tree in place and recognise transpositions.
+ */
+
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+#include "Board.h"
+#include "Strategy.h"
+#include "Zobrist.h"
+
+/**
+ * @struct GameState
+ * @brief A round's position as a search sees it.
+ *
+ * Seats are numbered as in the Simulator: seat 0 is the Round's player1 (the
+ * human slot) and seat 1 is player2. makeMove() and passTurn() return a small
+ * Undo token that unmake() uses to restore the exact previous position, so a
+ * search (expectimax, MCTS, hint analysis) can explore from a single GameState
+ * without copying boards or touching the heap. Tokens must be unmade in
+ * reverse order.
+ *
+ * hash is the position's Zobrist key (see zobrist::hashOf), kept up to date
+ * by every make, pass and unmake, so positions reached by different move
+ * orders can be looked up in a TranspositionTable without rehashing. Code
+ * that edits boards directly must call rehash().
+ */
+struct GameState {
+    /** @brief Token restoring the position before a makeMove() or passTurn(). */
+    struct Undo {
+        Board::Undo board; /**< state of the board the move changed */
+        int boardSeat; /**< seat whose board the move changed */
+        int mover; /**< side to move before */
+        int protectedSquare; /**< protection before */
+        std::uint64_t hash; /**< hash before */
+    };
+
+    Board boards[2]; /**< seat 0 and seat 1 boards */
+    int mover = 0; /**< seat whose turn it is */
+    int protectedSquare = 0; /**< square of the mover's opponent that may not be uncovered (0 for none) */
+    std::uint64_t hash = 0; /**< Zobrist key of the position */
+
+    GameState() { rehash(); }
+
+    /**
+     * @brief A fresh round: both boards empty.
+     * @param boardSize Squares per board
+     * @param firstMover Seat that moves first
+     */
+    explicit GameState(const int boardSize, const int firstMover = 0)
+        : boards{Board(boardSize), Board(boardSize)}, mover(firstMover) { rehash(); }
+
+    /**
+     * @brief A position copied from live boards.
+     * @param seat0 Seat 0's board
+     * @param seat1 Seat 1's board
+     * @param mover Seat to move
+     * @param protectedSquare Opponent square the mover may not uncover (0 for none)
+     */
+    GameState(const Board& seat0, const Board& seat1, const int mover, const int protectedSquare = 0)
+        : boards{seat0, seat1}, mover(mover), protectedSquare(protectedSquare) { rehash(); }
+
+    /** @brief Recompute hash from scratch, after the boards or turn were changed directly. */
+    void rehash() {
+        hash = zobrist::hashOf(boards[0].getSize(), boards[0].getCoveredMask(), boards[1].getCoveredMask(),
+                               mover, protectedSquare);
+    }
+
+    /** @return Board of the side to move. */
+    Board& own() { return boards[mover]; }
+    /** @return Board of the side to move. */
+    const Board& own() const { return boards[mover]; }
+    /** @return Board of the side waiting. */
+    Board& opponent() { return boards[1 - mover]; }
+    /** @return Board of the side waiting. */
+    const Board& opponent() const { return boards[1 - mover]; }
+
+    /** @return Mask of the opponent squares the mover may not uncover. */
+    std::uint32_t guardedMask() const { return protectedSquare > 0 ? Board::bitOf(protectedSquare) : 0; }
+
+    /**
+     * @brief Whether the mover has any cover or uncover for a roll.
+     * @param sum Dice sum
+     * @return false when the roll passes the turn
+     */
+    bool hasLegalMove(const int sum) const {
+        return own().hasValidMove(sum, true) || opponent().hasValidMove(sum, false, guardedMask());
+    }
+
+    /**
+     * @brief Whether a move ends the round in the mover's favour.
+     * @param move Cover or uncover for the mover
+     * @return true when it covers the mover's last square or uncovers the opponent's last one
+     */
+    bool isWinningMove(const strategy::StrategyResult& move) const {
+        return strategy::isComboWinning(move, own(), opponent());
+    }
+
+    /**
+     * @brief Apply a cover (to the mover's board) or uncover (to the opponent's);
+     *        the mover keeps the turn.
+     * @param move Move to make; Action::None changes nothing
+     * @return Token for unmake()
+     */
+    Undo makeMove(const strategy::StrategyResult& move) {
+        const bool covering = move.action == strategy::StrategyResult::Action::Cover;
+        const int seat = covering ? mover : 1 - mover;
+        const std::uint32_t combo = move.action == strategy::StrategyResult::Action::None ? 0 : move.combo;
+        const Undo undo{boards[seat].applyMove(combo, covering), seat, mover, protectedSquare, hash};
+        hash ^= zobrist::squaresKey(seat, undo.board.coveredMask ^ boards[seat].getCoveredMask());
+        return undo;
+    }
+
+    /**
+     * @brief End the mover's turn. Advantage protection lasts one opponent turn, so it ends here.
+     * @return Token for unmake()
+     */
+    Undo passTurn() {
+        const Undo undo{{boards[0].getCoveredMask(), boards[0].getCoveredSum()}, 0, mover, protectedSquare, hash};
+        hash ^= zobrist::turnKey(mover, protectedSquare) ^ zobrist::turnKey(1 - mover, 0);
+        mover = 1 - mover;
+        protectedSquare = 0;
+        return undo;
+    }
+
+    /**
+     * @brief Restore the position before the matching makeMove() or passTurn().
+     * @param undo Token to take back
+     */
+    void unmake(const Undo& undo) {
+        boards[undo.boardSeat].undoMove(undo.board);
+        mover = undo.mover;
+        protectedSquare = undo.protectedSquare;
+        hash = undo.hash;
+    }
+};
+
+#endif //GAMESTATE_H
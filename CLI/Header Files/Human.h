@@ -31,8 +31,9 @@ public:
      * 
      * @param b Reference to the human player's board.
      * @param computerBoard Reference to the computer's board.
+     * @param context Advantage state of the game.
      */
-    Human(Board &b, Board &computerBoard);
+    Human(Board &b, Board &computerBoard, GameContext &context);
 
     /**
      * @brief Takes a turn for the human player.
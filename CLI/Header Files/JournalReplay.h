@@ -0,0 +1,120 @@
+/**
+ * @file JournalReplay.h
+ * @brief Declares JournalReplay, which re-plays game journals on Boards
+ *        without any UI and checks every recorded event against the rules.
+ */
+
+#ifndef JOURNALREPLAY_H
+#define JOURNALREPLAY_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "Board.h"
+#include "GameContext.h"
+#include "GameJournal.h"
+
+/**
+ * @brief Totals of a replay.
+ */
+struct ReplayStats {
+    std::uint64_t events = 0; /**< records read */
+    std::uint64_t games = 0; /**< GameStart records */
+    std::uint64_t rounds = 0; /**< rounds replayed to their RoundEnd */
+    std::uint64_t rolls = 0; /**< Roll records */
+    std::uint64_t moves = 0; /**< Move records applied */
+    std::uint64_t errors = 0; /**< events that broke a rule or contradicted the replay */
+    std::uint64_t bytes = 0; /**< journal bytes read */
+};
+
+/**
+ * @class JournalReplay
+ * @brief Re-applies journaled games and checks them.
+ *
+ * Every game's boards are rebuilt from its RoundStart and Position records and
+ * every Move is checked with Board::isValidCombination and against the roll,
+ * the dice-count rules and the advantage protection, then applied. A roll
+ * followed by no move must have had no uncover sparing a protected square and,
+ * unless the same side rolls again (a Human who chose to uncover and found
+ * every option protected), no cover either. RoundEnd is re-scored with
+ * Round::outcomeOf, the rules Round::declareWinner scores with, and the next
+ * round's scores and advantage square are checked against the running totals
+ * and Tournament's handicap rule. After an error, a game's events are skipped
+ * until its next RoundStart.
+ *
+ * Records of many games may interleave; each game's state is kept by game id.
+ */
+class JournalReplay {
+public:
+    /**
+     * @brief Creates a replay.
+     * @param maxReported Errors described on stderr before the rest are only counted
+     */
+    explicit JournalReplay(std::uint64_t maxReported = 20);
+
+    /**
+     * @brief Memory-maps a journal and replays every record in it.
+     * @param filename Path of the journal
+     * @param stats Totals to update
+     * @return false when the file cannot be read as a journal (the reason is printed)
+     */
+    bool replayFile(const std::string& filename, ReplayStats& stats);
+
+    /**
+     * @brief Replays records; may be called repeatedly on consecutive parts of a journal.
+     * @param records First record
+     * @param count Number of records
+     * @param stats Totals to update
+     */
+    void replay(const JournalRecord* records, std::size_t count, ReplayStats& stats);
+
+private:
+    using Side = GameContext::Side;
+
+    /** @brief Next events a game's replay accepts. */
+    enum class Phase : std::uint8_t {
+        Idle, /**< between rounds: RoundStart */
+        Setup, /**< after RoundStart: Position, Score, Advantage, FirstPlayer */
+        Turn, /**< DiceCount or RoundEnd */
+        Roll, /**< after DiceCount: Roll */
+        Move /**< after Roll: Move, or DiceCount or RoundEnd when the roll had no move */
+    };
+
+    /** @brief Replay state of one game. */
+    struct ReplayedGame {
+        Board boards[2]; /**< [0] Human, [1] Computer */
+        int scores[2] = {0, 0}; /**< tournament scores after the last round replayed */
+        Phase phase = Phase::Idle; /**< events accepted next */
+        bool started = false; /**< GameStart was seen */
+        bool broken = false; /**< an error was found; events are skipped until the next RoundStart */
+        bool resumed = false; /**< the round continues a saved game */
+        bool previousEnded = false; /**< the last round was replayed to its RoundEnd, so this round's start is known */
+        std::uint8_t setupSeen = 0; /**< Position and Score records seen since RoundStart, one bit each */
+        Side firstPlayer = Side::None; /**< side that started the round */
+        Side mover = Side::None; /**< side whose turn is being replayed */
+        std::uint8_t diceCount = 0; /**< dice of the current roll */
+        std::uint8_t sum = 0; /**< current roll */
+        Side advantageOwner = Side::None; /**< owner of the advantage in play */
+        int advantageSquare = 0; /**< advantage square in play */
+        bool advantageProtected = false; /**< the square may not be uncovered yet */
+        Side pendingFor = Side::None; /**< side the last round's handicap goes to */
+        int pendingSquare = 0; /**< square of the last round's handicap */
+    };
+
+    /** @brief Apply one record to its game. */
+    void apply(const JournalRecord& record, ReplayStats& stats);
+    /** @brief Check a new round's boards, scores and advantage against the last round's result. */
+    static const char* checkRoundStart(const ReplayedGame& game);
+    /** @brief Check a roll no move followed; `continuing` when the same side rolls again. */
+    static const char* checkNoMove(const ReplayedGame& game, bool continuing);
+    /** @brief Count and describe an error; the game is skipped until its next RoundStart. */
+    void fail(ReplayedGame& game, const JournalRecord& record, const char* what, ReplayStats& stats);
+
+    std::unordered_map<std::uint64_t, ReplayedGame> games; /**< state per game id */
+    std::uint64_t lastId = 0; /**< id of `last` */
+    ReplayedGame* last = nullptr; /**< most recently used game, to skip the lookup for runs of one game */
+    std::uint64_t position = 0; /**< index of the record being replayed, across replay() calls */
+    std::uint64_t maxReported; /**< errors described before the rest are only counted */
+};
+
+#endif //JOURNALREPLAY_H
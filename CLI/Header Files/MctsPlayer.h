@@ -0,0 +1,48 @@
+/**
+ * @file MctsPlayer.h
+ * @brief Declaration of MctsPlayer, a computer player that decides its dice
+ *        and moves with Monte Carlo Tree Search.
+ */
+
+#ifndef MCTSPLAYER_H
+#define MCTSPLAYER_H
+#include "BoardView.h"
+#include "Player.h"
+
+class MctsSearch;
+
+/**
+ * @class MctsPlayer
+ * @brief Computer player backed by an MctsSearch.
+ *
+ * Plays the Computer's seat like Computer does (rolling from the game's dice
+ * and rolling again until a roll has no legal move or the round is won), but
+ * both the number of dice and the move are chosen by the search. The search
+ * keeps its tree between decisions, so each one starts from the statistics
+ * gathered for the position on earlier turns.
+ */
+class MctsPlayer final : public Player {
+private:
+    BoardView boardView; /**< View of the player's own board */
+    BoardView humanBoardView; /**< View of the human's board */
+    Board& humanBoard; /**< Reference to the human's board */
+    MctsSearch& search; /**< Search deciding dice and moves */
+
+public:
+    /**
+     * @brief Constructs an MCTS player.
+     * @param b Reference to the player's board
+     * @param humanBoard Reference to the human's board
+     * @param context Advantage state and dice of the game
+     * @param search Search to play with (owned by the caller)
+     */
+    MctsPlayer(Board &b, Board &humanBoard, GameContext &context, MctsSearch &search);
+
+    /**
+     * @brief Performs the player's turn.
+     * @return true when the turn ends
+     */
+    bool takeTurn() override;
+};
+
+#endif //MCTSPLAYER_H
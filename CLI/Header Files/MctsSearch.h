@@ -0,0 +1,166 @@
+/**
+ * @file MctsSearch.h
+ * @brief Declares MctsSearch, a Monte Carlo Tree Search over dice choices,
+ *        dice outcomes and moves, with its nodes kept in reusable arenas and
+ *        its iterations optionally spread over a worker pool.
+ */
+
+#ifndef MCTSSEARCH_H
+#define MCTSSEARCH_H
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "GameState.h"
+#include "Strategy.h"
+
+class TranspositionTable;
+class WorkStealingPool;
+
+/**
+ * @brief Settings for an MctsSearch.
+ */
+struct MctsConfig {
+    /** @brief How a decision's iterations are shared between the pool's workers. */
+    enum class Parallelism {
+        Root, /**< each worker grows its own tree; root statistics are summed at the end */
+        Tree  /**< all workers grow one shared tree, steered apart by virtual loss */
+    };
+
+    int budgetMs = 100; /**< Wall-clock time per decision; 0 for no limit (maxIterations must be set) */
+    std::uint64_t maxIterations = 0; /**< Iterations per decision over all workers; 0 for no limit (budgetMs must be set) */
+    /** @brief Arena capacity, split between the trees under root parallelism; once full, leaves are evaluated without expanding */
+    std::size_t maxNodes = std::size_t{1} << 20;
+    double exploration = 0.7; /**< UCT exploration constant */
+    bool greedyPlayouts = true; /**< Leaf playouts follow computeBestMove; false picks uniformly among legal moves */
+    bool reuseTree = true; /**< Keep the subtree of the new position between decisions */
+    Parallelism parallelism = Parallelism::Tree; /**< Multi-worker scheme (ignored without a pool) */
+    int virtualLoss = 3; /**< Lost visits a shared-tree worker adds along its path until its result is in */
+    std::uint64_t seed = 1; /**< DiceSource key for chance sampling and playouts */
+    TranspositionTable* table = nullptr; /**< Position values shared with other searches, or nullptr */
+};
+
+/**
+ * @brief Outcome of one decision.
+ */
+struct MctsResult {
+    strategy::StrategyResult move{strategy::StrategyResult::Action::None, 0}; /**< chosen move (bestMove) */
+    int diceCount = 2; /**< chosen number of dice (chooseDiceCount) */
+    double winRate = 0.0; /**< mean result of the chosen child (1 for an immediate win) */
+    std::uint64_t iterations = 0; /**< iterations run for this decision, over all workers */
+    std::uint64_t expansions = 0; /**< nodes created for this decision */
+    std::uint64_t reusedVisits = 0; /**< root visits carried over from earlier decisions */
+    std::size_t treeSize = 0; /**< nodes in the arenas after the search */
+};
+
+/**
+ * @class MctsSearch
+ * @brief UCT search over a round with explicit chance nodes.
+ *
+ * The tree alternates four kinds of node. At a Roll node the mover picks how
+ * many dice to throw: a Chance child for two dice, plus one for a single die
+ * when Board::canThrowOneDie() allows it. A Chance node has one Sum child per
+ * outcome (1..6 or 2..12) and is walked by rolling the dice, so outcomes are
+ * visited with their true probabilities. At a Sum node the mover picks a cover
+ * or uncover; each child is the resulting Roll node (the opponent's, when the
+ * move or a pass ends the turn) or a Terminal node when the move wins. New
+ * leaves are valued with a greedy playout to the end of the round.
+ *
+ * Nodes live in one preallocated arena per tree, each node's children in one
+ * block, and nothing is allocated per node: the arena is cleared between
+ * moves. When reuseTree is set, the subtree of the position being searched is
+ * kept instead: it is looked up below the root child the last decision chose,
+ * following only the moves the opponent could have made since, and a
+ * breadth-first copy moves it into a second arena, which then becomes the live
+ * one. This follows the game from one decision to the next, including across
+ * the opponent's turn.
+ *
+ * With a pool, a decision's iterations run on all its workers. Root
+ * parallelism gives each worker a private tree with an equal share of
+ * maxNodes, runs each tree as one work item over a fixed share of the
+ * iterations, and sums the root children's statistics, so workers never touch
+ * shared nodes but each explores the same top of the tree. Tree parallelism
+ * shares one tree: visit and result counters are updated atomically, children
+ * are allocated from the arena with an atomic bump, a node is expanded by
+ * whichever worker claims it first, and every node on a worker's path counts
+ * virtualLoss extra lost visits until its playout returns, so concurrent
+ * workers spread over different lines.
+ *
+ * With a TranspositionTable, a new Roll node starts from the stored value of
+ * its position (worth at most a few dozen visits), and a Roll node's
+ * statistics are stored back every few visits as results pass through it, so
+ * positions reached by other move orders, other turns or other searches start
+ * informed.
+ *
+ * A search is stateful (its trees) and serves one player; calls must not overlap.
+ */
+class MctsSearch {
+public:
+    /**
+     * @brief Constructs a search and reserves its arenas.
+     * @param config Budget, arena size, parallelism and seed (with neither a budget nor a cap, the default budget applies)
+     * @param pool Workers to run iterations on, or nullptr to run on the calling thread
+     */
+    explicit MctsSearch(const MctsConfig& config, WorkStealingPool* pool = nullptr);
+    ~MctsSearch();
+
+    MctsSearch(const MctsSearch&) = delete;
+    MctsSearch& operator=(const MctsSearch&) = delete;
+
+    /**
+     * @brief Choose how many dice the mover throws.
+     * @param state Position, with the mover about to roll and its protection
+     * @return diceCount and statistics (2 without a search when one die is not allowed)
+     */
+    MctsResult chooseDiceCount(const GameState& state);
+
+    /**
+     * @brief Choose the mover's move for a rolled sum.
+     * @param state Position, with the mover to play and its protection
+     * @param sum Dice sum rolled
+     * @return Chosen move and statistics (Action::None when no legal move exists)
+     */
+    MctsResult bestMove(const GameState& state, int sum);
+
+    /** @brief Drop the trees, e.g. at the start of a new round. */
+    void clear();
+
+    /** @return Nodes currently in the arenas. */
+    std::size_t treeSize() const;
+
+    /** @return The settings this search uses. */
+    const MctsConfig& getConfig() const { return config; }
+
+    /** @return Workers a decision runs on. */
+    int workerCount() const;
+
+private:
+    class Tree; /**< one arena-backed tree; defined in MctsSearch.cpp */
+
+    /** @brief Root every tree at the position and expand it. */
+    void prepare(const GameState& state, bool sumRoot, int sum, MctsResult& result);
+    /** @brief Run iterations on every worker until the budget is spent. */
+    void run(MctsResult& result);
+    /**
+     * @brief Root child with the most visits, summed over the trees (the first on ties).
+     * @param[out] winRate Its mean result
+     * @return Its position in the root's child block
+     */
+    int mostVisitedChild(double& winRate) const;
+    /** @brief Note the chosen root child, where the next decision looks for its root. */
+    void remember(int offset);
+
+    MctsConfig config; /**< settings */
+    WorkStealingPool* pool; /**< workers, or nullptr */
+    std::vector<std::unique_ptr<Tree>> trees; /**< one per worker for root parallelism, otherwise one */
+    /** @brief Per-worker iteration count, padded so workers never share a cache line. */
+    struct alignas(64) WorkerCount {
+        std::uint64_t iterations = 0;
+    };
+
+    std::vector<std::vector<std::uint32_t>> paths; /**< per-worker path buffer */
+    std::vector<WorkerCount> counts; /**< per-worker iterations of the current decision */
+    std::uint64_t decisions = 0; /**< decisions searched; selects the dice streams */
+};
+
+#endif //MCTSSEARCH_H
@@ -0,0 +1,70 @@
+/**
+ * @file MoveList.h
+ * @brief Declares MoveList, a fixed-capacity list of combination masks used by
+ *        the AI and hint paths without touching the heap.
+ */
+
+#ifndef MOVELIST_H
+#define MOVELIST_H
+#include <array>
+#include <cstdint>
+#include "MoveTable.h"
+
+/**
+ * @class MoveList
+ * @brief Inline storage for the legal combinations of a single dice sum.
+ *
+ * Each entry is a combination mask (bit i == square i). Capacity matches the
+ * largest number of combinations any dice sum can have, so filling a list
+ * from the MoveTable can never overflow.
+ */
+class MoveList {
+public:
+    static constexpr int CAPACITY = MoveTable::MAX_COMBOS_PER_SUM; /**< Maximum entries */
+
+    /**
+     * @brief Appends a combination mask; silently ignored when the list is full.
+     * @param mask Combination to append
+     */
+    void push(const std::uint32_t mask) {
+        if (count < CAPACITY) masks[count++] = mask;
+    }
+
+    /**
+     * @brief Removes every combination that uses the given square, keeping order.
+     * @param square Square index to exclude
+     */
+    void removeTouching(const int square) {
+        if (square < 1 || square > 31) return;
+        const std::uint32_t bit = std::uint32_t{1} << square;
+        int kept = 0;
+        for (int i = 0; i < count; ++i) {
+            if (!(masks[i] & bit)) masks[kept++] = masks[i];
+        }
+        count = kept;
+    }
+
+    /** @brief Removes all entries. */
+    void clear() { count = 0; }
+
+    /** @return Number of combinations in the list. */
+    int size() const { return count; }
+
+    /** @return true when the list holds no combinations. */
+    bool empty() const { return count == 0; }
+
+    /** @return Combination mask at index i. */
+    std::uint32_t operator[](const int i) const { return masks[i]; }
+
+    /** @return Pointer to the first combination. */
+    const std::uint32_t* begin() const { return masks.data(); }
+
+    /** @return Pointer past the last combination. */
+    const std::uint32_t* end() const { return masks.data() + count; }
+
+private:
+    std::array<std::uint32_t, CAPACITY> masks{}; /**< combination masks */
+    int count = 0; /**< number of valid entries */
+};
+
+#endif //MOVELIST_H
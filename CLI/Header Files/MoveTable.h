@@ -0,0 +1,89 @@
+/**
+ * @file MoveTable.h
+ * @brief Declares MoveTable, the precomputed list of square combinations
+ *        (as bitmasks) that add up to each dice sum.
+ */
+
+#ifndef MOVETABLE_H
+#define MOVETABLE_H
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <set>
+
+/**
+ * @class MoveTable
+ * @brief Subset-sum move generation table built once at startup.
+ *
+ * For every dice sum 1..MAX_SUM the table lists each set of distinct squares
+ * adding up to that sum, encoded as a mask where bit i represents square i.
+ * Legal moves for a board are the entries whose mask is contained in the
+ * board's available-squares mask. Entries are stored in the same order that
+ * std::set<std::set<int>> iterates, so callers enumerating the table see the
+ * combinations in the order the recursive search used to produce them.
+ */
+class MoveTable {
+public:
+    static constexpr int MAX_SUM = 12; /**< Largest sum two dice can produce */
+    static constexpr int MAX_COMBOS_PER_SUM = 15; /**< Distinct-part partitions of 12 */
+
+    /**
+     * @brief Returns the process-wide table, building it on first use.
+     * @return Reference to the immutable table
+     */
+    static const MoveTable& instance();
+
+    /**
+     * @brief Returns the number of combinations adding up to `sum`.
+     * @param sum Dice sum (1..MAX_SUM)
+     * @return Count of entries for the sum, or 0 when out of range
+     */
+    int count(int sum) const;
+
+    /**
+     * @brief Returns the combination masks adding up to `sum`.
+     * @param sum Dice sum (1..MAX_SUM)
+     * @return Pointer to count(sum) masks
+     */
+    const std::uint32_t* combos(int sum) const;
+
+    /**
+     * @brief Orders two combination masks the way std::set<int> compares:
+     *        lexicographically by their ascending squares. Usable at compile time.
+     * @param a First combination mask
+     * @param b Second combination mask
+     * @return true when `a` sorts before `b`
+     */
+    static constexpr bool comboLess(std::uint32_t a, std::uint32_t b) {
+        while (a != 0 && b != 0) {
+            const int lowA = std::countr_zero(a);
+            const int lowB = std::countr_zero(b);
+            if (lowA != lowB) return lowA < lowB;
+            a &= a - 1;
+            b &= b - 1;
+        }
+        return a == 0 && b != 0;
+    }
+
+    /**
+     * @brief Converts a combination mask to a set of square indices.
+     * @param mask Combination mask (bit i == square i)
+     * @return The squares contained in the mask
+     */
+    static std::set<int> toSet(std::uint32_t mask);
+
+    /**
+     * @brief Converts a set of square indices to a combination mask.
+     * @param combination Squares to encode (indices outside 1..31 are ignored)
+     * @return The combination mask
+     */
+    static std::uint32_t toMask(const std::set<int>& combination);
+
+private:
+    MoveTable();
+
+    std::array<std::array<std::uint32_t, MAX_COMBOS_PER_SUM>, MAX_SUM + 1> table{}; /**< masks per sum */
+    std::array<int, MAX_SUM + 1> counts{}; /**< number of masks per sum */
+};
+
+#endif //MOVETABLE_H
@@ -1,6 +1,7 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 #include "Board.h"
+#include "GameContext.h"
 
 /**
  * @file Player.h
@@ -22,12 +23,13 @@ public:
      * @brief Constructs a Player.
      * @param b Reference to the player's Board
      * @param human true if the player is a human, false for computer
+     * @param context Advantage state and dice of the game this player takes part in
      */
-    Player(Board& b, bool human);
+    Player(Board& b, bool human, GameContext& context);
 
     /**
-     * @brief Simulate rolling a single six-sided die.
-     * @return Value in range [1..6]
+     * @brief Roll one or two dice (or read them from the user) from the game's dice source.
+     * @return Sum of the dice
      */
     int rollDie() const;
 
@@ -58,6 +60,7 @@ public:
 protected:
     Board& board; /**< Associated board for this player */
     bool isHuman; /**< True when this player is human */
+    GameContext& context; /**< Advantage state and dice of the current game */
     int input{}; /**< Temporary storage for player input (UI) */
 
 private:
@@ -0,0 +1,206 @@
+/**
+ * @file PolicyTable.h
+ * @brief Declares the on-disk layout of a solved policy table, as written by
+ *        canoga_solve, and PolicyTable, the read-only memory-mapped view the
+ *        Computer consults.
+ */
+
+#ifndef POLICYTABLE_H
+#define POLICYTABLE_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Strategy.h"
+
+/**
+ * @brief Fixed-size header at the start of a policy table file.
+ *
+ * All fields are little-endian; the file is mapped and read in place, so only
+ * little-endian builds are allowed. Sections start on SECTION_ALIGNMENT boundaries
+ * and are indexed by position, index = (mine >> 1) | (theirs >> 1) << boardSize,
+ * where `mine` is the covered mask of the player to move:
+ *  - values: float win probability of the player to move, one per position
+ *  - moves:  MOVES_PER_STATE bytes per position, the best move for sums 1..12
+ *  - dice:   one bit per position, set when rolling one die is optimal
+ */
+struct PolicyTableHeader {
+    char magic[8]; /**< PolicyTable::MAGIC */
+    std::uint32_t version; /**< PolicyTable::VERSION */
+    std::uint32_t boardSize; /**< squares per board */
+    std::uint32_t ruleFlags; /**< PolicyTable::RULE_* bits the table was solved with */
+    std::uint32_t movesPerState; /**< bytes per position in the moves section */
+    std::uint64_t stateCount; /**< positions per section (4^boardSize) */
+    std::uint64_t valuesOffset; /**< file offset of the values section */
+    std::uint64_t movesOffset; /**< file offset of the moves section */
+    std::uint64_t diceOffset; /**< file offset of the dice section */
+    std::uint64_t fileSize; /**< total file size in bytes */
+    std::uint64_t payloadChecksum; /**< checksum of bytes [valuesOffset, fileSize) */
+    std::uint64_t headerChecksum; /**< checksum of every header byte before this field */
+};
+
+/**
+ * @class PolicyTable
+ * @brief A solved policy table mapped read-only into memory, plus the format
+ *        constants and move encoding shared with the writer.
+ *
+ * Opening a table maps the file and validates only the header, so the cost is
+ * the same for any table size; pages are faulted in on first lookup and, being
+ * a shared read-only file mapping, are shared by every process using the table.
+ * Lookups are a single index into the mapped sections.
+ *
+ * A move byte holds the combination's index in MoveTable::combos(sum) in its
+ * low bits and UNCOVER_BIT for an uncover; NO_MOVE marks a roll with no legal
+ * move.
+ */
+class PolicyTable {
+public:
+    static constexpr char MAGIC[8] = {'C', 'A', 'N', 'O', 'G', 'A', 'P', 'T'}; /**< File signature */
+    static constexpr std::uint32_t VERSION = 1; /**< Current format version */
+    static constexpr std::uint32_t RULE_ONE_DIE = 1u << 0; /**< One die allowed once squares 7+ are covered */
+    static constexpr std::uint32_t RULE_TURN_ENDS_ON_EMPTY = 1u << 1; /**< Turn ends once the opponent has nothing covered */
+    static constexpr std::uint32_t MOVES_PER_STATE = 12; /**< One move byte per dice sum 1..12 */
+    static constexpr std::uint64_t SECTION_ALIGNMENT = 64; /**< Section offsets are multiples of this */
+    static constexpr std::uint8_t NO_MOVE = 0xFF; /**< Move byte for a roll without a legal move */
+    static constexpr std::uint8_t UNCOVER_BIT = 0x10; /**< Move byte flag for an uncover */
+    static constexpr std::uint8_t COMBO_INDEX_MASK = 0x0F; /**< Move byte bits holding the combination index */
+    static constexpr std::uint64_t CHECKSUM_SEED = 0xCBF29CE484222325ull; /**< FNV-1a offset basis */
+
+    /**
+     * @brief Encodes a move for the moves section.
+     * @param sum Dice sum the move was chosen for (1..12)
+     * @param move The move (Action::None encodes as NO_MOVE)
+     * @return The move byte
+     */
+    static std::uint8_t encodeMove(int sum, const strategy::StrategyResult& move);
+
+    /**
+     * @brief Decodes a move byte.
+     * @param sum Dice sum the byte belongs to (1..12)
+     * @param code Move byte from the moves section
+     * @return The move (Action::None for NO_MOVE or an invalid byte)
+     */
+    static strategy::StrategyResult decodeMove(int sum, std::uint8_t code);
+
+    /**
+     * @brief 64-bit FNV-1a checksum, chainable across buffers.
+     * @param data Bytes to hash
+     * @param length Number of bytes
+     * @param hash Running hash (CHECKSUM_SEED for a new checksum)
+     * @return Updated hash
+     */
+    static std::uint64_t checksum(const void* data, std::size_t length, std::uint64_t hash = CHECKSUM_SEED);
+
+    /**
+     * @brief Returns the table for a board size, mapping it on first use.
+     *
+     * Looks for canoga_policy_<size>.bin in the directory named by the
+     * CANOGA_POLICY_DIR environment variable, or the working directory.
+     *
+     * @param boardSize Squares per board
+     * @return The mapped table, or nullptr when none is available
+     */
+    static const PolicyTable* forBoardSize(int boardSize);
+
+    PolicyTable() = default;
+    ~PolicyTable();
+    PolicyTable(const PolicyTable&) = delete;
+    PolicyTable& operator=(const PolicyTable&) = delete;
+
+    /**
+     * @brief Maps a table file and validates its header.
+     * @param filename Path of the table
+     * @param boardSize Required board size, or 0 to accept any
+     * @return true on success; prints the reason and returns false otherwise
+     */
+    bool open(const std::string& filename, int boardSize = 0);
+
+    /** @brief Unmaps the table. */
+    void close();
+
+    /** @return true when a table is mapped. */
+    bool isOpen() const { return header != nullptr; }
+
+    /** @return Board size of the mapped table (0 when closed). */
+    int getBoardSize() const { return boardSize; }
+
+    /**
+     * @brief Checksums every section against the header; reads the whole file.
+     * @return true when the payload matches
+     */
+    bool verifyPayload() const;
+
+    /**
+     * @brief Win probability of the player about to roll.
+     * @param myMask Covered mask of the player to move
+     * @param oppMask Covered mask of the opponent
+     * @return Win probability in [0, 1]
+     */
+    double value(std::uint32_t myMask, std::uint32_t oppMask) const;
+
+    /**
+     * @brief Optimal number of dice for the player to move.
+     * @param myMask Covered mask of the player to move
+     * @param oppMask Covered mask of the opponent
+     * @return 1 or 2
+     */
+    int diceCount(std::uint32_t myMask, std::uint32_t oppMask) const;
+
+    /**
+     * @brief Best move for a rolled sum.
+     *
+     * The table is solved without the advantage square's one-turn protection;
+     * when the stored move would uncover the protected square, the remaining
+     * moves are ranked by their stored successor values instead.
+     *
+     * @param myMask Covered mask of the player to move
+     * @param oppMask Covered mask of the opponent
+     * @param sum Dice sum rolled
+     * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+     * @return The move (Action::None when no legal move exists)
+     */
+    strategy::StrategyResult bestMove(std::uint32_t myMask, std::uint32_t oppMask, int sum,
+                                      int protectedSquare) const;
+
+    /**
+     * @brief Win probability of the mover after a move, from the stored value of
+     *        the position it leads to (the mover rolls again unless the move
+     *        wins or leaves the opponent nothing covered).
+     * @param myMask Covered mask of the player to move
+     * @param oppMask Covered mask of the opponent
+     * @param move A legal move
+     * @return Win probability in [0, 1]
+     */
+    double valueAfter(std::uint32_t myMask, std::uint32_t oppMask, const strategy::StrategyResult& move) const;
+
+private:
+    /** @brief Section index of a position. */
+    std::size_t indexOf(std::uint32_t mine, std::uint32_t theirs) const {
+        return (mine >> 1) | (static_cast<std::size_t>(theirs >> 1) << boardSize);
+    }
+
+    /** @brief valueAfter() on masks already limited to the board. */
+    double successorValue(std::uint32_t mine, std::uint32_t theirs, std::uint32_t combo, bool covering) const {
+        if (covering) {
+            const std::uint32_t next = mine | combo;
+            if (next == fullMask) return 1.0;
+            return theirs == 0 ? 1.0 - values[indexOf(theirs, next)] : values[indexOf(next, theirs)];
+        }
+        const std::uint32_t next = theirs & ~combo;
+        return next == 0 ? 1.0 : values[indexOf(mine, next)];
+    }
+
+    /** @brief Best legal move by successor value, skipping moves that touch `guarded`. */
+    strategy::StrategyResult rankMoves(std::uint32_t mine, std::uint32_t theirs, int sum,
+                                       std::uint32_t guarded) const;
+
+    void* mapping = nullptr; /**< start of the mapped file */
+    std::size_t mappedSize = 0; /**< length of the mapping */
+    const PolicyTableHeader* header = nullptr; /**< header at the start of the mapping */
+    const float* values = nullptr; /**< values section */
+    const std::uint8_t* moves = nullptr; /**< moves section */
+    const std::uint8_t* dice = nullptr; /**< one-die bitmap */
+    int boardSize = 0; /**< squares per board */
+    std::uint32_t fullMask = 0; /**< bits 1..boardSize */
+};
+
+#endif //POLICYTABLE_H
@@ -0,0 +1,95 @@
+/**
+ * @file RolloutSearch.h
+ * @brief Declares RolloutSearch, a Monte Carlo AI that scores each candidate
+ *        move by playing the round out many times within a time budget.
+ */
+
+#ifndef ROLLOUTSEARCH_H
+#define ROLLOUTSEARCH_H
+#include <cstdint>
+#include "GameState.h"
+#include "Strategy.h"
+
+class DiceSource;
+class TranspositionTable;
+class WorkStealingPool;
+
+/**
+ * @brief Settings for a RolloutSearch.
+ */
+struct RolloutConfig {
+    int budgetMs = 100; /**< Wall-clock time per decision; 0 for no limit (maxPlayouts must be set) */
+    std::uint64_t maxPlayouts = 0; /**< Playouts per candidate move; 0 for no limit (budgetMs must be set) */
+    bool greedyPlayouts = true; /**< Playouts follow computeBestMove; false picks uniformly among legal moves */
+    std::uint64_t seed = 1; /**< DiceSource key for the playouts */
+    TranspositionTable* table = nullptr; /**< Position values shared with other searches, or nullptr */
+};
+
+/**
+ * @brief Outcome of one decision.
+ */
+struct RolloutResult {
+    strategy::StrategyResult move{strategy::StrategyResult::Action::None, 0}; /**< chosen move */
+    double winRate = 0.0; /**< empirical win rate of the chosen move (1 for an immediate win) */
+    std::uint64_t playouts = 0; /**< playouts run over all candidates */
+    int candidates = 0; /**< legal moves that were considered */
+};
+
+/**
+ * @class RolloutSearch
+ * @brief Picks the move whose playouts win most often.
+ *
+ * Every legal cover and uncover for the roll is a candidate. An immediate win
+ * is taken at once and a single candidate needs no playouts; otherwise each
+ * candidate is applied to a GameState and the round is played to the end,
+ * with the mover continuing its turn and both sides then following the greedy
+ * strategy (or random legal moves) and the heuristic dice count.
+ *
+ * Playouts run in rounds of doubling size spread across the pool's workers,
+ * each tallying wins into its own slot, until the time budget or playout cap
+ * is reached. Playout k of every candidate uses the same DiceSource stream
+ * (keyed by the seed, the position and k), so candidates are compared on the
+ * same dice and the comparison needs far fewer playouts.
+ *
+ * With a TranspositionTable, each candidate's tally starts from the stored
+ * value of the position it leads to (worth at most a few dozen playouts), and
+ * the final tallies are stored back for later decisions and other searches.
+ */
+class RolloutSearch {
+public:
+    static constexpr int MAX_CANDIDATES = 2 * MoveList::CAPACITY; /**< covers plus uncovers for one sum */
+
+    /**
+     * @brief Constructs a search.
+     * @param config Budget, playout policy and seed (with neither a budget nor a cap, the default budget applies)
+     * @param pool Workers to spread playouts across, or nullptr to run on the calling thread
+     */
+    explicit RolloutSearch(const RolloutConfig& config, WorkStealingPool* pool = nullptr);
+
+    /**
+     * @brief Choose the mover's move for a rolled sum.
+     * @param state Position, with the mover to play and its protection
+     * @param sum Dice sum rolled
+     * @return Chosen move and its statistics (Action::None when no legal move exists)
+     */
+    RolloutResult bestMove(const GameState& state, int sum) const;
+
+    /**
+     * @brief Play a position to the end of the round.
+     * @param state Position to play out; it is modified
+     * @param dice Dice for the playout
+     * @param greedy Follow computeBestMove; false picks uniformly among legal moves
+     * @param firstSum Sum the mover has already rolled, or 0 to start with a roll
+     * @return Winning seat, or -1 when the turn limit is reached
+     */
+    static int playout(GameState& state, DiceSource& dice, bool greedy = true, int firstSum = 0);
+
+    /** @return The settings this search uses. */
+    const RolloutConfig& getConfig() const { return config; }
+
+private:
+    RolloutConfig config; /**< settings */
+    WorkStealingPool* pool; /**< workers, or nullptr */
+};
+
+#endif //ROLLOUTSEARCH_H
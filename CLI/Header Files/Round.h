@@ -19,6 +19,55 @@ class Player;
  */
 class Round {
 public:
+    /**
+     * @brief How a round ended, by the rules declareWinner scores it with.
+     */
+    struct Outcome {
+        GameContext::Side winner = GameContext::Side::None; /**< winning side; None while the round is on */
+        bool byCover = false; /**< won by covering every own square (by uncovering the opponent's otherwise) */
+        int score = 0; /**< points the winner adds to their tournament score */
+    };
+
+    /**
+     * @brief What a move did to the round, from the mover's side.
+     */
+    struct MoveOutcome {
+        bool won = false; /**< the move won the round */
+        bool byCover = false; /**< won by covering every own square (by uncovering the opponent's otherwise) */
+        int score = 0; /**< points the mover wins */
+        bool turnEnds = false; /**< the round goes on but the mover's turn is over */
+    };
+
+    /**
+     * @brief The round's win, scoring and turn rules at mask level, shared by
+     *        every place that plays a move (Round, Simulator, EngineSession,
+     *        the searches and the solver).
+     *
+     * Covering every own square wins by cover and scores the opponent's
+     * uncovered squares. Uncovering the opponent's last covered square wins by
+     * uncover and scores the own covered squares. Otherwise the mover keeps
+     * rolling, except that the turn ends once the opponent has nothing covered
+     * (as in Computer::takeTurn): a cover cannot win by uncover.
+     *
+     * @param own Mover's covered squares after the move
+     * @param opponent Opponent's covered squares after the move
+     * @param fullMask Every square of a board
+     * @param covering Whether the move covered; false judges the boards alone,
+     *        so an empty opponent board counts as uncovered by the mover
+     * @return The outcome
+     */
+    static MoveOutcome outcomeOfMove(std::uint32_t own, std::uint32_t opponent, std::uint32_t fullMask, bool covering);
+
+    /**
+     * @brief Decide a round from the final boards: a full own board wins by
+     *        cover and scores the opponent's uncovered squares; an empty
+     *        opponent board wins by uncover and scores the own covered squares.
+     * @param human The Human's board
+     * @param computer The Computer's board
+     * @return The outcome (winner None when neither condition holds)
+     */
+    static Outcome outcomeOf(const Board& human, const Board& computer);
+
     /**
      * @brief Constructs a Round controller.
      * @param p1 First player (could be human or computer)
@@ -53,6 +102,9 @@ public:
     Player& determineFirstPlayer() const;
 
 private:
+    /** @brief Journal the round's starting position, scores, advantage and first player. */
+    void journalRoundStart() const;
+
     Player& player1; /**< First player reference internally */
     Player& player2; /**< Second player reference internally */
     bool isOver; /**< Whether this round has completed */
@@ -0,0 +1,166 @@
+/**
+ * @file SaveGame.h
+ * @brief Declares SavedGame, the persisted state of a tournament, and the
+ *        text and versioned binary save file formats it is written in.
+ */
+
+#ifndef SAVEGAME_H
+#define SAVEGAME_H
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include "GameContext.h"
+
+/**
+ * @brief Everything a save file records about a game in progress: the whole
+ *        Tournament state, including the advantage in play and the dice.
+ *
+ * Both file formats hold exactly these fields, so a save converts from one
+ * format to the other and back without loss, and a game resumed from a save
+ * continues exactly as it would have. The dice are recorded by position
+ * (seed, game, turn); saves are taken between turns, where that position is
+ * the whole DiceSource state.
+ */
+struct SavedGame {
+    int boardSize = 0; /**< squares per board */
+    std::uint32_t computerMask = 0; /**< Computer's covered squares (bit i == square i) */
+    std::uint32_t humanMask = 0; /**< Human's covered squares */
+    int computerScore = 0; /**< Computer's tournament score */
+    int humanScore = 0; /**< Human's tournament score */
+    bool firstPlayerIsHuman = true; /**< the Human started the round */
+    bool isHumanTurn = true; /**< the Human moves next */
+    int pendingAdvantageSquare = 0; /**< advantage square queued for the next round (0 for none) */
+    GameContext::Side pendingAdvantageFor = GameContext::Side::None; /**< side the queued advantage goes to */
+    GameContext::AdvantageState advantage; /**< advantage in play this round */
+    bool diceSaved = false; /**< the dice fields are set (saves from before they were recorded lack them) */
+    std::uint64_t diceSeed = 0; /**< DiceSource seed */
+    std::uint64_t diceGameId = 0; /**< DiceSource game id */
+    std::uint32_t diceTurn = 0; /**< DiceSource turn */
+
+    bool operator==(const SavedGame&) const = default;
+};
+
+/**
+ * @brief Fixed-size record of a binary save file.
+ *
+ * All fields are little-endian; the record is copied as it is laid out in
+ * memory, so only little-endian builds are allowed. The file is exactly one
+ * record; `crc` is the CRC-32 (IEEE 802.3) of every byte before it, so a
+ * truncated or damaged save is rejected rather than loaded as a different
+ * position. Version 1 records
+ * end after `reserved` with the CRC of the bytes before it (40 bytes in all);
+ * they still load, with no advantage in play and the dice left as they are.
+ */
+struct SaveFileRecord {
+    char magic[8]; /**< savegame::MAGIC */
+    std::uint32_t version; /**< savegame::VERSION */
+    std::uint32_t boardSize; /**< squares per board */
+    std::uint32_t computerMask; /**< Computer's covered squares */
+    std::uint32_t humanMask; /**< Human's covered squares */
+    std::int32_t computerScore; /**< Computer's tournament score */
+    std::int32_t humanScore; /**< Human's tournament score */
+    std::uint8_t turnFlags; /**< savegame::TURN_* bits */
+    std::uint8_t pendingAdvantageFor; /**< GameContext::Side of the queued advantage */
+    std::uint8_t pendingAdvantageSquare; /**< queued advantage square (0 for none) */
+    std::uint8_t reserved; /**< zero */
+    std::uint8_t advantageOwner; /**< GameContext::Side owning the active advantage */
+    std::uint8_t advantageSquare; /**< advantage square index */
+    std::uint8_t stateFlags; /**< savegame::STATE_* bits */
+    std::uint8_t reserved2; /**< zero */
+    std::uint64_t diceSeed; /**< DiceSource seed */
+    std::uint64_t diceGameId; /**< DiceSource game id */
+    std::uint32_t diceTurn; /**< DiceSource turn */
+    std::uint32_t crc; /**< CRC-32 of every byte before this field */
+};
+
+/**
+ * @namespace savegame
+ * @brief Reading and writing SavedGame in the text and binary formats.
+ *
+ * The text format is the readable one players have always saved to. The
+ * binary format is one checksummed SaveFileRecord, chosen by saving to a
+ * name ending in BINARY_EXTENSION; loading recognises either format by its
+ * first bytes, whatever the name.
+ */
+namespace savegame {
+    constexpr char MAGIC[8] = {'C', 'A', 'N', 'O', 'G', 'A', 'S', 'V'}; /**< Binary file signature */
+    constexpr std::uint32_t VERSION = 2; /**< Current binary format version */
+    constexpr std::size_t VERSION_1_SIZE = 40; /**< Size of a version 1 record */
+    constexpr std::uint8_t TURN_FIRST_PLAYER_HUMAN = 1u << 0; /**< turnFlags: the Human started the round */
+    constexpr std::uint8_t TURN_HUMAN_TO_MOVE = 1u << 1; /**< turnFlags: the Human moves next */
+    constexpr std::uint8_t STATE_ADVANTAGE_APPLIED = 1u << 0; /**< stateFlags: an advantage is active */
+    constexpr std::uint8_t STATE_PROTECT_HUMAN = 1u << 1; /**< stateFlags: the Human's advantage square is protected */
+    constexpr std::uint8_t STATE_PROTECT_COMPUTER = 1u << 2; /**< stateFlags: the Computer's advantage square is protected */
+    constexpr std::uint8_t STATE_DICE_SAVED = 1u << 3; /**< stateFlags: the dice fields are set */
+    constexpr const char* BINARY_EXTENSION = ".cgs"; /**< Save names with this ending are written in binary */
+
+    /** @brief Save file formats. */
+    enum class Format { Text, Binary };
+
+    /**
+     * @brief Picks the format a save name asks for.
+     * @param filename Path of the save
+     * @return Format::Binary for names ending in BINARY_EXTENSION, otherwise Format::Text
+     */
+    Format formatFor(const std::string& filename);
+
+    /**
+     * @brief CRC-32 (IEEE 802.3, reflected), chainable across buffers.
+     * @param data Bytes to checksum
+     * @param length Number of bytes
+     * @param crc Running CRC (0 for a new checksum)
+     * @return Updated CRC
+     */
+    std::uint32_t crc32(const void* data, std::size_t length, std::uint32_t crc = 0);
+
+    /**
+     * @brief Writes a game in the text format.
+     * @param out Destination stream
+     * @param game Game to write
+     */
+    void writeText(std::ostream& out, const SavedGame& game);
+
+    /**
+     * @brief Reads a game in the text format.
+     * @param in Source stream
+     * @param game Receives the game
+     * @return nullptr on success, otherwise the reason the text is not a save
+     */
+    const char* readText(std::istream& in, SavedGame& game);
+
+    /**
+     * @brief Encodes a game as a binary record.
+     * @param game Game to encode (masks must fit the board, scores an int32)
+     * @return The record, checksum included
+     */
+    SaveFileRecord toRecord(const SavedGame& game);
+
+    /**
+     * @brief Decodes and validates a binary save.
+     * @param data File contents
+     * @param length Size of the contents
+     * @param game Receives the game
+     * @return nullptr on success, otherwise the reason the data is rejected
+     */
+    const char* fromBinary(const void* data, std::size_t length, SavedGame& game);
+
+    /**
+     * @brief Writes a save file.
+     * @param filename Path of the file
+     * @param game Game to save
+     * @param format Format to write
+     * @return true on success; prints the reason and returns false otherwise
+     */
+    bool save(const std::string& filename, const SavedGame& game, Format format);
+
+    /**
+     * @brief Reads a save file in either format.
+     * @param filename Path of the file
+     * @param game Receives the game
+     * @return true on success; prints the reason and returns false otherwise
+     */
+    bool load(const std::string& filename, SavedGame& game);
+}
+
+#endif //SAVEGAME_H
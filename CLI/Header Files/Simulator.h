@@ -0,0 +1,116 @@
+/**
+ * @file Simulator.h
+ * @brief Declares the headless Computer-vs-Computer simulator used to evaluate
+ *        AI changes over many games without any terminal interaction.
+ */
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+#include <cstdint>
+
+class MctsSearch;
+class PolicyTable;
+class RolloutSearch;
+class Solver;
+class WorkStealingPool;
+
+/**
+ * @brief Settings shared by every game a Simulator plays.
+ */
+struct SimConfig {
+    int boardSize = 9; /**< Squares per board (9, 10 or 11 in the CLI) */
+    std::uint64_t seed = 1; /**< DiceSource key; each game draws from its own (seed, game, turn) streams */
+    bool advantageRules = true; /**< Apply the handicap/advantage square between rounds */
+    int roundsPerGame = 1; /**< 1 plays single rounds; more plays a tournament of that many rounds */
+    const Solver* seatSolver[2] = {nullptr, nullptr}; /**< Solved table per seat; null plays the greedy strategy */
+    const PolicyTable* seatPolicy[2] = {nullptr, nullptr}; /**< Mapped policy table per seat; takes precedence over seatSolver */
+    const RolloutSearch* seatRollout[2] = {nullptr, nullptr}; /**< Monte Carlo search per seat; used when no table is set */
+    MctsSearch* seatMcts[2] = {nullptr, nullptr}; /**< Tree search per seat (one per seat, games run serially); used when none of the above is set */
+};
+
+/**
+ * @brief Aggregate results over a batch of simulated games.
+ *
+ * Seat 0 corresponds to the Round's player1 (the "human" slot) and seat 1 to
+ * player2 (the "computer" slot); both seats are driven by the Computer strategy
+ * unless SimConfig::seatPolicy or SimConfig::seatSolver gives a seat optimal play
+ * or SimConfig::seatRollout or SimConfig::seatMcts gives it a Monte Carlo search.
+ */
+struct SimStats {
+    std::uint64_t games = 0; /**< Games (single rounds or tournaments) completed */
+    std::uint64_t rounds = 0; /**< Rounds completed */
+    std::uint64_t abandonedRounds = 0; /**< Rounds stopped at the turn limit */
+    std::uint64_t roundWins[2] = {}; /**< Rounds won per seat */
+    std::uint64_t firstPlayerRoundWins = 0; /**< Rounds won by the side that moved first */
+    std::uint64_t coverWins = 0; /**< Rounds won by covering every own square */
+    std::uint64_t uncoverWins = 0; /**< Rounds won by uncovering every opponent square */
+    std::uint64_t points[2] = {}; /**< Tournament points scored per seat */
+    std::uint64_t gameWins[2] = {}; /**< Games won per seat (by total points) */
+    std::uint64_t gameDraws = 0; /**< Games ending level on points */
+    std::uint64_t turns = 0; /**< Player turns taken */
+    std::uint64_t rolls = 0; /**< Dice rolls made */
+    std::uint64_t moves = 0; /**< Cover/uncover moves applied */
+
+    /**
+     * @brief Add another batch's counters to this one.
+     * @param other Statistics to accumulate
+     */
+    void merge(const SimStats& other);
+};
+
+/**
+ * @class Simulator
+ * @brief Plays complete Computer-vs-Computer rounds or tournaments headlessly.
+ *
+ * Rounds follow the CLI rules: the first player is decided by a two-dice roll,
+ * a player keeps rolling until a roll has no legal move, the one-die rule and
+ * advantage protection apply, and scoring/handicaps mirror Round::declareWinner
+ * and Tournament::applyHandicap. Every game draws its dice from a DiceSource
+ * keyed by (seed, game index), so results do not depend on play order and any
+ * single game can be replayed with playGame().
+ */
+class Simulator {
+public:
+    static constexpr int MAX_TURNS_PER_ROUND = 10000; /**< Safety limit for pathological rounds */
+
+    /**
+     * @brief Constructs a simulator for the given settings.
+     * @param config Board size, seed and rule settings
+     */
+    explicit Simulator(const SimConfig& config);
+
+    /**
+     * @brief Play one complete game and accumulate its results.
+     * @param gameId Index of the game (selects its dice stream)
+     * @param stats Statistics to update
+     */
+    void playGame(std::uint64_t gameId, SimStats& stats) const;
+
+    /**
+     * @brief Play games [firstGame, firstGame + count) and return their statistics.
+     * @param firstGame Index of the first game
+     * @param count Number of games to play
+     * @return Aggregate statistics for the batch
+     */
+    SimStats run(std::uint64_t firstGame, std::uint64_t count) const;
+
+    /**
+     * @brief Play games [firstGame, firstGame + count) across the pool's workers.
+     *        Each worker accumulates into its own statistics slot; the slots are
+     *        merged once the pool has finished, so no locking happens per game.
+     *        Results are identical to run() for the same range.
+     * @param firstGame Index of the first game
+     * @param count Number of games to play
+     * @param pool Worker pool to run on
+     * @return Aggregate statistics for the batch
+     */
+    SimStats run(std::uint64_t firstGame, std::uint64_t count, WorkStealingPool& pool) const;
+
+    /** @return The configuration this simulator plays with. */
+    const SimConfig& getConfig() const { return config; }
+
+private:
+    SimConfig config; /**< Settings for every game */
+};
+
+#endif //SIMULATOR_H
@@ -0,0 +1,194 @@
+/**
+ * @file Solver.h
+ * @brief Declares Solver, an exact expectimax solver for two-player Canoga
+ *        positions that maximises the probability of winning the round.
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Strategy.h"
+
+class WorkStealingPool;
+
+/**
+ * @class Solver
+ * @brief Win probabilities and optimal decisions for every position of a board size.
+ *
+ * A position is (covered mask of the player to move, covered mask of the
+ * opponent); the side to move is implicit because values are always from the
+ * mover's point of view. Each turn starts with a decision node (one or two
+ * dice, one die only under the one-die rule), followed by a chance node over
+ * every dice sum and a decision node over every legal cover/uncover move. The
+ * mover keeps rolling after a move; a roll with no legal move passes the turn,
+ * so the position is re-entered from the opponent's side.
+ *
+ * Moves within a turn always raise (covered own) - (covered opponent), so the
+ * in-turn graph is acyclic, but passes make the game graph cyclic. The table
+ * of values (the memo) is therefore filled by Gauss-Seidel sweeps in
+ * decreasing order of that difference until no value changes by more than the
+ * tolerance, with the two slowest geometric components of the sweeps'
+ * changes extrapolated once they settle. The advantage square's one-turn
+ * protection is not part of the state; bestMove() honours it by restricting
+ * the candidate moves.
+ *
+ * The position code is templated on the board's spec (see BoardSpec.h), and
+ * each public entry point picks the specialisation once, so for the 9-, 10-
+ * and 11-square boards the sweeps run on compile-time masks and tables.
+ *
+ * Rules are Round::outcomeOfMove's, including the early end of a turn.
+ */
+class Solver {
+public:
+    static constexpr int MAX_BOARD_SIZE = 12; /**< Largest board the dense table supports */
+
+    /**
+     * @brief Prepares an unsolved table for the given board size.
+     * @param boardSize Number of squares (1..MAX_BOARD_SIZE)
+     */
+    explicit Solver(int boardSize);
+
+    /**
+     * @brief Iterate until converged.
+     * @param tolerance Largest change in any value that still counts as converged
+     * @param maxSweeps Upper bound on the number of sweeps
+     * @return Number of sweeps performed
+     */
+    int solve(double tolerance = 1e-6, int maxSweeps = 10000);
+
+    /**
+     * @brief Iterate until converged, updating each layer's rows in parallel.
+     *        Produces exactly the same table as the single-threaded solve.
+     * @param tolerance Largest change in any value that still counts as converged
+     * @param maxSweeps Upper bound on the number of sweeps
+     * @param pool Worker pool that processes the rows of each layer
+     * @return Number of sweeps performed
+     */
+    int solve(double tolerance, int maxSweeps, WorkStealingPool& pool);
+
+    /**
+     * @brief Writes the solved table in the policy table format (see PolicyTable.h).
+     * @param filename Path of the file to create
+     * @return true on success; prints an error and returns false otherwise
+     */
+    bool writeTable(const std::string& filename) const;
+
+    /** @return Board size this solver was built for. */
+    int getBoardSize() const { return boardSize; }
+
+    /**
+     * @brief Probability that the player about to roll wins the round.
+     * @param mine Covered mask of the player to move (bit i == square i)
+     * @param theirs Covered mask of the opponent
+     * @return Win probability in [0, 1]
+     */
+    double value(std::uint32_t mine, std::uint32_t theirs) const;
+
+    /**
+     * @brief Win probability of rolling `diceCount` dice and then playing optimally.
+     * @param mine Covered mask of the player to move
+     * @param theirs Covered mask of the opponent
+     * @param diceCount 1 or 2
+     * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+     * @return Win probability in [0, 1]
+     */
+    double diceValue(std::uint32_t mine, std::uint32_t theirs, int diceCount, int protectedSquare = 0) const;
+
+    /**
+     * @brief Optimal number of dice for the player to move.
+     * @param mine Covered mask of the player to move
+     * @param theirs Covered mask of the opponent
+     * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+     * @return 1 or 2 (2 whenever the one-die rule does not allow 1)
+     */
+    int bestDiceCount(std::uint32_t mine, std::uint32_t theirs, int protectedSquare = 0) const;
+
+    /**
+     * @brief Win-probability-maximising move for a rolled sum.
+     * @param mine Covered mask of the player to move
+     * @param theirs Covered mask of the opponent
+     * @param sum Dice sum rolled
+     * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+     * @param winProbability Receives the mover's win probability after the move (optional)
+     * @return The move (Action::None when no legal move exists)
+     */
+    strategy::StrategyResult bestMove(std::uint32_t mine, std::uint32_t theirs, int sum,
+                                      int protectedSquare = 0, double* winProbability = nullptr) const;
+
+protected:
+    /** @brief Dense index of a position. */
+    std::size_t indexOf(std::uint32_t mine, std::uint32_t theirs) const {
+        return (mine >> 1) | (static_cast<std::size_t>(theirs >> 1) << boardSize);
+    }
+
+    /** @brief Dense index of a position, with the shift taken from the spec. */
+    template <class Spec>
+    static std::size_t indexOf(const Spec& spec, std::uint32_t mine, std::uint32_t theirs) {
+        return (mine >> 1) | (static_cast<std::size_t>(theirs >> 1) << spec.size());
+    }
+
+    /** @brief Value of a roll outcome: best over legal moves, or the pass value. */
+    template <class Spec>
+    double outcomeValue(const Spec& spec, std::uint32_t mine, std::uint32_t theirs, int sum, int protectedSquare,
+                        double pass, strategy::StrategyResult* best) const;
+
+    /** @brief Expected value of rolling a given number of dice. */
+    template <class Spec>
+    double diceValue(const Spec& spec, std::uint32_t mine, std::uint32_t theirs, int diceCount,
+                     int protectedSquare) const;
+
+    /** @brief Best uncover value of every sum for positions sharing an opponent mask. */
+    template <class Spec>
+    void uncoverValues(const Spec& spec, std::uint32_t theirs, const std::uint32_t* mines, std::size_t count,
+                       float* best) const;
+
+    /** @brief Recompute one position from the current table and its uncover values; returns the new value. */
+    template <class Spec>
+    double evaluate(const Spec& spec, std::uint32_t mine, std::uint32_t theirs, const float* uncover,
+                    std::size_t stride) const;
+
+    /** @brief Recompute and store one position; returns the change. */
+    template <class Spec>
+    double update(const Spec& spec, std::uint32_t mine, std::uint32_t theirs, const float* uncover,
+                  std::size_t stride);
+
+    /** @brief Recompute one opponent row of a layer; returns the largest change. */
+    template <class Spec>
+    double updateRow(const Spec& spec, int diff, std::uint32_t theirs);
+
+    /** @brief Mover's value when the turn passes at (mine, theirs). */
+    template <class Spec>
+    double passValue(const Spec& spec, std::uint32_t mine, std::uint32_t theirs) const {
+        return 1.0 - values[indexOf(spec, theirs, mine)];
+    }
+
+    /**
+     * @brief Every non-empty subset of a mask whose squares add up to at most
+     *        MoveTable::MAX_SUM, packed as (subset << SUBSET_SUM_BITS) | sum, in
+     *        increasing order of sum.
+     */
+    struct SubsetRange {
+        const std::uint32_t* first; /**< first packed subset */
+        const std::uint32_t* last; /**< one past the last */
+        const std::uint32_t* begin() const { return first; }
+        const std::uint32_t* end() const { return last; }
+    };
+    static constexpr int SUBSET_SUM_BITS = 4; /**< low bits of a packed subset holding its sum */
+
+    /** @brief The rollable subsets of a mask: the legal covers or uncovers of every sum at once. */
+    SubsetRange subsetsOf(std::uint32_t mask) const {
+        const std::uint32_t* base = subsets.data();
+        return {base + subsetStart[mask >> 1], base + subsetStart[(mask >> 1) + 1]};
+    }
+
+    int boardSize; /**< squares per board */
+    std::vector<std::uint32_t> subsets; /**< packed rollable subsets of every mask, grouped by mask and sorted by sum */
+    std::vector<std::uint32_t> subsetStart; /**< per mask >> 1, index of its first entry in `subsets` (one extra at the end) */
+    std::vector<std::vector<std::uint32_t>> masksByCount; /**< all masks grouped by popcount */
+    std::vector<std::vector<std::uint32_t>> layerRows; /**< opponent masks per layer, indexed by diff + boardSize */
+    std::vector<float> values; /**< memo: mover's win probability per position */
+};
+
+#endif //SOLVER_H
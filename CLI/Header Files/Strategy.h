@@ -0,0 +1,144 @@
+/**
+ * @file Strategy.h
+ * @brief Declares the shared move-selection engine used by the Computer player,
+ *        the hint system and the headless simulator.
+ */
+
+#ifndef STRATEGY_H
+#define STRATEGY_H
+#include <bit>
+#include <cstdint>
+#include "Board.h"
+#include "BoardSpec.h"
+#include "DiceTable.h"
+
+namespace strategy {
+
+    /**
+     * @brief Result of strategy computation describing action and chosen combo.
+     */
+    struct StrategyResult {
+        enum class Action { None, Cover, Uncover };
+        Action action;
+        std::uint32_t combo; /**< combination mask (bit i == square i) */
+    };
+
+    /** @brief Compute sum of the squares in a combination mask. */
+    int sumOf(std::uint32_t combo);
+
+    /** @brief Number of squares in a combination mask. */
+    int countOf(std::uint32_t combo);
+
+    /** @brief Return the highest square in the combination or 0 if empty. */
+    int highestSquareOf(std::uint32_t combo);
+
+    /** @brief Highest uncovered square on a board or 0 if none. */
+    int highestUncovered(const Board& b);
+
+    /** @brief Count of uncovered squares on a board. */
+    int remainingCount(const Board& b);
+
+    /**
+     * @brief Choose the best move for a dice sum: an immediate win first,
+     *        otherwise prefer covering, then most squares, then highest square.
+     * @param sum Dice sum
+     * @param myBoard Board of the acting player
+     * @param oppBoard Board of the opponent
+     * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+     * @return The chosen action and combination (Action::None when no legal move exists)
+     */
+    StrategyResult computeBestMove(int sum, const Board& myBoard, const Board& oppBoard, int protectedSquare);
+
+    /**
+     * @brief Check whether applying the candidate combo would immediately win the round.
+     * @param res Strategy result containing action and combo
+     * @param myBoard Board of the acting player
+     * @param oppBoard Board of the opponent
+     * @return true if the combo results in an immediate win
+     */
+    bool isComboWinning(const StrategyResult& res, const Board& myBoard, const Board& oppBoard);
+
+    /**
+     * @brief Dice count from DiceTable: one die when allowed and it is expected to
+     *        cover the board in fewer turns than two dice. Boards too large for the
+     *        table use heuristicDiceCount().
+     * @param myBoard Board of the acting player
+     * @return 1 or 2
+     */
+    int chooseDiceCount(const Board& myBoard);
+
+    /**
+     * @brief Heuristic dice count: one die when allowed and the highest remaining
+     *        square is at most 6 or at most three squares remain, otherwise two.
+     * @param myBoard Board of the acting player
+     * @return 1 or 2
+     */
+    int heuristicDiceCount(const Board& myBoard);
+
+    /**
+     * @brief Cover or uncover every square in a combination without printing.
+     * @param b Board to modify
+     * @param combo Combination mask
+     * @param covering true to cover the squares, false to uncover them
+     */
+    void applyCombo(Board& b, std::uint32_t combo, bool covering);
+
+    /**
+     * @brief computeBestMove() on covered masks, for loops specialised by board size.
+     *        Chooses exactly the same move as the Board version.
+     * @param spec BoardSpec or RuntimeBoardSpec of the board size
+     * @param sum Dice sum
+     * @param mine Covered squares of the acting player
+     * @param theirs Covered squares of the opponent
+     * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+     * @return The chosen action and combination (Action::None when no legal move exists)
+     */
+    template <class Spec>
+    StrategyResult computeBestMove(const Spec& spec, const int sum, const std::uint32_t mine,
+                                   const std::uint32_t theirs, const int protectedSquare) {
+        if (sum < 1 || sum > MoveTable::MAX_SUM) return {StrategyResult::Action::None, 0};
+        const std::uint32_t open = spec.fullMask() & ~mine;
+        const std::uint32_t uncoverable = protectedSquare > 0 ? theirs & ~Board::bitOf(protectedSquare) : theirs;
+
+        // A winning move uses every open square, or every opponent square; covering wins first.
+        if (open != 0 && spec.squareSum(open) == sum) return {StrategyResult::Action::Cover, open};
+        if (theirs != 0 && theirs == uncoverable && spec.squareSum(theirs) == sum) {
+            return {StrategyResult::Action::Uncover, theirs};
+        }
+
+        // Otherwise cover if possible; the first combo with the most squares, then the highest square.
+        std::uint32_t cover = 0, uncover = 0;
+        int coverRank = -1, uncoverRank = -1;
+        for (const std::uint32_t combo : spec.combos(sum)) {
+            const int rank = std::popcount(combo) * 32 + std::bit_width(combo);
+            if ((combo & ~open) == 0 && rank > coverRank) {
+                cover = combo;
+                coverRank = rank;
+            }
+            if ((combo & ~uncoverable) == 0 && rank > uncoverRank) {
+                uncover = combo;
+                uncoverRank = rank;
+            }
+        }
+        if (cover != 0) return {StrategyResult::Action::Cover, cover};
+        if (uncover != 0) return {StrategyResult::Action::Uncover, uncover};
+        return {StrategyResult::Action::None, 0};
+    }
+
+    /**
+     * @brief chooseDiceCount() on a covered mask, for loops specialised by board size.
+     * @param spec BoardSpec or RuntimeBoardSpec of the board size
+     * @param mine Covered squares of the acting player
+     * @return 1 or 2
+     */
+    template <class Spec>
+    int chooseDiceCount(const Spec& spec, const std::uint32_t mine) {
+        if (!spec.canThrowOneDie(mine)) return 2;
+        if (const DiceTable::Entry* entry = DiceTable::instance().find(spec.size(), mine)) return entry->diceCount;
+        const std::uint32_t open = spec.fullMask() & ~mine;
+        return (std::bit_width(open) - 1 <= 6 || std::popcount(open) <= 3) ? 1 : 2;
+    }
+
+} // namespace strategy
+
+#endif //STRATEGY_H
@@ -0,0 +1,113 @@
+/**
+ * @file TranspositionTable.h
+ * @brief Declares TranspositionTable, a fixed-size, lock-free hash table of
+ *        position values that every search-based player shares.
+ */
+
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class TranspositionTable
+ * @brief Position values keyed by GameState::hash, shared between searches and threads.
+ *
+ * An entry holds the playout statistics of a position whose mover is about
+ * to roll: points for the mover (2 per win, 1 per unfinished round, as in the
+ * searches' tallies) and the number of samples they came from. The sample
+ * count is the entry's depth: the more playouts behind a value, the more it
+ * is worth keeping. Searches seed new candidates and tree nodes with the
+ * stored value (as a prior worth a capped number of samples) and store their
+ * own results, so work done on one move, by one player or on one thread is
+ * not redone when a position comes back by another move order. The rollout
+ * search stores each candidate's tally once its decision is made; the tree
+ * search stores a Roll node's statistics during backup, whenever its visits
+ * reach another multiple of STORE_VISITS (MctsSearch.cpp), so other threads
+ * and trees see them while the search is still running.
+ *
+ * The table is one power-of-two array of 32-byte buckets, sized once at
+ * construction, and is never resized or allocated from again. Each bucket has
+ * a deep slot and a recent slot. An entry with at least as many samples as
+ * the deep slot's goes there, moving the deep slot's entry for another
+ * position to the recent slot. A shallower entry goes to the recent slot,
+ * unless it is for the deep slot's own position, when it is dropped.
+ * Slots are two atomic words, the data and the key XORed with the data, so
+ * readers and writers never lock: a probe only accepts a slot whose words
+ * XOR back to the key, which rejects both other positions and slots torn by
+ * a concurrent store.
+ */
+class TranspositionTable {
+public:
+    /** @brief A stored value. */
+    struct Entry {
+        std::uint32_t points = 0; /**< results for the mover: 2 per win, 1 per unfinished round */
+        std::uint32_t samples = 0; /**< playouts behind points; 0 for no entry */
+
+        /** @return The same value from the other seat's side. */
+        Entry flipped() const { return {2 * samples - points, samples}; }
+
+        /**
+         * @brief The value scaled down to at most a number of samples, to use as a prior.
+         * @param maxSamples Largest sample count the prior may claim
+         */
+        Entry cappedAt(std::uint32_t maxSamples) const;
+    };
+
+    /**
+     * @brief Allocate an empty table.
+     * @param megabytes Memory to use; rounded down to a power-of-two number of buckets (at least one)
+     */
+    explicit TranspositionTable(std::size_t megabytes);
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    /**
+     * @brief Look a position up.
+     * @param key GameState::hash of the position
+     * @param[out] entry Its value, when found
+     * @return true when the table holds the position
+     */
+    bool probe(std::uint64_t key, Entry& entry) const;
+
+    /**
+     * @brief Record a position's value, replacing a shallower entry for it.
+     * @param key GameState::hash of the position
+     * @param entry Value for the mover; entries with no samples are ignored
+     */
+    void store(std::uint64_t key, const Entry& entry);
+
+    /** @brief Forget every position. Must not overlap probes or stores. */
+    void clear();
+
+    /** @return Entries the table can hold. */
+    std::size_t capacity() const { return 2 * bucketCount; }
+
+    /** @return Bytes allocated for the entries. */
+    std::size_t sizeBytes() const { return bucketCount * sizeof(Bucket); }
+
+private:
+    /** @brief One entry: the data and the key XORed with it, so a torn pair fails verification. */
+    struct Slot {
+        std::atomic<std::uint64_t> check{0}; /**< key ^ data */
+        std::atomic<std::uint64_t> data{0}; /**< points in the high word, samples in the low word */
+    };
+
+    /** @brief Slots sharing an index. */
+    struct alignas(32) Bucket {
+        Slot deepest; /**< replaced only by an entry with at least as many samples */
+        Slot recent; /**< replaced by every other store */
+    };
+    static_assert(sizeof(Bucket) == 32, "a bucket should stay half a cache line");
+
+    /** @brief Bucket for a key. */
+    Bucket& bucketFor(std::uint64_t key) const { return buckets[key & (bucketCount - 1)]; }
+
+    std::size_t bucketCount; /**< power of two */
+    std::unique_ptr<Bucket[]> buckets; /**< the table */
+};
+
+#endif //TRANSPOSITIONTABLE_H
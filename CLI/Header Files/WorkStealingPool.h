@@ -0,0 +1,86 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Declares WorkStealingPool, a fixed set of worker threads that split a
+ *        range of work into chunks and balance it by stealing from each other.
+ */
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Persistent worker threads running parallel-for jobs with work stealing.
+ *
+ * Each job's chunks are dealt out as one contiguous block per worker. A worker
+ * takes chunks from the front of its own block; when it runs dry it steals the
+ * back half of another worker's remaining block. Queues are only touched on
+ * chunk boundaries, so with reasonably sized chunks the workers almost never
+ * contend and throughput scales with the number of cores.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Body of a parallel-for: processes items [begin, end) on worker `worker`.
+     */
+    using RangeBody = std::function<void(std::uint64_t begin, std::uint64_t end, int worker)>;
+
+    /**
+     * @brief Starts the worker threads.
+     * @param threads Number of workers (values below 1 use the hardware concurrency)
+     */
+    explicit WorkStealingPool(int threads);
+
+    /** @brief Stops and joins every worker. */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /** @return Number of worker threads. */
+    int size() const { return static_cast<int>(workers.size()); }
+
+    /**
+     * @brief Run `body` over items [0, count) in chunks of `grain` and wait for completion.
+     *        Worker indices passed to `body` are in [0, size()), so callers can keep
+     *        per-worker state without synchronisation.
+     * @param count Number of items
+     * @param grain Items per chunk (at least 1)
+     * @param body Function processing one chunk
+     */
+    void parallelFor(std::uint64_t count, std::uint64_t grain, const RangeBody& body);
+
+private:
+    /** @brief A worker's remaining chunk indices [head, tail). */
+    struct alignas(64) ChunkQueue {
+        std::mutex lock;
+        std::uint64_t head = 0;
+        std::uint64_t tail = 0;
+    };
+
+    void workerLoop(int worker);
+    bool popLocal(int worker, std::uint64_t& chunk);
+    bool steal(int worker, std::uint64_t& chunk);
+
+    std::vector<std::thread> workers; /**< worker threads */
+    std::vector<std::unique_ptr<ChunkQueue>> queues; /**< one chunk queue per worker */
+
+    std::mutex jobLock; /**< guards the job fields below */
+    std::condition_variable jobReady; /**< signalled when a job is posted or on shutdown */
+    std::condition_variable jobDone; /**< signalled when the last worker finishes a job */
+    std::uint64_t generation = 0; /**< incremented for every posted job */
+    int busyWorkers = 0; /**< workers still running the current job */
+    bool stopping = false; /**< set by the destructor */
+
+    const RangeBody* body = nullptr; /**< current job body */
+    std::uint64_t itemCount = 0; /**< items in the current job */
+    std::uint64_t itemGrain = 1; /**< items per chunk in the current job */
+};
+
+#endif //WORKSTEALINGPOOL_H
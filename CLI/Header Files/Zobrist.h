@@ -0,0 +1,94 @@
+/**
+ * @file Zobrist.h
+ * @brief Zobrist keys for Canoga positions: 64-bit hashes that cover and
+ *        uncover moves update with a few XORs.
+ */
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+#include <array>
+#include <bit>
+#include <cstdint>
+#include "Board.h"
+
+/**
+ * @namespace zobrist
+ * @brief Position hashing shared by GameState, the searches and the transposition table.
+ *
+ * A position's hash is the XOR of one fixed random key per covered square of
+ * each seat, one for seat 1 being on move, one for the protected advantage
+ * square (if any) and one for the board size. Covering or uncovering squares
+ * flips exactly their keys, so a move updates the hash in O(squares changed).
+ * The keys are generated at compile time with SplitMix64, so hashes are the
+ * same in every build and every process.
+ */
+namespace zobrist {
+
+    /** @brief One SplitMix64 step; advances the state and returns the next key. */
+    constexpr std::uint64_t splitMix64(std::uint64_t& state) {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /** @brief All keys of the scheme. */
+    struct Keys {
+        std::array<std::array<std::uint64_t, Board::MAX_SIZE + 1>, 2> square{}; /**< [seat][square] covered */
+        std::array<std::uint64_t, Board::MAX_SIZE + 1> protectedSquare{}; /**< [square] protected; [0] is 0 */
+        std::array<std::uint64_t, Board::MAX_SIZE + 1> boardSize{}; /**< [size] */
+        std::uint64_t seatOneToMove = 0; /**< seat 1 is on move */
+    };
+
+    /** @brief Generate the keys. */
+    constexpr Keys makeKeys() {
+        Keys keys;
+        std::uint64_t state = 0x43414E4F47415A42ull;
+        for (auto& seat : keys.square) {
+            for (std::size_t i = 1; i < seat.size(); ++i) seat[i] = splitMix64(state);
+        }
+        for (std::size_t i = 1; i < keys.protectedSquare.size(); ++i) keys.protectedSquare[i] = splitMix64(state);
+        for (std::size_t i = 1; i < keys.boardSize.size(); ++i) keys.boardSize[i] = splitMix64(state);
+        keys.seatOneToMove = splitMix64(state);
+        return keys;
+    }
+
+    inline constexpr Keys KEYS = makeKeys(); /**< the keys every hash is built from */
+
+    /**
+     * @brief XOR of the keys of a seat's squares.
+     * @param seat 0 or 1
+     * @param squares Mask of squares (bit i == square i)
+     * @return Combined key; a move XORs in the keys of the squares it changed
+     */
+    constexpr std::uint64_t squaresKey(const int seat, std::uint32_t squares) {
+        std::uint64_t key = 0;
+        for (; squares != 0; squares &= squares - 1) key ^= KEYS.square[seat][std::countr_zero(squares)];
+        return key;
+    }
+
+    /**
+     * @brief Key for the side to move and its protection.
+     * @param mover Seat on move
+     * @param protectedSquare Opponent square the mover may not uncover (0 for none)
+     */
+    constexpr std::uint64_t turnKey(const int mover, const int protectedSquare) {
+        return (mover == 1 ? KEYS.seatOneToMove : 0) ^ KEYS.protectedSquare[protectedSquare];
+    }
+
+    /**
+     * @brief Hash of a whole position.
+     * @param boardSize Squares per board
+     * @param seat0 Covered squares of seat 0
+     * @param seat1 Covered squares of seat 1
+     * @param mover Seat on move
+     * @param protectedSquare Opponent square the mover may not uncover (0 for none)
+     */
+    constexpr std::uint64_t hashOf(const int boardSize, const std::uint32_t seat0, const std::uint32_t seat1,
+                                   const int mover, const int protectedSquare) {
+        return KEYS.boardSize[boardSize] ^ squaresKey(0, seat0) ^ squaresKey(1, seat1) ^ turnKey(mover, protectedSquare);
+    }
+
+} // namespace zobrist
+
+#endif //ZOBRIST_H
@@ -5,17 +5,33 @@
  */
 
 #include "../Header Files/Board.h"
+#include "../Header Files/MoveTable.h"
+#include <array>
+#include <bit>
+#include <bitset>
 #include <set>
 using namespace std;
 
+/**
+ * @brief Constructs a board with n uncovered squares and precomputes its masks.
+ * @param n Number of squares on the board (clamped to 0..MAX_SIZE)
+ */
+Board::Board(const int n)
+    : coveredMask(0), size(n < 0 ? 0 : (n > MAX_SIZE ? MAX_SIZE : n)), coveredSum(0) {
+    fullMask   = ((std::uint32_t{1} << size) - 1) << 1;
+    oneDieMask = fullMask & ~((std::uint32_t{1} << ONE_DIE_RULE_START) - 1);
+    totalSum   = size * (size + 1) / 2;
+}
+
 /**
  * @brief Marks a specific square as covered if it is a valid uncovered square.
  * @param square 1-based index of the square to cover
  * @return true if the square was successfully covered; false otherwise
  */
 bool Board::coverSquare(const int square) {
-    if (square >= 1 && square <= size && !squares[square - 1]) {
-        squares[square - 1] = true;
+    if (square >= 1 && square <= size && !(coveredMask & bitOf(square))) {
+        coveredMask |= bitOf(square);
+        coveredSum  += square;
         return true;
     }
     return false;
@@ -27,13 +43,32 @@ bool Board::coverSquare(const int square) {
  * @return true if the square was successfully uncovered; false otherwise
  */
 bool Board::uncoverSquare(const int square) {
-    if (square >= 1 && square <= size && squares[square - 1]) {
-        squares[square - 1] = false;
+    if (square >= 1 && square <= size && (coveredMask & bitOf(square))) {
+        coveredMask &= ~bitOf(square);
+        coveredSum  -= square;
         return true;
     }
     return false;
 }
 
+/**
+ * @brief Applies a whole combination with two mask operations; only the covered
+ *        sum needs a pass over the squares that actually change.
+ * @param combo Combination mask
+ * @param covering true to cover, false to uncover
+ * @return The board state before the move
+ */
+Board::Undo Board::applyMove(const uint32_t combo, const bool covering) {
+    const Undo undo{coveredMask, coveredSum};
+    uint32_t changed = covering ? (combo & fullMask & ~coveredMask) : (combo & coveredMask);
+    coveredMask ^= changed;
+
+    int changedSum = 0;
+    for (; changed != 0; changed &= changed - 1) changedSum += countr_zero(changed);
+    coveredSum += covering ? changedSum : -changedSum;
+    return undo;
+}
+
 /**
  * @brief Checks whether a square is currently covered.
  * @param square 1-based index of the square to query
@@ -41,7 +76,7 @@ bool Board::uncoverSquare(const int square) {
  */
 bool Board::isSquareCovered(const int square) const {
     if (square >= 1 && square <= size) {
-        return squares[square - 1];
+        return (coveredMask & bitOf(square)) != 0;
     }
     return false;
 }
@@ -59,10 +94,7 @@ int Board::getSize() const {
  * @return true if all squares are covered
  */
 bool Board::allCovered() const {
-    for (const bool square : squares) {
-        if (!square) return false;
-    }
-    return true;
+    return coveredMask == fullMask;
 }
 
 /**
@@ -70,10 +102,7 @@ bool Board::allCovered() const {
  * @return true if all squares are uncovered
  */
 bool Board::allUncovered() const {
-    for (const bool square : squares) {
-        if (square) return false;
-    }
-    return true;
+    return coveredMask == 0;
 }
 
 /**
@@ -81,13 +110,7 @@ bool Board::allUncovered() const {
  * @return Sum of uncovered squares
  */
 int Board::getUncoveredSum() const {
-    int sum = 0;
-    for (int i = 1; i <= size; ++i) {
-        if (!isSquareCovered(i)) {
-            sum += i;
-        }
-    }
-    return sum;
+    return totalSum - coveredSum;
 }
 
 /**
@@ -95,49 +118,120 @@ int Board::getUncoveredSum() const {
  * @return Sum of covered squares
  */
 int Board::getCoveredSum() const {
-    int sum = 0;
-    for (int i = 1; i <= size; ++i) {
-        if (isSquareCovered(i)) {
-            sum += i;
+    return coveredSum;
+}
+
+namespace {
+    /**
+     * @brief Dice sums reachable from each set of squares 1..MAX_SUM, indexed by mask >> 1:
+     *        bit s is set when some subset adds up to s. Each entry is the entry without
+     *        its highest square, shift-ORed by that square, so the table is built in one pass.
+     */
+    constexpr auto REACHABLE_SUMS = [] {
+        array<uint16_t, size_t{1} << MoveTable::MAX_SUM> table{};
+        table[0] = 1;
+        for (uint32_t index = 1; index < table.size(); ++index) {
+            const int square = bit_width(index);
+            const uint16_t without = table[index & ~(uint32_t{1} << (square - 1))];
+            table[index] = static_cast<uint16_t>(without | (without << square));
+        }
+        return table;
+    }();
+
+    /**
+     * @brief Depth-first subset search used for sums outside the move table.
+     * @param available Mask of squares that may still be used
+     * @param from Smallest square index to consider next
+     * @param remaining Sum still to be reached
+     * @param chosen Mask of squares picked so far
+     * @param out Destination for completed combinations
+     */
+    void collectCombinations(const uint32_t available, const int from, const int remaining,
+                             const uint32_t chosen, set<set<int>>& out) {
+        for (int i = from; i <= remaining && i <= Board::MAX_SIZE; ++i) {
+            if (!(available & Board::bitOf(i))) continue;
+            if (i == remaining) {
+                out.insert(MoveTable::toSet(chosen | Board::bitOf(i)));
+            } else {
+                collectCombinations(available, i + 1, remaining - i, chosen | Board::bitOf(i), out);
+            }
         }
     }
-    return sum;
 }
 
 /**
- * @brief Recursively finds all subsets of squares that sum to the target value.
+ * @brief Finds all subsets of available squares that sum to the target value.
+ *        Dice sums come straight from the precomputed MoveTable filtered by the
+ *        available-squares mask; larger sums fall back to a subset search.
  * @param sum Target sum to achieve from available squares
  * @param forCovering If true, consider uncovered squares to cover; otherwise consider covered squares to uncover
  * @return A set containing combinations (as sets of indices) that sum to `sum`
  */
 set<set<int>> Board::findValidCombinations(const int sum, const bool forCovering) const {
     set<set<int>> combinations;
+    const uint32_t available = getAvailableMask(forCovering);
 
-    // Iterate through all squares to find potential candidates
-    for (int i = 1; i <= size; ++i) {
-        // Step 1: Check if the square is available for the requested action
-        if ((forCovering && !isSquareCovered(i)) || (!forCovering && isSquareCovered(i))) {
-
-            // Step 2: Base case - exact match found
-            if (i == sum) {
-                combinations.insert({i});
-            }
-            // Step 3: Recursive case - look for remaining sum
-            else if (i < sum) {
-                for (set<set<int>> subCombinations = findValidCombinations(sum - i, forCovering); const set<int>& subCombination : subCombinations) {
-                    // Ensure unique numbers (no repeats in combination)
-                    if (!subCombination.contains(i)) {
-                        set<int> combination = subCombination;
-                        combination.insert(i);
-                        combinations.insert(combination);
-                    }
-                }
+    if (sum <= MoveTable::MAX_SUM) {
+        const MoveTable& moveTable = MoveTable::instance();
+        const uint32_t* combos = moveTable.combos(sum);
+        for (int i = 0, n = moveTable.count(sum); i < n; ++i) {
+            if ((combos[i] & ~available) == 0) {
+                combinations.insert(combinations.end(), MoveTable::toSet(combos[i]));
             }
         }
+        return combinations;
     }
+
+    collectCombinations(available, 1, sum, 0, combinations);
     return combinations;
 }
 
+/**
+ * @brief Filters the MoveTable entries for `sum` into an inline MoveList.
+ * @param sum Dice sum (1..MoveTable::MAX_SUM)
+ * @param forCovering If true, consider uncovered squares to cover; otherwise consider covered squares to uncover
+ * @return Legal combination masks for the sum
+ */
+MoveList Board::findValidMoves(const int sum, const bool forCovering) const {
+    MoveList moves;
+    const uint32_t available = getAvailableMask(forCovering);
+    const MoveTable& moveTable = MoveTable::instance();
+    const uint32_t* combos = moveTable.combos(sum);
+    for (int i = 0, n = moveTable.count(sum); i < n; ++i) {
+        if ((combos[i] & ~available) == 0) moves.push(combos[i]);
+    }
+    return moves;
+}
+
+/**
+ * @brief Subset-sum reachability over the eligible squares: bit s of the bitset is
+ *        set when some subset adds up to s, and each square ORs in a copy shifted
+ *        by its value. Dice sums read the precomputed bitset for their squares;
+ *        larger sums build it on the fly. Squares above `sum` are ignored.
+ * @param sum Target sum
+ * @param forCovering If true, consider uncovered squares to cover; otherwise consider covered squares to uncover
+ * @param excludedMask Squares that may not be used
+ * @return true when `sum` is reachable
+ */
+bool Board::hasValidMove(const int sum, const bool forCovering, const uint32_t excludedMask) const {
+    if (sum < 1) return false;
+    uint32_t squares = getAvailableMask(forCovering) & ~excludedMask;
+
+    if (sum <= MoveTable::MAX_SUM) {
+        squares &= bitOf(sum + 1) - 1;
+        return (REACHABLE_SUMS[squares >> 1] >> sum) & 1;
+    }
+
+    constexpr int MAX_TOTAL = MAX_SIZE * (MAX_SIZE + 1) / 2;
+    if (sum > MAX_TOTAL) return false;
+    bitset<MAX_TOTAL + 1> reach(1);
+    while (squares) {
+        reach |= reach << countr_zero(squares);
+        squares &= squares - 1;
+    }
+    return reach[sum];
+}
+
 /**
  * @brief Validates whether the provided combination is legal for the requested action.
  * @param combination Set of 1-based square indices
@@ -158,8 +252,5 @@ bool Board::isValidCombination(const set<int>& combination, bool forCovering) co
  * @return true when the one-die rule applies (squares starting from ONE_DIE_RULE_START are covered)
  */
 bool Board::canThrowOneDie() const {
-    for (int i = Board::ONE_DIE_RULE_START; i <= size; ++i) {
-        if (!isSquareCovered(i)) return false;
-    }
-    return true;
+    return (coveredMask & oneDieMask) == oneDieMask;
 }
\ No newline at end of file
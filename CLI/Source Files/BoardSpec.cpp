@@ -0,0 +1,54 @@
+/**
+ * @file BoardSpec.cpp
+ * @brief Implementation of RuntimeBoardSpec, the tables of a board size chosen at run time.
+ */
+
+#include "../Header Files/BoardSpec.h"
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+
+using namespace std;
+
+/**
+ * @brief Build the masks, move lists and (for small boards) the square-sum table.
+ * @param boardSize Squares on the board
+ */
+RuntimeBoardSpec::RuntimeBoardSpec(const int boardSize)
+    : boardSize(clamp(boardSize, 0, Board::MAX_SIZE)),
+      full(((uint32_t{1} << this->boardSize) - 1) << 1),
+      oneDie(full & ~((uint32_t{1} << Board::ONE_DIE_RULE_START) - 1)),
+      sumCombos(makeSumCombos(full)) {
+    if (this->boardSize > MAX_TABLED_BOARD_SIZE) return;
+    squareSums.resize(size_t{1} << this->boardSize);
+    for (uint32_t bits = 1; bits < squareSums.size(); ++bits) {
+        const int square = bit_width(bits);
+        squareSums[bits] = static_cast<uint8_t>(squareSums[bits & ~(uint32_t{1} << (square - 1))] + square);
+    }
+}
+
+/**
+ * @brief Sum of a mask's squares, from the table when the board has one.
+ * @param mask Squares (bit i == square i)
+ * @return Their sum
+ */
+int RuntimeBoardSpec::squareSum(uint32_t mask) const {
+    if (!squareSums.empty()) return squareSums[mask >> 1];
+    int total = 0;
+    for (; mask != 0; mask &= mask - 1) total += countr_zero(mask);
+    return total;
+}
+
+/**
+ * @brief Returns the shared spec of a size; construction happens once per size and is thread-safe.
+ * @param boardSize Squares on the board
+ * @return Reference to the spec
+ */
+const RuntimeBoardSpec& RuntimeBoardSpec::forSize(const int boardSize) {
+    static unique_ptr<RuntimeBoardSpec> specs[Board::MAX_SIZE + 1];
+    static once_flag built[Board::MAX_SIZE + 1];
+    const int size = clamp(boardSize, 0, Board::MAX_SIZE);
+    call_once(built[size], [size] { specs[size] = make_unique<RuntimeBoardSpec>(size); });
+    return *specs[size];
+}
@@ -8,67 +8,27 @@
 #include "../Header Files/Computer.h"
 #include <iostream>
 #include <string>
-#include "../Header Files/Tournament.h"
+#include "../Header Files/Strategy.h"
+#include "../Header Files/GameContext.h"
+#include "../Header Files/DiceTable.h"
+#include "../Header Files/GameState.h"
+#include "../Header Files/PolicyTable.h"
+#include "../Header Files/RolloutSearch.h"
 #include "../Header Files/TextUI.h"
-#include <random>
 #include <limits>
-#include <set>
+#include <bit>
+#include <cstdint>
 #include <utility>
 
 using namespace std;
 using namespace ui;
+using namespace strategy;
 
 // =====================================================================
-// Shared Strategy Engine (internal helpers)
+// Computer presentation helpers (strategy engine lives in Strategy.cpp)
 // =====================================================================
 namespace {
 
-    /**
-     * @brief Result of strategy computation describing action and chosen combo.
-     */
-    struct StrategyResult {
-        enum class Action { None, Cover, Uncover };
-        Action action;
-        std::set<int> combo;
-    };
-
-    /** @brief Compute sum of values in a set. */
-    int sumOf(const std::set<int>& s) {
-        int total = 0;
-        for (int v : s) total += v;
-        return total;
-    }
-
-    /** @brief Return the highest element in the set or 0 if empty. */
-    int highestSquareOf(const std::set<int>& s) {
-        int hi = 0;
-        for (int v : s) if (v > hi) hi = v;
-        return hi;
-    }
-
-    /**
-     * @brief Choose the best combination by preferring larger count, then higher max value.
-     * @param combos Candidate combinations
-     * @return The chosen combination
-     */
-    std::set<int> chooseBestComboJava(const std::set<std::set<int>>& combos) {
-        std::set<int> best;
-        int bestCount = -1;
-        int bestHigh  = -1;
-
-        for (const auto& c : combos) {
-            int cnt  = static_cast<int>(c.size());
-            int high = highestSquareOf(c);
-
-            if (cnt > bestCount || (cnt == bestCount && high > bestHigh)) {
-                best      = c;
-                bestCount = cnt;
-                bestHigh  = high;
-            }
-        }
-        return best;
-    }
-
     /** @brief Read 'y'/'n' input from stdin; forces lowercase. */
     char readYN_input() {
         char c;
@@ -99,148 +59,51 @@ namespace {
         }
     }
 
-    /** @brief Highest uncovered square on a board or 0 if none. */
-    int highestUncoveredFunc(const Board& b) {
-        for (int v = b.getSize(); v >= 1; --v)
-            if (!b.isSquareCovered(v)) return v;
-        return 0;
-    }
-
-    /** @brief Count of uncovered squares on a board. */
-    int remainingCountFunc(const Board& b) {
-        int c = 0;
-        for (int v = 1; v <= b.getSize(); ++v)
-            if (!b.isSquareCovered(v)) ++c;
-        return c;
+    /** @brief Print the squares of a combination mask in ascending order. */
+    void printSquares(std::uint32_t combo) {
+        for (; combo != 0; combo &= combo - 1) std::cout << std::countr_zero(combo) << " ";
     }
 
     /** @brief Print candidate combinations for display. */
-    void printCombosFunc(const std::set<std::set<int>>& combos) {
+    void printCombosFunc(const MoveList& combos) {
         int i = 1;
-        for (const auto& c : combos) {
+        for (const std::uint32_t c : combos) {
             std::cout << "  [" << i++ << "] ";
-            for (int v : c) std::cout << v << " ";
+            printSquares(c);
             std::cout << "\n";
         }
     }
 
     /** @brief Apply cover operation and print values as they are covered. */
-    void applyCover(Board& b, const std::set<int>& combo) {
-        for (int v : combo) {
+    void applyCover(Board& b, std::uint32_t combo) {
+        for (; combo != 0; combo &= combo - 1) {
+            const int v = std::countr_zero(combo);
             std::cout << v << " ";
             b.coverSquare(v);
         }
     }
 
+    /** @brief Record the Computer's move in the game's journal. */
+    void journalMove(const GameContext& context, const StrategyResult& move) {
+        const bool covering = move.action == StrategyResult::Action::Cover;
+        context.record(JournalEvent::Move, GameContext::Side::Computer, 0, move.combo, covering ? JOURNAL_COVER : 0);
+    }
+
     /** @brief Apply uncover operation and print values as they are uncovered. */
-    void applyUncover(Board& hb, const std::set<int>& combo) {
-        for (int v : combo) {
+    void applyUncover(Board& hb, std::uint32_t combo) {
+        for (; combo != 0; combo &= combo - 1) {
+            const int v = std::countr_zero(combo);
             std::cout << v << " ";
             hb.uncoverSquare(v);
         }
     }
 
-    // -----------------------------------------------------------------
-    // computeBestMove - Java-like strategy
-    // -----------------------------------------------------------------
-    StrategyResult computeBestMove(int sum,
-                                   const Board& myBoard,
-                                   const Board& oppBoard,
-                                   bool oppProtected)
-    {
-        StrategyResult res{StrategyResult::Action::None, {}};
-
-        std::set<std::set<int>> coverCombos   = myBoard.findValidCombinations(sum, /*forCovering=*/true);
-        std::set<std::set<int>> uncoverCombos = oppBoard.findValidCombinations(sum, /*forCovering=*/false);
-
-        // Filter out combos that hit the protected advantage square on the opponent
-        if (oppProtected) {
-            int adv = Tournament::getAdvantageSquare();
-            for (auto it = uncoverCombos.begin(); it != uncoverCombos.end(); ) {
-                if (it->contains(adv)) it = uncoverCombos.erase(it);
-                else ++it;
-            }
-        }
-
-        // No legal moves at all
-        if (coverCombos.empty() && uncoverCombos.empty()) {
-            return res;
-        }
-
-        // Java Step 1: winning cover by "count == myUncoveredCount"
-        int myUncoveredCount = 0;
-        for (int i = 1; i <= myBoard.getSize(); i++) {
-            if (!myBoard.isSquareCovered(i)) myUncoveredCount++;
-        }
-        for (const auto& combo : coverCombos) {
-            if (static_cast<int>(combo.size()) == myUncoveredCount) {
-                res.action = StrategyResult::Action::Cover;
-                res.combo  = combo; // closest to "first match" behavior
-                return res;
-            }
-        }
-
-        // Java Step 2: winning uncover by "count == oppCoveredCount"
-        int oppCoveredCount = 0;
-        for (int i = 1; i <= oppBoard.getSize(); i++) {
-            if (oppBoard.isSquareCovered(i)) oppCoveredCount++;
-        }
-        for (const auto& combo : uncoverCombos) {
-            if (static_cast<int>(combo.size()) == oppCoveredCount) {
-                res.action = StrategyResult::Action::Uncover;
-                res.combo  = combo;
-                return res;
-            }
-        }
-
-        // Java Step 3: prefer cover if available
-        const std::set<std::set<int>>* candidates = nullptr;
-        StrategyResult::Action chosenAction = StrategyResult::Action::None;
-
-        if (!coverCombos.empty()) {
-            candidates = &coverCombos;
-            chosenAction = StrategyResult::Action::Cover;
-        } else {
-            candidates = &uncoverCombos;
-            chosenAction = StrategyResult::Action::Uncover;
-        }
-
-        if (!candidates || candidates->empty()) {
-            return res;
-        }
-
-        // Java Step 4: best candidate by (count, then highestSquare)
-        res.action = chosenAction;
-        res.combo  = chooseBestComboJava(*candidates);
-        return res;
-    }
-
-    /**
-     * @brief Check whether applying the candidate combo would immediately win the round.
-     * @param res Strategy result containing action and combo
-     * @param myBoard Board of the acting player (simulated)
-     * @param oppBoard Board of the opponent (simulated)
-     * @return true if the combo results in an immediate win
-     */
-    inline bool isComboWinning(const StrategyResult& res, const Board& myBoard, const Board& oppBoard) {
-        if (res.action == StrategyResult::Action::Cover) {
-            Board sim = myBoard;
-            for (int v : res.combo) sim.coverSquare(v);
-            return sim.allCovered();
-        } else if (res.action == StrategyResult::Action::Uncover) {
-            Board simOpp = oppBoard;
-            for (int v : res.combo) simOpp.uncoverSquare(v);
-            return simOpp.allUncovered();
-        }
-        return false;
-    }
-
     /**
      * @brief Print a neat, human-readable explanation for the chosen StrategyResult.
      * This consolidates the small inline explanation blocks so every computer move
      * has a consistent, easy-to-read explanation for the user.
      */
-    void printComputerExplanation(const StrategyResult& best, bool isWinning, const Board& myBoard, const Board& oppBoard, bool oppProtected) {
+    void printComputerExplanation(const StrategyResult& best, bool isWinning, const Board& myBoard, const Board& oppBoard, bool oppProtected, const std::string& engineWhy) {
         using std::cout;
         section("Computer Explanation");
 
@@ -250,11 +113,11 @@ namespace {
         else if (best.action == StrategyResult::Action::Uncover) cout << "Action: UNCOVER";
         else cout << "Action: NONE";
         cout << c(RESET) << ": ";
-        if (!best.combo.empty()) {
+        if (best.combo != 0) {
             bool first = true;
-            for (int v : best.combo) {
+            for (std::uint32_t rest = best.combo; rest != 0; rest &= rest - 1) {
                 if (!first) cout << ", ";
-                cout << v;
+                cout << std::countr_zero(rest);
                 first = false;
             }
         } else {
@@ -266,20 +129,22 @@ namespace {
         if (isWinning) {
             cout << c(YELLOW) << "Why: This move immediately wins the round." << c(RESET) << "\n";
         } else {
-            int chosenCount = static_cast<int>(best.combo.size());
+            int chosenCount = countOf(best.combo);
             int chosenSum = sumOf(best.combo);
 
             if (best.action == StrategyResult::Action::Cover) {
                 cout << "Why: Chosen to advance the computer's position by covering " << chosenCount
                      << " square" << (chosenCount==1?"":"s") << " (total value " << chosenSum << ")" << ".\n";
-                cout << "      Heuristic: prefers combinations with more squares, then higher highest-square.\n";
+                if (!engineWhy.empty()) cout << "      " << engineWhy << "\n";
+                else cout << "      Heuristic: prefers combinations with more squares, then higher highest-square.\n";
             } else if (best.action == StrategyResult::Action::Uncover) {
                 cout << "Why: Chosen to hinder the opponent by uncovering " << chosenCount
                      << " square" << (chosenCount==1?"":"s") << " (total value " << chosenSum << ").\n";
                 if (oppProtected) {
                     cout << "      Note: The opponent's advantage square is protected, so the AI avoided combinations that would touch it.\n";
                 }
-                cout << "      Heuristic: prefers combinations that reduce opponent coverage and prefers larger combinations / higher values.\n";
+                if (!engineWhy.empty()) cout << "      " << engineWhy << "\n";
+                else cout << "      Heuristic: prefers combinations that reduce opponent coverage and prefers larger combinations / higher values.\n";
             } else {
                 cout << "Why: No legal move available for this roll. The computer passes.\n";
             }
@@ -288,6 +153,32 @@ namespace {
         hr();
     }
 
+    /**
+     * @brief Choose a move with the rollout search when the game uses one, else from
+     *        the solved policy table when one is mapped for this board size, otherwise
+     *        with the heuristic strategy engine.
+     * @param why Receives a one-line reason for a search or table move (empty for the heuristic)
+     */
+    StrategyResult chooseMove(const GameContext& context, const PolicyTable* policy, const int sum,
+                              const Board& mover, const Board& opponent, const int protectedSquare,
+                              std::string* why = nullptr) {
+        if (why) why->clear();
+        if (const RolloutSearch* rollout = context.getRolloutSearch()) {
+            const RolloutResult result = rollout->bestMove(GameState(mover, opponent, 0, protectedSquare), sum);
+            if (why && result.playouts > 0) {
+                *why = "Rollouts: won " + std::to_string(static_cast<int>(100.0 * result.winRate + 0.5))
+                     + "% of its playouts, the best of " + std::to_string(result.candidates)
+                     + " moves (" + std::to_string(result.playouts) + " playouts in total).";
+            }
+            return result.move;
+        }
+        if (policy) {
+            if (why) *why = "Policy: the solved table rates this the move with the best win chance.";
+            return policy->bestMove(mover.getCoveredMask(), opponent.getCoveredMask(), sum, protectedSquare);
+        }
+        return computeBestMove(sum, mover, opponent, protectedSquare);
+    }
+
 } // anonymous namespace
 
 // =====================================================================
@@ -297,8 +188,8 @@ namespace {
 /**
  * @brief Construct a Computer player bound to its board and the human board.
  */
-Computer::Computer(Board& b, Board& humanBoard)
-    : Player(b, false),
+Computer::Computer(Board& b, Board& humanBoard, GameContext& context)
+    : Player(b, false, context),
       boardView(b, "Computer"),
       humanBoardView(humanBoard, "Human"),
       humanBoard(humanBoard) {}
@@ -314,6 +205,9 @@ bool Computer::takeTurn() {
     // Show the same colored section header as the human turn (once per turn)
     section("Computer Turn");
 
+    // Solved table for this board size, if one was generated with canoga_solve
+    const PolicyTable* policy = PolicyTable::forBoardSize(board.getSize());
+
     // The computer should keep taking rolls until it has no legal moves
     // (same behavior as the human). Loop each roll/decision cycle here.
     while (true) {
@@ -341,34 +235,32 @@ bool Computer::takeTurn() {
               const int d1 = readDie_input("Enter die 1 (1-6): ");
               const int d2 = (diceCount==2) ? readDie_input("Enter die 2 (1-6): ") : 0;
               sum = d1 + d2;
+              context.record(JournalEvent::DiceCount, GameContext::Side::Computer, diceCount);
+              context.record(JournalEvent::Roll, GameContext::Side::Computer, sum, 0, JOURNAL_MANUAL);
               cout << "Computer (manual) rolled: " << d1
                   << ((diceCount==2) ? " + " : " = ")
                   << ((diceCount==2) ? std::to_string(d2) + " = " : "")
                   << sum << "\n";
 
-             auto coverCombos   = board.findValidCombinations(sum, /*forCovering=*/true);
-             auto uncoverCombos = humanBoard.findValidCombinations(sum, /*forCovering=*/false);
-
              // Respect advantage protection for HUMAN (opponent)
-             if (Tournament::getAdvantageApplied() && Tournament::isHumanAdvantageProtected()) {
-                 int adv = Tournament::getAdvantageSquare();
-                 for (auto it = uncoverCombos.begin(); it != uncoverCombos.end(); ) {
-                     if (it->contains(adv)) it = uncoverCombos.erase(it);
-                     else ++it;
-                 }
-             }
+             const std::uint32_t guarded =
+                 (context.getAdvantageApplied() && context.isHumanAdvantageProtected())
+                     ? Board::bitOf(context.getAdvantageSquare()) : 0;
 
-            if (coverCombos.empty() && uncoverCombos.empty()) {
+            if (!board.hasValidMove(sum, /*forCovering=*/true) &&
+                !humanBoard.hasValidMove(sum, /*forCovering=*/false, guarded)) {
                 cout << "Computer has no legal moves for this roll. Its turn ends.\n";
                 return true;
             }
 
             // Java-like strategy engine
             bool oppProtected =
-                Tournament::getAdvantageApplied() &&
-                Tournament::isHumanAdvantageProtected();
+                context.getAdvantageApplied() &&
+                context.isHumanAdvantageProtected();
 
-            StrategyResult best = computeBestMove(sum, board, humanBoard, oppProtected);
+            std::string engineWhy;
+            StrategyResult best = chooseMove(context, policy, sum, board, humanBoard,
+                                             oppProtected ? context.getAdvantageSquare() : 0, &engineWhy);
 
             if (best.action == StrategyResult::Action::None) {
                 cout << "Computer has no legal moves for this roll. Its turn ends.\n";
@@ -379,10 +271,11 @@ bool Computer::takeTurn() {
             bool isWinning = isComboWinning(best, board, humanBoard);
 
             // Print a concise, formatted explanation for the player
-            printComputerExplanation(best, isWinning, board, humanBoard, oppProtected);
+            printComputerExplanation(best, isWinning, board, humanBoard, oppProtected, engineWhy);
 
             if (best.action == StrategyResult::Action::Cover) applyCover(board, best.combo);
             else applyUncover(humanBoard, best.combo);
+            journalMove(context, best);
 
             if (isWinning) {
                 cout << c(YELLOW) << "Note: This move wins the round." << c(RESET) << "\n";
@@ -395,29 +288,37 @@ bool Computer::takeTurn() {
          else {
              const bool oneDieAllowed = board.canThrowOneDie();
 
-             int diceCount;
-             if (oneDieAllowed &&
-                 (highestUncoveredFunc(board) <= 6 || remainingCountFunc(board) <= 3))
-              {
-                  diceCount = 1;
-              } else {
-                  diceCount = 2;
-              }
+             const int diceCount = (policy && oneDieAllowed)
+                 ? policy->diceCount(board.getCoveredMask(), humanBoard.getCoveredMask())
+                 : chooseDiceCount(board);
 
-             static thread_local std::mt19937_64 rng(std::random_device{}());
-             std::uniform_int_distribution<int> dieDist(1,6);
-             const int d1 = dieDist(rng);
-             const int d2 = (diceCount==2) ? dieDist(rng) : 0;
+             DiceSource& dice = context.getDice();
+             const int d1 = dice.rollDie();
+             const int d2 = (diceCount==2) ? dice.rollDie() : 0;
              sum = d1 + d2;
+             context.record(JournalEvent::DiceCount, GameContext::Side::Computer, diceCount);
+             context.record(JournalEvent::Roll, GameContext::Side::Computer, sum);
 
              std::string diceWhy;
              if (!oneDieAllowed) {
                  diceWhy = "must use 2 dice (1-die not allowed until 7.."
                          + std::to_string(board.getSize())
                          + " are covered)";
+             } else if (policy) {
+                 diceWhy = std::string(diceCount == 1 ? "1 die" : "2 dice")
+                         + " because the solved policy table gives a better win chance";
+             } else if (const DiceTable::Entry* odds = DiceTable::instance().find(board.getSize(), board.getCoveredMask())) {
+                 const auto percentOf = [](const float chance) {
+                     return std::to_string(static_cast<int>(100.0f * chance + 0.5f)) + "%";
+                 };
+                 const int chosen = diceCount - 1, other = 2 - diceCount;
+                 diceWhy = std::string(diceCount == 1 ? "1 die" : "2 dice")
+                         + " leaves a cover " + percentOf(odds->moveChance[chosen])
+                         + " of the time (vs " + percentOf(odds->moveChance[other])
+                         + ") and is expected to finish the board sooner";
              } else if (diceCount == 1) {
-                 int hi  = highestUncoveredFunc(board);
-                 int rem = remainingCountFunc(board);
+                 int hi  = highestUncovered(board);
+                 int rem = remainingCount(board);
                  if (hi <= 6)
                      diceWhy = "1 die because highest remaining square <= 6 (aiming small)";
                  else if (rem <= 3)
@@ -437,10 +338,12 @@ bool Computer::takeTurn() {
                       << " " << c(DIM) << "(1-die allowed)" << c(RESET) << "\n";
 
              bool oppProtected =
-                 Tournament::getAdvantageApplied() &&
-                 Tournament::isHumanAdvantageProtected();
+                 context.getAdvantageApplied() &&
+                 context.isHumanAdvantageProtected();
 
-             StrategyResult best = computeBestMove(sum, board, humanBoard, oppProtected);
+             std::string engineWhy;
+             StrategyResult best = chooseMove(context, policy, sum, board, humanBoard,
+                                              oppProtected ? context.getAdvantageSquare() : 0, &engineWhy);
 
              if (best.action == StrategyResult::Action::None) {
                  cout << "Computer has no legal moves for this roll. Its turn ends.\n";
@@ -450,10 +353,11 @@ bool Computer::takeTurn() {
              bool isWinningA = isComboWinning(best, board, humanBoard);
 
              // Print a concise, formatted explanation for the player
-             printComputerExplanation(best, isWinningA, board, humanBoard, oppProtected);
+             printComputerExplanation(best, isWinningA, board, humanBoard, oppProtected, engineWhy);
 
              if (best.action == StrategyResult::Action::Cover) applyCover(board, best.combo);
              else applyUncover(humanBoard, best.combo);
+             journalMove(context, best);
 
              if (isWinningA) {
                  cout << c(YELLOW) << "Note: This move wins the round." << c(RESET) << "\n";
@@ -463,14 +367,14 @@ bool Computer::takeTurn() {
 
         // Show resulting boards after the move
         boardView.display(
-            Tournament::getAdvantageApplied() &&
-            Tournament::getAdvantageOwner() == Tournament::Side::Computer,
-            Tournament::getAdvantageSquare());
+            context.getAdvantageApplied() &&
+            context.getAdvantageOwner() == GameContext::Side::Computer,
+            context.getAdvantageSquare());
 
         humanBoardView.display(
-            Tournament::getAdvantageApplied() &&
-            Tournament::getAdvantageOwner() == Tournament::Side::Human,
-            Tournament::getAdvantageSquare());
+            context.getAdvantageApplied() &&
+            context.getAdvantageOwner() == GameContext::Side::Human,
+            context.getAdvantageSquare());
 
         std::cout << "\n";
 
@@ -494,11 +398,12 @@ bool Computer::takeTurn() {
  */
 bool Computer::shouldCover(const int sum) const {
     bool oppProtected =
-        Tournament::getAdvantageApplied() &&
-        Tournament::isHumanAdvantageProtected();
+        context.getAdvantageApplied() &&
+        context.isHumanAdvantageProtected();
 
     StrategyResult res =
-        computeBestMove(sum, board, humanBoard, oppProtected);
+        chooseMove(context, PolicyTable::forBoardSize(board.getSize()), sum, board, humanBoard,
+                   oppProtected ? context.getAdvantageSquare() : 0);
 
     bool result = (res.action == StrategyResult::Action::Cover);
     return result;
@@ -510,8 +415,7 @@ bool Computer::shouldCover(const int sum) const {
  * @param sum Dice sum
  */
 void Computer::coverSquares(const int sum) const {
-    const std::set<std::set<int>> validCombinations =
-        board.findValidCombinations(sum, true);
+    const MoveList validCombinations = board.findValidMoves(sum, true);
 
     if (validCombinations.empty()) {
         cout << "Computer has no valid moves to cover squares. Turn ends."
@@ -520,39 +424,36 @@ void Computer::coverSquares(const int sum) const {
     }
 
     // Try to win if possible
-    for (const auto &combination : validCombinations) {
-        Board simulated = board;
-        for (int v : combination) simulated.coverSquare(v);
-        if (simulated.allCovered()) {
+    for (const std::uint32_t combination : validCombinations) {
+        if ((board.getCoveredMask() | combination) == board.getFullMask()) {
             cout << "Computer chooses a WINNING cover: ";
-            for (int v : combination) cout << v << " ";
+            printSquares(combination);
             cout << "\n";
-            for (int v : combination) board.coverSquare(v);
+            applyCombo(board, combination, /*covering=*/true);
             return;
         }
     }
 
-    std::set<int> selectedCombination;
-    size_t maxSquares = 0;
-    int maxSum        = -1;
-    for (const std::set<int>& combination : validCombinations) {
-        int currentSum = 0;
-        for (int val : combination) currentSum += val;
-        if (combination.size() > maxSquares ||
-            (combination.size() == maxSquares && currentSum > maxSum))
+    std::uint32_t selectedCombination = 0;
+    int maxSquares = 0;
+    int maxSum     = -1;
+    for (const std::uint32_t combination : validCombinations) {
+        const int currentSum = sumOf(combination);
+        if (countOf(combination) > maxSquares ||
+            (countOf(combination) == maxSquares && currentSum > maxSum))
         {
             selectedCombination = combination;
-            maxSquares          = combination.size();
+            maxSquares          = countOf(combination);
             maxSum              = currentSum;
         }
     }
 
     cout << "Computer chooses to cover the following squares: ";
-    for (const int square : selectedCombination) cout << square << " ";
+    printSquares(selectedCombination);
     cout << "because covering more squares gives it a better chance of winning."
          << endl;
 
-    for (const int square : selectedCombination) board.coverSquare(square);
+    applyCombo(board, selectedCombination, /*covering=*/true);
 }
 
 /**
@@ -561,8 +462,7 @@ void Computer::coverSquares(const int sum) const {
  * @param sum Dice sum
  */
 void Computer::uncoverSquares(const int sum) const {
-    std::set<std::set<int>> validCombinations =
-        humanBoard.findValidCombinations(sum, false);
+    MoveList validCombinations = humanBoard.findValidMoves(sum, false);
 
     if (validCombinations.empty()) {
         cout << "Computer has no valid moves to uncover squares. Turn ends."
@@ -570,16 +470,10 @@ void Computer::uncoverSquares(const int sum) const {
         return;
     }
 
-    if (Tournament::getAdvantageApplied() &&
-        Tournament::isHumanAdvantageProtected())
+    if (context.getAdvantageApplied() &&
+        context.isHumanAdvantageProtected())
     {
-        int adv = Tournament::getAdvantageSquare();
-        for (auto it = validCombinations.begin();
-             it != validCombinations.end(); )
-        {
-            if (it->contains(adv)) it = validCombinations.erase(it);
-            else ++it;
-        }
+        validCombinations.removeTouching(context.getAdvantageSquare());
 
         if (validCombinations.empty()) {
             cout << "Computer has no valid moves to uncover squares. Turn ends."
@@ -589,40 +483,36 @@ void Computer::uncoverSquares(const int sum) const {
     }
 
     // Try to win if possible
-    for (const auto &combination : validCombinations) {
-        Board simulated = humanBoard;
-        for (int v : combination) simulated.uncoverSquare(v);
-        if (simulated.allUncovered()) {
+    for (const std::uint32_t combination : validCombinations) {
+        if ((humanBoard.getCoveredMask() & ~combination) == 0) {
             cout << "Computer chooses a WINNING uncover: ";
-            for (int v : combination) cout << v << " ";
+            printSquares(combination);
             cout << "\n";
-            for (int v : combination) humanBoard.uncoverSquare(v);
+            applyCombo(humanBoard, combination, /*covering=*/false);
             return;
         }
     }
 
-    std::set<int> selectedCombination;
-    size_t maxSquares = 0;
-    int maxSum        = -1;
-    for (const std::set<int>& combination : validCombinations) {
-        int currentSum = 0;
-        for (int val : combination) currentSum += val;
-        if (combination.size() > maxSquares ||
-            (combination.size() == maxSquares && currentSum > maxSum))
+    std::uint32_t selectedCombination = 0;
+    int maxSquares = 0;
+    int maxSum     = -1;
+    for (const std::uint32_t combination : validCombinations) {
+        const int currentSum = sumOf(combination);
+        if (countOf(combination) > maxSquares ||
+            (countOf(combination) == maxSquares && currentSum > maxSum))
         {
             selectedCombination = combination;
-            maxSquares          = combination.size();
+            maxSquares          = countOf(combination);
             maxSum              = currentSum;
         }
     }
 
     cout << "Computer chooses to uncover the following squares: ";
-    for (const int square : selectedCombination) cout << square << " ";
+    printSquares(selectedCombination);
     cout << "because uncovering more squares reduces your chances of winning."
          << endl;
 
-    for (const int square : selectedCombination)
-        humanBoard.uncoverSquare(square);
+    applyCombo(humanBoard, selectedCombination, /*covering=*/false);
 }
 
 /**
@@ -640,23 +530,17 @@ void Computer::provideHelp(const int diceSum,
     std::cout << "Dice sum: " << diceSum << "\n\n";
 
     // All legal options BEFORE recommendation
-    std::set<std::set<int>> coverCombos =
-        humanBoard.findValidCombinations(diceSum, /*forCovering=*/true);
-    std::set<std::set<int>> uncoverCombos =
-        computerBoard.findValidCombinations(diceSum, /*forCovering=*/false);
+    const MoveList coverCombos =
+        humanBoard.findValidMoves(diceSum, /*forCovering=*/true);
+    MoveList uncoverCombos =
+        computerBoard.findValidMoves(diceSum, /*forCovering=*/false);
 
     bool oppProtected =
-        Tournament::getAdvantageApplied() &&
-        Tournament::isComputerAdvantageProtected();
+        context.getAdvantageApplied() &&
+        context.isComputerAdvantageProtected();
 
     if (oppProtected) {
-        int adv = Tournament::getAdvantageSquare();
-        for (auto it = uncoverCombos.begin();
-             it != uncoverCombos.end(); )
-        {
-            if (it->contains(adv)) it = uncoverCombos.erase(it);
-            else ++it;
-        }
+        uncoverCombos.removeTouching(context.getAdvantageSquare());
     }
 
     section("Possible moves to COVER (your board)");
@@ -669,23 +553,23 @@ void Computer::provideHelp(const int diceSum,
 
     if (coverCombos.empty() && uncoverCombos.empty()) {
         std::cout << "\nNo legal moves available. You must pass this turn.\n";
-        if (Tournament::getAdvantageApplied()) {
+        if (context.getAdvantageApplied()) {
             std::cout << "\n" << c(YELLOW) << "Note:" << c(RESET)
-                      << " advantage square " << Tournament::getAdvantageSquare()
+                      << " advantage square " << context.getAdvantageSquare()
                       << " is protected for one turn.\n";
         }
         hr();
         return;
     }
 
-    // Use the SAME (java-like) strategy engine as the AI to compute the recommendation
-    StrategyResult best = computeBestMove(diceSum, humanBoard, computerBoard, oppProtected);
+    // Use the SAME engine as the AI (rollouts or solved table when available) to compute the recommendation
+    StrategyResult best = chooseMove(context, PolicyTable::forBoardSize(humanBoard.getSize()), diceSum,
+                                     humanBoard, computerBoard,
+                                     oppProtected ? context.getAdvantageSquare() : 0);
 
     // Compute simple metrics for the recommended move and alternatives
-    auto explainCombo = [](const std::set<int>& combo) {
-        int cnt = static_cast<int>(combo.size());
-        int s = 0; for (int v : combo) s += v;
-        return std::pair<int,int>(cnt, s);
+    auto explainCombo = [](const std::uint32_t combo) {
+        return std::pair<int,int>(countOf(combo), sumOf(combo));
     };
 
     if (best.action == StrategyResult::Action::None) {
@@ -701,7 +585,7 @@ void Computer::provideHelp(const int diceSum,
     } else {
         std::cout << "Uncover these opponent squares: ";
     }
-    for (int v : best.combo) std::cout << v << " ";
+    printSquares(best.combo);
     std::cout << "\n\n";
 
     // Provide a concise human-friendly 'why' (one or two sentences)
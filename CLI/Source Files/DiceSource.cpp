@@ -0,0 +1,74 @@
+/**
+ * @file DiceSource.cpp
+ * @brief Philox4x32-10 and the per-turn counter bookkeeping of DiceSource.
+ */
+
+#include "../Header Files/DiceSource.h"
+#include <random>
+
+using namespace std;
+
+namespace {
+    constexpr uint32_t PHILOX_M0 = 0xD2511F53u; /**< Round multiplier for words 0/1 */
+    constexpr uint32_t PHILOX_M1 = 0xCD9E8D57u; /**< Round multiplier for words 2/3 */
+    constexpr uint32_t PHILOX_W0 = 0x9E3779B9u; /**< Key schedule increment (golden ratio) */
+    constexpr uint32_t PHILOX_W1 = 0xBB67AE85u; /**< Key schedule increment (sqrt 3 - 1) */
+    constexpr int PHILOX_ROUNDS = 10;
+}
+
+/**
+ * @brief Construct a source positioned at turn 0 of a game.
+ * @param seed Run-wide key
+ * @param gameId Game index
+ */
+DiceSource::DiceSource(const uint64_t seed, const uint64_t gameId) : seed(seed), gameId(gameId) {}
+
+/**
+ * @brief Draw a seed from the operating system's entropy source.
+ * @return 64-bit seed
+ */
+uint64_t DiceSource::randomSeed() {
+    random_device device;
+    return (uint64_t{device()} << 32) ^ device();
+}
+
+/**
+ * @brief Ten Philox rounds over one counter.
+ * @param counter Counter words
+ * @param key Key words
+ * @return Output words
+ */
+array<uint32_t, 4> DiceSource::philox(array<uint32_t, 4> counter, array<uint32_t, 2> key) {
+    for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+        const uint64_t product0 = uint64_t{PHILOX_M0} * counter[0];
+        const uint64_t product1 = uint64_t{PHILOX_M1} * counter[2];
+        counter = {
+            static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+            static_cast<uint32_t>(product1),
+            static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+            static_cast<uint32_t>(product0),
+        };
+        key[0] += PHILOX_W0;
+        key[1] += PHILOX_W1;
+    }
+    return counter;
+}
+
+/**
+ * @brief Reposition at the first roll of a turn.
+ * @param turnIndex Turn to start
+ */
+void DiceSource::seek(const uint32_t turnIndex) {
+    turn = turnIndex;
+    blockIndex = 0;
+    next = block.size();
+}
+
+/**
+ * @brief Encrypt the next counter of the current turn into the output block.
+ */
+void DiceSource::refill() {
+    block = philox({blockIndex++, turn, static_cast<uint32_t>(gameId), static_cast<uint32_t>(gameId >> 32)},
+                   {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)});
+    next = 0;
+}
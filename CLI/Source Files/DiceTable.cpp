@@ -0,0 +1,64 @@
+/**
+ * @file DiceTable.cpp
+ * @brief Builds DiceTable by dynamic programming from the full board down.
+ */
+
+#include "../Header Files/DiceTable.h"
+#include <algorithm>
+#include <limits>
+#include "../Header Files/Board.h"
+#include "../Header Files/MoveTable.h"
+
+using namespace std;
+
+/**
+ * @brief Fill the entries of every board size.
+ */
+DiceTable::DiceTable() {
+    const MoveTable& moves = MoveTable::instance();
+    constexpr float NEVER = numeric_limits<float>::infinity();
+
+    for (int size = 1; size <= MAX_BOARD_SIZE; ++size) {
+        const uint32_t fullMask = ((uint32_t{1} << size) - 1) << 1;
+        const uint32_t oneDieMask = fullMask & ~((uint32_t{1} << Board::ONE_DIE_RULE_START) - 1);
+        vector<Entry>& table = tables[size];
+        table.resize(size_t{1} << size);
+
+        // Supersets have larger masks, so they are done before the masks that reach them.
+        for (uint32_t mask = fullMask;; mask -= 2) {
+            Entry& entry = table[mask >> 1];
+            const uint32_t open = fullMask & ~mask;
+            for (int dice = 1; dice <= 2; ++dice) {
+                double moveChance = 0.0, turnsAfter = 0.0;
+                for (int sum = dice; sum <= 6 * dice; ++sum) {
+                    const double chance = dice == 1 ? 1.0 / 6 : (6 - abs(sum - 7)) / 36.0;
+                    float best = NEVER;
+                    for (int i = 0; i < moves.count(sum); ++i) {
+                        const uint32_t combo = moves.combos(sum)[i];
+                        if ((combo & open) == combo) best = min(best, table[(mask | combo) >> 1].turns());
+                    }
+                    if (best == NEVER) continue;
+                    moveChance += chance;
+                    turnsAfter += chance * best;
+                }
+                const bool allowed = dice == 2 || (mask & oneDieMask) == oneDieMask;
+                const double failChance = 1.0 - moveChance;
+                entry.moveChance[dice - 1] = static_cast<float>(moveChance);
+                entry.expectedTurns[dice - 1] = (mask == fullMask) ? 0.0f
+                    : (!allowed || moveChance <= 0.0) ? NEVER
+                    : static_cast<float>((failChance + turnsAfter) / moveChance);
+            }
+            entry.diceCount = entry.expectedTurns[0] < entry.expectedTurns[1] ? 1 : 2;
+            if (mask == 0) break;
+        }
+    }
+}
+
+/**
+ * @brief Returns the shared table; construction happens once and is thread-safe.
+ * @return Reference to the table
+ */
+const DiceTable& DiceTable::instance() {
+    static const DiceTable diceTable;
+    return diceTable;
+}
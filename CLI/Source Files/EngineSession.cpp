@@ -0,0 +1,448 @@
+/**
+ * @file EngineSession.cpp
+ * @brief Implementation of EngineSession: parsing protocol commands, keeping
+ *        the round between them and formatting the engine's replies.
+ */
+
+#include "../Header Files/EngineSession.h"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include "../Header Files/GameState.h"
+#include "../Header Files/PolicyTable.h"
+#include "../Header Files/RolloutSearch.h"
+#include "../Header Files/Round.h"
+#include "../Header Files/Tournament.h"
+
+using namespace std;
+using namespace strategy;
+
+namespace {
+    using Side = GameContext::Side;
+
+    constexpr int MAX_TOKENS = 12; /**< longest command: position with both options */
+    constexpr const char* NO_ROUND = "no round in progress";
+    constexpr const char* NO_ROLL = "no roll is waiting for a move";
+
+    /** @brief Parse `human` or `computer`. */
+    bool parseSide(const string_view token, Side& side) {
+        if (token == "human")    side = Side::Human;
+        else if (token == "computer") side = Side::Computer;
+        else return false;
+        return true;
+    }
+
+    /** @return Protocol name of a side. */
+    const char* nameOf(const Side side) {
+        return side == Side::Human ? "human" : "computer";
+    }
+
+    /** @return The other side. */
+    Side opponentOf(const Side side) {
+        return side == Side::Human ? Side::Computer : Side::Human;
+    }
+
+    /** @brief Parse a whole token as a number in [low, high]. */
+    bool parseNumber(const string_view token, const int low, const int high, int& value) {
+        const auto [end, error] = from_chars(token.data(), token.data() + token.size(), value);
+        return error == errc() && end == token.data() + token.size() && value >= low && value <= high;
+    }
+
+    /** @brief Parse a square list (`1,2,9` or `-`) of a board of `size` squares into a mask. */
+    bool parseSquares(const string_view token, const int size, uint32_t& mask) {
+        mask = 0;
+        if (token == "-") return true;
+        size_t start = 0;
+        while (start <= token.size()) {
+            const size_t comma = min(token.find(',', start), token.size());
+            int square = 0;
+            if (!parseNumber(token.substr(start, comma - start), 1, size, square)) return false;
+            if (mask & Board::bitOf(square)) return false;
+            mask |= Board::bitOf(square);
+            start = comma + 1;
+        }
+        return true;
+    }
+
+    /** @brief Append a number. */
+    void appendNumber(string& out, const int value) {
+        char buffer[16];
+        out.append(buffer, to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+    }
+
+    /** @brief Append a square list in the form parseSquares() reads. */
+    void appendSquares(string& out, uint32_t mask) {
+        if (mask == 0) {
+            out += '-';
+            return;
+        }
+        for (bool first = true; mask; mask &= mask - 1, first = false) {
+            if (!first) out += ',';
+            appendNumber(out, countr_zero(mask));
+        }
+    }
+
+    /** @brief Append `cover SQUARES` or `uncover SQUARES`. */
+    void appendMove(string& out, const StrategyResult& move) {
+        out += move.action == StrategyResult::Action::Cover ? "cover " : "uncover ";
+        appendSquares(out, move.combo);
+    }
+}
+
+/**
+ * @brief Create a session with no round in progress.
+ * @param seed Dice seed
+ * @param gameId Dice stream of this session
+ * @param rollout Rollout search, or nullptr
+ */
+EngineSession::EngineSession(const uint64_t seed, const uint64_t gameId, const RolloutSearch* rollout)
+    : dice(seed, gameId), rollout(rollout) {}
+
+/**
+ * @brief Split a command line into tokens and dispatch it.
+ * @param line Command
+ * @param reply Receives the reply lines
+ * @return false after `quit`
+ */
+bool EngineSession::execute(const string_view line, string& reply) {
+    string_view tokens[MAX_TOKENS];
+    int count = 0;
+    for (size_t start = line.find_first_not_of(" \t\r"); start != string_view::npos;
+         start = line.find_first_not_of(" \t\r", start)) {
+        const size_t end = min(line.find_first_of(" \t\r", start), line.size());
+        if (count == MAX_TOKENS) {
+            reply += "error too many tokens\n";
+            return true;
+        }
+        tokens[count++] = line.substr(start, end - start);
+        start = end;
+    }
+    if (count == 0) return true;
+
+    const string_view command = tokens[0];
+    const char* error = nullptr;
+    if (command == "canoga") {
+        reply += "id name canoga\nprotocol 1\ncanogaok\n";
+    } else if (command == "isready") {
+        reply += "readyok\n";
+    } else if (command == "quit") {
+        reply += "bye\n";
+        return false;
+    } else if (command == "newround") {
+        error = newRound(tokens, count, reply);
+    } else if (command == "position") {
+        error = setPosition(tokens, count, reply);
+    } else if (command == "score") {
+        int human = 0, computer = 0;
+        if (count != 3 || !parseNumber(tokens[1], 0, INT32_MAX, human) || !parseNumber(tokens[2], 0, INT32_MAX, computer)) {
+            error = "usage: score HUMAN COMPUTER";
+        } else {
+            scores[0] = human;
+            scores[1] = computer;
+            reply += "ok\n";
+        }
+    } else if (command == "show") {
+        if (boards[0].getSize() == 0) {
+            error = NO_ROUND;
+        } else {
+            appendPosition(reply);
+            reply += "score ";
+            appendNumber(reply, scores[0]);
+            reply += ' ';
+            appendNumber(reply, scores[1]);
+            reply += '\n';
+            if (pendingRoll > 0) {
+                reply += "roll ";
+                appendNumber(reply, pendingRoll);
+                reply += '\n';
+            }
+        }
+    } else if (command == "dice") {
+        if (!inRound) {
+            error = NO_ROUND;
+        } else {
+            reply += "dice ";
+            appendNumber(reply, chooseDiceCount());
+            reply += '\n';
+        }
+    } else if (command == "roll") {
+        error = roll(tokens, count, reply);
+    } else if (command == "bestmove") {
+        if (pendingRoll == 0) error = NO_ROLL;
+        else appendBestMove(reply);
+    } else if (command == "analyse" || command == "analyze") {
+        error = analyse(reply);
+    } else if (command == "applymove") {
+        error = applyMove(tokens, count, reply);
+    } else {
+        error = "unknown command";
+    }
+
+    if (error) {
+        reply += "error ";
+        reply += error;
+        reply += '\n';
+    }
+    return true;
+}
+
+/**
+ * @brief `newround SIZE FIRST`: empty boards plus the handicap the last round earned.
+ */
+const char* EngineSession::newRound(const string_view* tokens, const int count, string& reply) {
+    int size = 0;
+    Side first = Side::None;
+    if (count != 3 || !parseNumber(tokens[1], 1, Board::MAX_SIZE, size) || !parseSide(tokens[2], first)) {
+        return "usage: newround SIZE human|computer";
+    }
+
+    boards[0] = boards[1] = Board(size);
+    advantageOwner = Side::None;
+    advantageSquare = 0;
+    if (pendingFor != Side::None && pendingSquare > 0) {
+        // Like Tournament::applyAdvantageToNewRound: a square off the board is protected but not covered.
+        boardOf(pendingFor).coverSquare(pendingSquare);
+        advantageOwner = pendingFor;
+        advantageSquare = pendingSquare;
+    }
+    pendingFor = Side::None;
+    pendingSquare = 0;
+    mover = firstPlayer = first;
+    pendingRoll = 0;
+    inRound = true;
+    dice.nextTurn();
+    appendPosition(reply);
+    return nullptr;
+}
+
+/**
+ * @brief `position SIZE HUMAN COMPUTER MOVER [first SIDE] [advantage SIDE SQUARE]`.
+ */
+const char* EngineSession::setPosition(const string_view* tokens, const int count, string& reply) {
+    constexpr const char* usage = "usage: position SIZE HUMAN COMPUTER human|computer [first SIDE] [advantage SIDE SQUARE]";
+    int size = 0;
+    uint32_t masks[2] = {0, 0};
+    Side toMove = Side::None;
+    if (count < 5 || !parseNumber(tokens[1], 1, Board::MAX_SIZE, size) || !parseSquares(tokens[2], size, masks[0]) ||
+        !parseSquares(tokens[3], size, masks[1]) || !parseSide(tokens[4], toMove)) {
+        return usage;
+    }
+    Side first = toMove, owner = Side::None;
+    int square = 0;
+    for (int i = 5; i < count;) {
+        if (tokens[i] == "first" && i + 1 < count && parseSide(tokens[i + 1], first)) {
+            i += 2;
+        } else if (tokens[i] == "advantage" && i + 2 < count && parseSide(tokens[i + 1], owner) &&
+                   parseNumber(tokens[i + 2], 1, Board::MAX_SIZE, square)) {
+            i += 3;
+        } else {
+            return usage;
+        }
+    }
+
+    Board human(size), computer(size);
+    human.applyMove(masks[0], true);
+    computer.applyMove(masks[1], true);
+    if (human.allCovered() || computer.allCovered()) return "position is already won";
+
+    boards[0] = human;
+    boards[1] = computer;
+    mover = toMove;
+    firstPlayer = first;
+    advantageOwner = owner;
+    advantageSquare = square;
+    pendingFor = Side::None;
+    pendingSquare = 0;
+    pendingRoll = 0;
+    inRound = true;
+    dice.nextTurn();
+    appendPosition(reply);
+    return nullptr;
+}
+
+/**
+ * @brief `roll [SUM]`: record or throw the mover's roll; a roll without a legal move passes the turn.
+ */
+const char* EngineSession::roll(const string_view* tokens, const int count, string& reply) {
+    if (!inRound) return NO_ROUND;
+    if (pendingRoll > 0) return "the last roll still waits for its move";
+    const Board& own = boardOf(mover);
+
+    int sum = 0;
+    if (count == 2) {
+        if (!parseNumber(tokens[1], 1, 12, sum)) return "usage: roll [SUM]";
+        if (sum == 1 && !own.canThrowOneDie()) return "one die is not allowed yet";
+    } else if (count == 1) {
+        const int diceCount = chooseDiceCount();
+        sum = dice.rollDie() + (diceCount == 2 ? dice.rollDie() : 0);
+    } else {
+        return "usage: roll [SUM]";
+    }
+
+    reply += "roll ";
+    appendNumber(reply, sum);
+    reply += '\n';
+    const int guarded = protectedSquare();
+    if (own.hasValidMove(sum, true) ||
+        boardOf(opponentOf(mover)).hasValidMove(sum, false, guarded > 0 ? Board::bitOf(guarded) : 0)) {
+        pendingRoll = sum;
+    } else {
+        endTurn(reply);
+    }
+    return nullptr;
+}
+
+/**
+ * @brief `analyse`: every legal move for the roll, valued from the solved table when mapped, then the engine's choice.
+ */
+const char* EngineSession::analyse(string& reply) const {
+    if (pendingRoll == 0) return NO_ROLL;
+    const Board& own = boardOf(mover);
+    const Board& opponent = boardOf(opponentOf(mover));
+    const PolicyTable* policy = PolicyTable::forBoardSize(own.getSize());
+
+    MoveList uncovers = opponent.findValidMoves(pendingRoll, false);
+    if (protectedSquare() > 0) uncovers.removeTouching(protectedSquare());
+    for (const bool covering : {true, false}) {
+        for (const uint32_t combo : covering ? own.findValidMoves(pendingRoll, true) : uncovers) {
+            const StrategyResult move{covering ? StrategyResult::Action::Cover : StrategyResult::Action::Uncover, combo};
+            reply += "info move ";
+            appendMove(reply, move);
+            if (policy) {
+                char buffer[16];
+                const double value = policy->valueAfter(own.getCoveredMask(), opponent.getCoveredMask(), move);
+                reply += " value ";
+                reply.append(buffer, to_chars(buffer, buffer + sizeof(buffer), value, chars_format::fixed, 4).ptr);
+            }
+            reply += '\n';
+        }
+    }
+    appendBestMove(reply);
+    return nullptr;
+}
+
+/**
+ * @brief `applymove cover|uncover SQUARES`: play the mover's move, ending the round when it wins.
+ */
+const char* EngineSession::applyMove(const string_view* tokens, const int count, string& reply) {
+    if (pendingRoll == 0) return NO_ROLL;
+    Board& own = boardOf(mover);
+    Board& opponent = boardOf(opponentOf(mover));
+    uint32_t combo = 0;
+    if (count != 3 || (tokens[1] != "cover" && tokens[1] != "uncover") ||
+        !parseSquares(tokens[2], own.getSize(), combo) || combo == 0) {
+        return "usage: applymove cover|uncover SQUARES";
+    }
+    const bool covering = tokens[1] == "cover";
+    Board& target = covering ? own : opponent;
+    if (sumOf(combo) != pendingRoll) return "squares do not add up to the roll";
+    if (!target.isValidCombination(combo, covering)) {
+        return covering ? "squares are already covered" : "squares are not covered";
+    }
+    if (!covering && protectedSquare() > 0 && (combo & Board::bitOf(protectedSquare()))) {
+        return "the advantage square is protected";
+    }
+
+    target.applyMove(combo, covering);
+    pendingRoll = 0;
+
+    const Round::MoveOutcome outcome =
+        Round::outcomeOfMove(own.getCoveredMask(), opponent.getCoveredMask(), own.getFullMask(), covering);
+    if (outcome.won) {
+        scores[mover == Side::Human ? 0 : 1] += outcome.score;
+        pendingFor = Tournament::handicapRecipient(mover, mover == firstPlayer);
+        pendingSquare = Tournament::calculateAdvantageSquare(outcome.score);
+        advantageOwner = Side::None;
+        advantageSquare = 0;
+        inRound = false;
+        reply += "roundover ";
+        reply += nameOf(mover);
+        reply += outcome.byCover ? " cover " : " uncover ";
+        appendNumber(reply, outcome.score);
+        reply += '\n';
+        return nullptr;
+    }
+
+    reply += "ok\n";
+    if (outcome.turnEnds) endTurn(reply);
+    return nullptr;
+}
+
+/**
+ * @brief Choose the mover's move for the pending roll as the Computer would.
+ * @return The move (Action::None when no legal move exists)
+ */
+StrategyResult EngineSession::chooseMove() const {
+    const Board& own = boardOf(mover);
+    const Board& opponent = boardOf(opponentOf(mover));
+    if (rollout) return rollout->bestMove(GameState(own, opponent, 0, protectedSquare()), pendingRoll).move;
+    if (const PolicyTable* policy = PolicyTable::forBoardSize(own.getSize())) {
+        return policy->bestMove(own.getCoveredMask(), opponent.getCoveredMask(), pendingRoll, protectedSquare());
+    }
+    return computeBestMove(pendingRoll, own, opponent, protectedSquare());
+}
+
+/**
+ * @brief Choose the mover's dice count as the Computer would.
+ * @return 1 or 2
+ */
+int EngineSession::chooseDiceCount() const {
+    const Board& own = boardOf(mover);
+    if (!own.canThrowOneDie()) return 2;
+    if (const PolicyTable* policy = PolicyTable::forBoardSize(own.getSize())) {
+        return policy->diceCount(own.getCoveredMask(), boardOf(opponentOf(mover)).getCoveredMask());
+    }
+    return strategy::chooseDiceCount(own);
+}
+
+/**
+ * @brief Pass the turn and report it; protection expires once the owner's opponent has played.
+ * @param reply Receives `pass SIDE`
+ */
+void EngineSession::endTurn(string& reply) {
+    if (advantageOwner != Side::None && advantageOwner != mover) {
+        advantageOwner = Side::None;
+        advantageSquare = 0;
+    }
+    mover = opponentOf(mover);
+    dice.nextTurn();
+    reply += "pass ";
+    reply += nameOf(mover);
+    reply += '\n';
+}
+
+/**
+ * @brief Append the round's position in the form `position` accepts.
+ * @param reply Receives the line
+ */
+void EngineSession::appendPosition(string& reply) const {
+    reply += "position ";
+    appendNumber(reply, boards[0].getSize());
+    reply += ' ';
+    appendSquares(reply, boards[0].getCoveredMask());
+    reply += ' ';
+    appendSquares(reply, boards[1].getCoveredMask());
+    reply += ' ';
+    reply += nameOf(mover);
+    reply += " first ";
+    reply += nameOf(firstPlayer);
+    if (advantageOwner != Side::None) {
+        reply += " advantage ";
+        reply += nameOf(advantageOwner);
+        reply += ' ';
+        appendNumber(reply, advantageSquare);
+    }
+    reply += '\n';
+}
+
+/**
+ * @brief Append the engine's move for the pending roll.
+ * @param reply Receives `bestmove ...`
+ */
+void EngineSession::appendBestMove(string& reply) const {
+    const StrategyResult move = chooseMove();
+    reply += "bestmove ";
+    if (move.action == StrategyResult::Action::None) reply += "none";
+    else appendMove(reply, move);
+    reply += '\n';
+}
@@ -0,0 +1,126 @@
+/**
+ * @file GameContext.cpp
+ * @brief Implementation of the per-game advantage state.
+ */
+
+#include "../Header Files/GameContext.h"
+
+/** @return true when an advantage has been applied for the current round. */
+bool GameContext::getAdvantageApplied() const {
+    return advantageApplied;
+}
+
+/** @return configured advantage square index. */
+int GameContext::getAdvantageSquare() const {
+    return advantageSquare;
+}
+
+/** @return Which side currently owns the advantage. */
+GameContext::Side GameContext::getAdvantageOwner() const {
+    return advantageOwner;
+}
+
+/** @return true when the human advantage protection flag is set. */
+bool GameContext::isHumanAdvantageProtected() const {
+    return protectHumanAdvantage;
+}
+
+/** @return true when the computer advantage protection flag is set. */
+bool GameContext::isComputerAdvantageProtected() const {
+    return protectComputerAdvantage;
+}
+
+/**
+ * @brief Record the advantage square without applying it.
+ * @param square Advantage square index
+ */
+void GameContext::setAdvantageSquare(const int square) {
+    advantageSquare = square;
+}
+
+/**
+ * @brief Mark the advantage as applied for `owner` and protect it.
+ * @param owner Side that receives the advantage
+ * @param square Advantage square index
+ */
+void GameContext::applyAdvantage(const Side owner, const int square) {
+    advantageSquare          = square;
+    advantageOwner           = owner;
+    protectHumanAdvantage    = (owner == Side::Human);
+    protectComputerAdvantage = (owner == Side::Computer);
+    advantageApplied         = (owner != Side::None);
+}
+
+/** @return The advantage fields as one value. */
+GameContext::AdvantageState GameContext::getAdvantageState() const {
+    return {advantageApplied, advantageSquare, advantageOwner, protectHumanAdvantage, protectComputerAdvantage};
+}
+
+/**
+ * @brief Overwrite the advantage fields, e.g. when resuming a saved game.
+ * @param state Saved fields
+ */
+void GameContext::restoreAdvantageState(const AdvantageState& state) {
+    advantageApplied         = state.applied;
+    advantageSquare          = state.square;
+    advantageOwner           = state.owner;
+    protectHumanAdvantage    = state.protectHuman;
+    protectComputerAdvantage = state.protectComputer;
+}
+
+/**
+ * @brief Reset the applied advantage and protection flags (the square index is kept).
+ */
+void GameContext::clearAdvantage() {
+    advantageApplied         = false;
+    advantageOwner           = Side::None;
+    protectHumanAdvantage    = false;
+    protectComputerAdvantage = false;
+}
+
+/**
+ * @brief Clear protection for the human advantage and potentially reset advantage state.
+ */
+void GameContext::clearAdvantageProtectionForHuman() {
+    protectHumanAdvantage = false;
+    if (!protectComputerAdvantage) {
+        advantageApplied = false;
+        advantageOwner   = Side::None;
+    }
+}
+
+/**
+ * @brief Clear protection for the computer advantage and potentially reset advantage state.
+ */
+void GameContext::clearAdvantageProtectionForComputer() {
+    protectComputerAdvantage = false;
+    if (!protectHumanAdvantage) {
+        advantageApplied = false;
+        advantageOwner   = Side::None;
+    }
+}
+
+/**
+ * @brief Attach a journal and record the start of this game in it.
+ * @param target Journal to append to, or nullptr
+ */
+void GameContext::setJournal(GameJournal* target) {
+    journal = target;
+    if (!journal) return;
+    journalGameId = journal->newGameId();
+    record(JournalEvent::GameStart);
+}
+
+/**
+ * @brief Append one event, tagged with this game's id.
+ * @param type Kind of event
+ * @param side Side the event concerns
+ * @param value Small operand
+ * @param mask Squares or points
+ * @param flags JOURNAL_* bits
+ */
+void GameContext::record(const JournalEvent type, const Side side, const int value, const std::uint32_t mask,
+                         const std::uint8_t flags) const {
+    if (!journal) return;
+    journal->append({journalGameId, mask, type, static_cast<std::uint8_t>(side), static_cast<std::uint8_t>(value), flags});
+}
@@ -0,0 +1,230 @@
+/**
+ * @file GameJournal.cpp
+ * @brief Implementation of GameJournal: opening and validating journals, batching
+ *        events and writing them in the caller's thread or a background thread.
+ */
+
+#include "../Header Files/GameJournal.h"
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    static_assert(sizeof(JournalRecord) == 16, "journal records must keep their layout");
+    static_assert(sizeof(JournalHeader) == 16, "journal header must keep its layout");
+    static_assert(endian::native == endian::little, "journal records are written in memory order, which must be little-endian");
+
+    /**
+     * @brief Write a whole buffer, retrying short and interrupted writes.
+     * @return false on an I/O error (errno is set)
+     */
+    bool writeAll(const int fd, const void* data, size_t length) {
+        const auto* bytes = static_cast<const char*>(data);
+        while (length > 0) {
+            const ssize_t written = ::write(fd, bytes, length);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            bytes += written;
+            length -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+}
+
+/** @brief Close the journal, writing anything still buffered. */
+GameJournal::~GameJournal() {
+    close();
+}
+
+/**
+ * @brief Open or create a journal and start the writer thread when asked for.
+ * @param filename Path of the journal
+ * @param options Writer settings
+ * @return true on success
+ */
+bool GameJournal::open(const string& filename, const Options& options) {
+    close();
+    const int file = ::open(filename.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (file < 0) {
+        cerr << "Unable to open journal " << filename << ": " << strerror(errno) << endl;
+        return false;
+    }
+    const auto fail = [&](const char* reason) {
+        cerr << "Unable to open journal " << filename << ": " << reason << endl;
+        ::close(file);
+        return false;
+    };
+
+    struct stat info{};
+    if (fstat(file, &info) != 0) return fail(strerror(errno));
+    if (info.st_size == 0) {
+        JournalHeader header{};
+        copy(begin(MAGIC), end(MAGIC), header.magic);
+        header.version    = VERSION;
+        header.recordSize = sizeof(JournalRecord);
+        if (!writeAll(file, &header, sizeof(header))) return fail(strerror(errno));
+    } else {
+        JournalHeader header{};
+        if (pread(file, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+            memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            return fail("not a game journal");
+        }
+        if (header.version != VERSION || header.recordSize != sizeof(JournalRecord)) {
+            return fail("unsupported journal version");
+        }
+        const off_t torn = static_cast<off_t>((info.st_size - sizeof(header)) % sizeof(JournalRecord));
+        if (torn != 0) {
+            cerr << "Journal " << filename << " ends in a partial record; dropping its " << torn << " bytes" << endl;
+            if (ftruncate(file, info.st_size - torn) != 0) return fail(strerror(errno));
+        }
+    }
+
+    fd = file;
+    this->options = options;
+    this->options.batchRecords = max<size_t>(options.batchRecords, 1);
+    nextGameId.store(uint64_t{random_device{}()} << 32, memory_order_relaxed);
+    failed.store(false, memory_order_relaxed);
+    stopping = false;
+    writing = false;
+    filling = takeSpare();
+    if (this->options.background) writer = thread(&GameJournal::writerLoop, this);
+    return true;
+}
+
+/**
+ * @brief Flush, stop the writer thread and close the file.
+ */
+void GameJournal::close() {
+    if (fd < 0) return;
+    flush();
+    if (writer.joinable()) {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        writer.join();
+    }
+    ::close(fd);
+    fd = -1;
+    filling.clear();
+    queued.clear();
+    spare.clear();
+}
+
+/**
+ * @brief Copy an event into the current batch and hand the batch on once full.
+ * @param record Event to append
+ */
+void GameJournal::append(const JournalRecord& record) {
+    unique_lock<mutex> guard(lock);
+    if (fd < 0 || failed.load(memory_order_relaxed)) return;
+    filling.push_back(record);
+    if (filling.size() < options.batchRecords) return;
+    if (options.background) queueFilled();
+    else                    writeFilled(guard);
+}
+
+/**
+ * @brief Write the partial batch and, with a writer thread, wait for its queue to drain.
+ */
+void GameJournal::flush() {
+    unique_lock<mutex> guard(lock);
+    if (fd < 0) return;
+    if (options.background) {
+        queueFilled();
+        drained.wait(guard, [this] { return queued.empty() && !writing; });
+    } else {
+        writeFilled(guard);
+    }
+}
+
+/**
+ * @brief Append a batch with one write call.
+ * @param batch Records to write
+ */
+void GameJournal::write(const Batch& batch) {
+    if (batch.empty() || failed.load(memory_order_relaxed)) return;
+    if (!writeAll(fd, batch.data(), batch.size() * sizeof(JournalRecord))) {
+        cerr << "Journal write failed (" << strerror(errno) << "); journaling stopped" << endl;
+        failed.store(true, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Swap out the batch being filled and write it. fileLock is taken before
+ *        lock is released, so batches are written in the order they were filled
+ *        while other threads keep appending to the next one.
+ * @param guard Holds lock on entry and on return
+ */
+void GameJournal::writeFilled(unique_lock<mutex>& guard) {
+    if (filling.empty()) return;
+    Batch batch = takeSpare();
+    batch.swap(filling);
+    {
+        unique_lock<mutex> file(fileLock);
+        guard.unlock();
+        write(batch);
+    }
+    batch.clear();
+    guard.lock();
+    spare.push_back(std::move(batch));
+}
+
+/** @brief Move the batch being filled to the writer thread's queue. */
+void GameJournal::queueFilled() {
+    if (filling.empty()) return;
+    queued.push_back(std::move(filling));
+    filling = takeSpare();
+    wake.notify_one();
+}
+
+/** @return A written batch to reuse, or a new one. */
+GameJournal::Batch GameJournal::takeSpare() {
+    if (spare.empty()) {
+        Batch batch;
+        batch.reserve(options.batchRecords);
+        return batch;
+    }
+    Batch batch = std::move(spare.back());
+    spare.pop_back();
+    return batch;
+}
+
+/**
+ * @brief Write queued batches as they arrive; after a quiet flush interval,
+ *        write whatever has been appended so records never linger in memory.
+ */
+void GameJournal::writerLoop() {
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        if (queued.empty()) {
+            if (stopping) return;
+            const bool woken = wake.wait_for(guard, chrono::milliseconds(options.flushIntervalMs),
+                                             [this] { return stopping || !queued.empty(); });
+            if (!woken) queueFilled();
+            continue;
+        }
+        Batch batch = std::move(queued.front());
+        queued.pop_front();
+        writing = true;
+        guard.unlock();
+        write(batch);
+        batch.clear();
+        guard.lock();
+        writing = false;
+        spare.push_back(std::move(batch));
+        if (queued.empty()) drained.notify_all();
+    }
+}
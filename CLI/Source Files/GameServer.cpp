@@ -0,0 +1,350 @@
+/**
+ * @file GameServer.cpp
+ * @brief Implementation of GameServer: the listening socket, the epoll loop
+ *        and per-connection line buffering.
+ */
+
+#include "../Header Files/GameServer.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    constexpr int MAX_EVENTS = 256; /**< events taken per epoll_wait */
+    constexpr size_t READ_CHUNK = 16384; /**< bytes read per read call */
+    constexpr rlim_t RESERVED_FDS = 64; /**< descriptors kept for everything but sessions */
+
+    /** @return true when the address names a TCP port rather than a socket path. */
+    bool isPort(const string& address) {
+        return !address.empty() && address.size() <= 5 &&
+               all_of(address.begin(), address.end(), [](const unsigned char c) { return isdigit(c) != 0; });
+    }
+
+    /**
+     * @brief Raise the open-file limit as far as allowed and report when it
+     *        still leaves fewer descriptors than the sessions wanted.
+     * @param sessions Sessions the server should have room for
+     */
+    void raiseDescriptorLimit(const size_t sessions) {
+        rlimit limit{};
+        if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return;
+        if (limit.rlim_cur < limit.rlim_max) {
+            rlimit raised = limit;
+            raised.rlim_cur = limit.rlim_max;
+            if (setrlimit(RLIMIT_NOFILE, &raised) == 0) limit = raised;
+        }
+        const rlim_t wanted = static_cast<rlim_t>(sessions) + RESERVED_FDS;
+        if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < wanted) {
+            cerr << "Open file limit is " << limit.rlim_cur << ", room for about "
+                 << (limit.rlim_cur > RESERVED_FDS ? limit.rlim_cur - RESERVED_FDS : 0) << " of " << sessions
+                 << " sessions; raise the hard limit (ulimit -Hn) to serve more." << endl;
+        }
+    }
+}
+
+/** @brief Close every connection and remove the Unix socket. */
+GameServer::~GameServer() {
+    for (const unique_ptr<Connection>& connection : connections) {
+        if (connection) ::close(connection->fd);
+    }
+    if (listener >= 0) ::close(listener);
+    if (poller >= 0) ::close(poller);
+    if (wakeup >= 0) ::close(wakeup);
+    if (!unixPath.empty()) unlink(unixPath.c_str());
+}
+
+/**
+ * @brief Create the listening socket and the epoll set.
+ * @param address Port number or Unix socket path
+ * @param options Server settings
+ * @return true on success
+ */
+bool GameServer::listen(const string& address, const Options& options) {
+    const auto fail = [&](const char* reason) {
+        cerr << "Unable to listen on " << address << ": " << reason << endl;
+        return false;
+    };
+    this->options = options;
+    raiseDescriptorLimit(options.sessionTarget);
+
+    if (isPort(address)) {
+        const int port = stoi(address);
+        if (port < 1 || port > 65535) return fail("port out of range");
+        listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listener < 0) return fail(strerror(errno));
+        const int on = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_port = htons(static_cast<uint16_t>(port));
+        local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(listener, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) return fail(strerror(errno));
+    } else {
+        sockaddr_un local{};
+        if (address.size() >= sizeof(local.sun_path)) return fail("socket path too long");
+        // Replace a socket left behind by an earlier server, but never another kind of file.
+        if (struct stat info{}; lstat(address.c_str(), &info) == 0) {
+            if (!S_ISSOCK(info.st_mode)) return fail("path exists and is not a socket");
+            unlink(address.c_str());
+        }
+        listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listener < 0) return fail(strerror(errno));
+        local.sun_family = AF_UNIX;
+        memcpy(local.sun_path, address.c_str(), address.size());
+        if (bind(listener, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) return fail(strerror(errno));
+        unixPath = address;
+    }
+    if (::listen(listener, SOMAXCONN) != 0) return fail(strerror(errno));
+
+    poller = epoll_create1(EPOLL_CLOEXEC);
+    wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (poller < 0 || wakeup < 0) return fail(strerror(errno));
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = &listener;
+    if (epoll_ctl(poller, EPOLL_CTL_ADD, listener, &event) != 0) return fail(strerror(errno));
+    event.data.ptr = &wakeup;
+    if (epoll_ctl(poller, EPOLL_CTL_ADD, wakeup, &event) != 0) return fail(strerror(errno));
+    return true;
+}
+
+/**
+ * @brief Dispatch socket events until stop().
+ * @return false when epoll fails
+ */
+bool GameServer::run() {
+    epoll_event events[MAX_EVENTS];
+    while (true) {
+        // Connections with a backlog are ready now, so only wait when there are none.
+        const int ready = epoll_wait(poller, events, MAX_EVENTS, backlogged.empty() ? -1 : 0);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            cerr << "Server event loop failed: " << strerror(errno) << endl;
+            return false;
+        }
+        for (int i = 0; i < ready; ++i) {
+            void* const source = events[i].data.ptr;
+            if (source == &listener) {
+                acceptAll();
+                continue;
+            }
+            if (source == &wakeup) return true;
+
+            Connection& connection = *static_cast<Connection*>(source);
+            const uint32_t flags = events[i].events;
+            bool open = (flags & EPOLLERR) == 0;
+            if (open && (connection.watched & EPOLLIN) && (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))) {
+                open = receive(connection);
+                if (open) runLines(connection);
+            }
+            if (open) open = flush(connection);
+            if (!open) close(connection);
+        }
+        runBacklog();
+    }
+}
+
+/**
+ * @brief Wake the event loop so run() returns. Only async-signal-safe calls.
+ */
+void GameServer::stop() {
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t ignored = ::write(wakeup, &one, sizeof(one));
+}
+
+/**
+ * @brief Accept connections until none are pending and give each a session.
+ */
+void GameServer::acceptAll() {
+    while (true) {
+        const int fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                // The listener stays readable while clients wait, so stop watching it or
+                // epoll_wait returns at once forever; close() resumes when a descriptor frees.
+                if (!limitReported) {
+                    cerr << "Unable to accept a session with " << sessions << " open: " << strerror(errno)
+                         << "; new clients wait until one closes." << endl;
+                    limitReported = true;
+                }
+                setAccepting(false);
+                return;
+            }
+            cerr << "Unable to accept a session: " << strerror(errno) << endl;
+            return;
+        }
+        if (unixPath.empty()) {
+            const int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+
+        if (static_cast<size_t>(fd) >= connections.size()) connections.resize(static_cast<size_t>(fd) + 1);
+        connections[fd] = make_unique<Connection>(fd, options.seed, ++nextSessionId);
+        epoll_event event{};
+        event.events = connections[fd]->watched = EPOLLIN | EPOLLRDHUP;
+        event.data.ptr = connections[fd].get();
+        if (epoll_ctl(poller, EPOLL_CTL_ADD, fd, &event) != 0) {
+            cerr << "Unable to watch a session: " << strerror(errno) << endl;
+            connections[fd].reset();
+            ::close(fd);
+            continue;
+        }
+        ++sessions;
+    }
+}
+
+/**
+ * @brief Watch the listener again, or stop watching it.
+ * @param accept true to take new connections
+ */
+void GameServer::setAccepting(const bool accept) {
+    if (accept == accepting) return;
+    epoll_event event{};
+    event.events = accept ? EPOLLIN : 0u;
+    event.data.ptr = &listener;
+    if (epoll_ctl(poller, EPOLL_CTL_MOD, listener, &event) == 0) accepting = accept;
+}
+
+/**
+ * @brief Read one chunk; a client with more to send stays readable for its next turn.
+ * @param connection Readable connection
+ * @return false when the connection must close without writing anything more
+ */
+bool GameServer::receive(Connection& connection) {
+    char buffer[READ_CHUNK];
+    while (true) {
+        const ssize_t count = ::read(connection.fd, buffer, sizeof(buffer));
+        if (count > 0) {
+            connection.input.append(buffer, static_cast<size_t>(count));
+        } else if (count == 0) {
+            // A client that has finished sending still gets the replies to what it sent.
+            connection.ended = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            return false;
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Run complete lines through the session until the turn's allowance
+ *        is spent or the unwritten replies reach MAX_PENDING_OUTPUT.
+ * @param connection Connection with input to run
+ */
+void GameServer::runLines(Connection& connection) {
+    size_t start = 0;
+    connection.backlog = false;
+    for (int run = 0; !connection.closing; ++run) {
+        const size_t end = connection.input.find('\n', start);
+        if (end == string::npos) break;
+        if (run == MAX_LINES_PER_TURN || connection.output.size() - connection.written > MAX_PENDING_OUTPUT) {
+            connection.backlog = true;
+            break;
+        }
+        if (!connection.session.execute(string_view(connection.input).substr(start, end - start), connection.output)) {
+            connection.closing = true;
+        }
+        start = end + 1;
+    }
+    connection.input.erase(0, start);
+    if (!connection.closing && !connection.backlog && connection.input.size() > options.maxLine) {
+        connection.output += "error line too long\n";
+        connection.closing = true;
+    }
+}
+
+/**
+ * @brief Write as much of the pending replies as the socket takes, watching
+ *        for writability only while some remain.
+ * @param connection Connection with replies to write
+ * @return false when the connection must close
+ */
+bool GameServer::flush(Connection& connection) {
+    while (connection.written < connection.output.size()) {
+        const ssize_t count = send(connection.fd, connection.output.data() + connection.written,
+                                   connection.output.size() - connection.written, MSG_NOSIGNAL);
+        if (count >= 0) {
+            connection.written += static_cast<size_t>(count);
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    const bool pending = connection.written < connection.output.size();
+    if (!pending) {
+        connection.output.clear();
+        connection.written = 0;
+        if (connection.closing || (connection.ended && !connection.backlog)) return false;
+    }
+    const bool full = connection.output.size() - connection.written > MAX_PENDING_OUTPUT;
+    if (connection.backlog && !connection.closing && !full && !connection.queued) {
+        connection.queued = true;
+        backlogged.push_back(connection.fd);
+    }
+    // Read only once the lines already read have run and the client is taking its replies;
+    // a connection that has ended or is closing is only written to, or its reads would spin.
+    const bool reading = !connection.ended && !connection.closing && !connection.backlog && !full;
+    const uint32_t wanted = (reading ? static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u) |
+                            (pending ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    if (wanted != connection.watched) {
+        epoll_event event{};
+        event.events = wanted;
+        event.data.ptr = &connection;
+        if (epoll_ctl(poller, EPOLL_CTL_MOD, connection.fd, &event) != 0) return false;
+        connection.watched = wanted;
+    }
+    return true;
+}
+
+/**
+ * @brief Give each connection queued with a backlog one more turn of lines.
+ *        Connections queued again during this pass wait for the next one.
+ */
+void GameServer::runBacklog() {
+    if (backlogged.empty()) return;
+    backlogTurn.swap(backlogged);
+    for (const int fd : backlogTurn) {
+        Connection* const connection = connections[fd].get();
+        // The connection may have closed since, and its socket been reused by one that was never queued.
+        if (!connection || !connection->queued) continue;
+        connection->queued = false;
+        runLines(*connection);
+        if (!flush(*connection)) close(*connection);
+    }
+    backlogTurn.clear();
+}
+
+/**
+ * @brief Stop watching a connection, close it and free its session.
+ * @param connection Connection to close
+ */
+void GameServer::close(Connection& connection) {
+    const int fd = connection.fd;
+    epoll_ctl(poller, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections[fd].reset();
+    --sessions;
+    setAccepting(true);
+}
@@ -6,9 +6,9 @@
 #include "../Header Files/Human.h"
 #include <iostream>
 #include "../Header Files/Computer.h"
-#include "../Header Files/Tournament.h"
+#include "../Header Files/GameContext.h"
+#include "../Header Files/MoveTable.h"
 #include "../Header Files/TextUI.h"
-#include <random>
 #include <limits>
 
 namespace {
@@ -66,9 +66,10 @@ using namespace ui;
  * @brief Construct a Human player bound to their board and the opponent board.
  * @param b Reference to the human's board
  * @param computerBoard Reference to the computer's board
+ * @param context Advantage state of the game
  */
-Human::Human(Board& b, Board& computerBoard)
-    : Player(b, true), boardView(b, "Human"), computerBoardView(computerBoard, "Computer"), computerBoard(computerBoard) {}
+Human::Human(Board& b, Board& computerBoard, GameContext& context)
+    : Player(b, true, context), boardView(b, "Human"), computerBoardView(computerBoard, "Computer"), computerBoard(computerBoard) {}
 
 /**
  * @brief Handle the interactive human turn: roll dice (manual or random),
@@ -103,20 +104,21 @@ bool Human::takeTurn() {
             d1 = readDie_input_human("Enter die 1 (1-6): ");
             d2 = (diceCount==2) ? readDie_input_human("Enter die 2 (1-6): ") : 0;
         } else {
-            static thread_local std::mt19937_64 rng(std::random_device{}());
-            std::uniform_int_distribution<int> dieDist(1,6);
-            d1 = dieDist(rng);
-            d2 = (diceCount==2) ? dieDist(rng) : 0;
+            DiceSource& dice = context.getDice();
+            d1 = dice.rollDie();
+            d2 = (diceCount==2) ? dice.rollDie() : 0;
         }
         sum = d1 + d2;
+        context.record(JournalEvent::DiceCount, GameContext::Side::Human, diceCount);
+        context.record(JournalEvent::Roll, GameContext::Side::Human, sum, 0, manual == 'y' ? JOURNAL_MANUAL : 0);
 
         cout << "You rolled: " << d1;
         if (diceCount==2) cout << " + " << d2 << " = " << sum << "\n";
         else              cout << " = " << sum << " " << c(DIM) << "(1-die)" << c(RESET) << "\n";
 
         // Step 3: Check validity of move
-        bool canCover   = !board.findValidCombinations(sum, true ).empty();
-        bool canUncover = !computerBoard.findValidCombinations(sum, false).empty();
+        bool canCover   = board.hasValidMove(sum, true );
+        bool canUncover = computerBoard.hasValidMove(sum, false);
 
         if (!canCover && !canUncover) {
             cout << "No legal moves for this roll. Your turn ends.\n";
@@ -126,19 +128,19 @@ bool Human::takeTurn() {
         // Step 4: Display current state
         banner("Current Board State");
         computerBoardView.display(
-            Tournament::getAdvantageApplied() &&
-            Tournament::getAdvantageOwner() == Tournament::Side::Computer,
-            Tournament::getAdvantageSquare());
+            context.getAdvantageApplied() &&
+            context.getAdvantageOwner() == GameContext::Side::Computer,
+            context.getAdvantageSquare());
 
         boardView.display(
-            Tournament::getAdvantageApplied() &&
-            Tournament::getAdvantageOwner() == Tournament::Side::Human,
-            Tournament::getAdvantageSquare());
+            context.getAdvantageApplied() &&
+            context.getAdvantageOwner() == GameContext::Side::Human,
+            context.getAdvantageSquare());
 
         // Step 5: Offer Help
         cout << "Do you want help from the computer? (y/n): ";
         if (readYN_input_human()=='y') {
-            const Computer helper(computerBoard, board);
+            const Computer helper(computerBoard, board, context);
             helper.provideHelp(sum, board, computerBoard);
             cout << "\n";
         }
@@ -162,13 +164,13 @@ bool Human::takeTurn() {
 
         // Step 7: Display end state
         banner("Board After Your Move");
-        computerBoardView.display( Tournament::getAdvantageApplied() &&
-                                    Tournament::getAdvantageOwner() == Tournament::Side::Computer,
-                                    Tournament::getAdvantageSquare());
+        computerBoardView.display( context.getAdvantageApplied() &&
+                                    context.getAdvantageOwner() == GameContext::Side::Computer,
+                                    context.getAdvantageSquare());
 
-        boardView.display( Tournament::getAdvantageApplied() &&
-                            Tournament::getAdvantageOwner() == Tournament::Side::Human,
-                            Tournament::getAdvantageSquare());
+        boardView.display( context.getAdvantageApplied() &&
+                            context.getAdvantageOwner() == GameContext::Side::Human,
+                            context.getAdvantageSquare());
         cout << "\n";
 
         // If the human uncovered all the computer's squares, end turn so the
@@ -217,6 +219,7 @@ void Human::coverSquares(const int sum) const {
     const std::set<int> selected = *it;
 
     for (int v : selected) board.coverSquare(v);
+    context.record(JournalEvent::Move, GameContext::Side::Human, 0, MoveTable::toMask(selected), JOURNAL_COVER);
 
     std::cout << c(GREEN) << "Covered: " << c(RESET);
     for (int v : selected) std::cout << v << " ";
@@ -237,15 +240,15 @@ void Human::uncoverSquares(const int sum) const {
     }
 
     // Step 2: Filter Advantage Square
-    if (Tournament::getAdvantageApplied() && Tournament::isComputerAdvantageProtected()) {
+    if (context.getAdvantageApplied() && context.isComputerAdvantageProtected()) {
         for (auto it = validCombinations.begin(); it != validCombinations.end(); ) {
-            if (it->contains(Tournament::getAdvantageSquare())) it = validCombinations.erase(it);
+            if (it->contains(context.getAdvantageSquare())) it = validCombinations.erase(it);
             else ++it;
         }
     }
     if (validCombinations.empty()) {
         std::cout << c(YELLOW) << "No valid uncover options this roll." << c(RESET)
-                  << " Advantage square " << Tournament::getAdvantageSquare()
+                  << " Advantage square " << context.getAdvantageSquare()
                   << " is protected for one turn.\n";
         return;
     }
@@ -281,6 +284,7 @@ void Human::uncoverSquares(const int sum) const {
     for (const int square : selectedCombination) {
         computerBoard.uncoverSquare(square);
     }
+    context.record(JournalEvent::Move, GameContext::Side::Human, 0, MoveTable::toMask(selectedCombination));
     cout << "Uncovered squares: ";
     for (const int square : selectedCombination) {
         cout << square << " ";
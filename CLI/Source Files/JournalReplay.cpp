@@ -0,0 +1,326 @@
+/**
+ * @file JournalReplay.cpp
+ * @brief Implementation of JournalReplay: mapping a journal and re-applying
+ *        each game's events to a pair of Boards under the game's rules.
+ */
+
+#include "../Header Files/JournalReplay.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../Header Files/Round.h"
+#include "../Header Files/Strategy.h"
+#include "../Header Files/Tournament.h"
+
+using namespace std;
+
+namespace {
+    using Side = GameContext::Side;
+
+    /** @brief Position and Score bits of ReplayedGame::setupSeen. */
+    constexpr uint8_t SEEN_POSITION = 1u << 0;
+    constexpr uint8_t SEEN_SCORE = 1u << 2;
+    constexpr uint8_t SEEN_ALL = 0x0F;
+
+    /** @return Board index of a side (0 Human, 1 Computer), or -1 when the byte names neither. */
+    int seatOf(const uint8_t side) {
+        return side == static_cast<uint8_t>(Side::Human) ? 0 : side == static_cast<uint8_t>(Side::Computer) ? 1 : -1;
+    }
+
+    /** @return Printable name of an event type. */
+    const char* nameOf(const JournalEvent type) {
+        switch (type) {
+            case JournalEvent::GameStart:   return "GameStart";
+            case JournalEvent::RoundStart:  return "RoundStart";
+            case JournalEvent::Position:    return "Position";
+            case JournalEvent::Score:       return "Score";
+            case JournalEvent::Advantage:   return "Advantage";
+            case JournalEvent::FirstPlayer: return "FirstPlayer";
+            case JournalEvent::DiceCount:   return "DiceCount";
+            case JournalEvent::Roll:        return "Roll";
+            case JournalEvent::Move:        return "Move";
+            case JournalEvent::RoundEnd:    return "RoundEnd";
+        }
+        return "unknown event";
+    }
+}
+
+/**
+ * @brief Create a replay.
+ * @param maxReported Errors described on stderr before the rest are only counted
+ */
+JournalReplay::JournalReplay(const uint64_t maxReported) : maxReported(maxReported) {}
+
+/**
+ * @brief Map a journal read-only, check its header and replay its records.
+ * @param filename Path of the journal
+ * @param stats Totals to update
+ * @return false when the file is missing or not a journal
+ */
+bool JournalReplay::replayFile(const string& filename, ReplayStats& stats) {
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        cerr << "Unable to open journal " << filename << ": " << strerror(errno) << endl;
+        return false;
+    }
+    struct stat info{};
+    void* base = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<uint64_t>(info.st_size) >= sizeof(JournalHeader)) {
+        base = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd); // the mapping keeps the file alive
+    if (base == MAP_FAILED) {
+        cerr << "Unable to map journal " << filename << endl;
+        return false;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+
+    const auto* header = static_cast<const JournalHeader*>(base);
+    const char* problem = nullptr;
+    if (memcmp(header->magic, GameJournal::MAGIC, sizeof(GameJournal::MAGIC)) != 0) {
+        problem = "not a game journal";
+    } else if (header->version != GameJournal::VERSION || header->recordSize != sizeof(JournalRecord)) {
+        problem = "unsupported journal version";
+    }
+    if (problem) {
+        munmap(base, size);
+        cerr << "Invalid journal " << filename << ": " << problem << endl;
+        return false;
+    }
+
+    // One front-to-back pass; let the kernel read ahead and drop pages behind.
+    madvise(base, size, MADV_SEQUENTIAL);
+    const size_t count = (size - sizeof(JournalHeader)) / sizeof(JournalRecord);
+    if ((size - sizeof(JournalHeader)) % sizeof(JournalRecord) != 0) {
+        cerr << "Journal " << filename << " ends in a partial record; ignoring it" << endl;
+    }
+    replay(reinterpret_cast<const JournalRecord*>(static_cast<const char*>(base) + sizeof(JournalHeader)), count, stats);
+    stats.bytes += size;
+    munmap(base, size);
+    return true;
+}
+
+/**
+ * @brief Replay consecutive records.
+ * @param records First record
+ * @param count Number of records
+ * @param stats Totals to update
+ */
+void JournalReplay::replay(const JournalRecord* records, const size_t count, ReplayStats& stats) {
+    for (size_t i = 0; i < count; ++i, ++position) apply(records[i], stats);
+    stats.events += count;
+}
+
+/**
+ * @brief Check a round that follows a replayed round: empty boards apart from
+ *        the handicap square, the running scores, and the handicap itself.
+ * @param game Game whose setup events have all been seen
+ * @return nullptr when the round starts as the last one's result requires, otherwise the mismatch
+ */
+const char* JournalReplay::checkRoundStart(const ReplayedGame& game) {
+    if (game.resumed || !game.previousEnded) return nullptr;
+    const bool handicap = game.pendingFor != Side::None && game.pendingSquare > 0;
+    if (handicap != (game.advantageOwner != Side::None) ||
+        (handicap && (game.advantageOwner != game.pendingFor || game.advantageSquare != game.pendingSquare ||
+                      !game.advantageProtected))) {
+        return "advantage differs from the last round's handicap";
+    }
+    for (int seat = 0; seat < 2; ++seat) {
+        const Board& board = game.boards[seat];
+        const uint32_t expected = handicap && seatOf(static_cast<uint8_t>(game.pendingFor)) == seat
+            ? Board::bitOf(game.pendingSquare) & board.getFullMask() : 0;
+        if (board.getCoveredMask() != expected) return "new round does not start from empty boards";
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Check that a roll nothing was moved for had no move the player could take.
+ *        A Human who chooses to uncover and finds every option protected keeps
+ *        rolling, so a cover may have been open when the same side rolls again.
+ * @param game Game whose current roll had no move
+ * @param continuing The same side rolls again
+ * @return nullptr when the roll had no move, otherwise the rule broken
+ */
+const char* JournalReplay::checkNoMove(const ReplayedGame& game, const bool continuing) {
+    const int seat = seatOf(static_cast<uint8_t>(game.mover));
+    const Board& own = game.boards[seat];
+    const Board& opponent = game.boards[1 - seat];
+    const uint32_t guarded = game.advantageProtected && game.advantageOwner != game.mover
+        ? Board::bitOf(game.advantageSquare) : 0;
+    if (opponent.hasValidMove(game.sum, false, guarded)) return "roll with a legal uncover was not played";
+    if (!continuing && own.hasValidMove(game.sum, true)) return "roll with a legal cover was not played";
+    return nullptr;
+}
+
+/**
+ * @brief Count an error, describe it while under the reporting limit, and
+ *        skip the rest of the game's round.
+ */
+void JournalReplay::fail(ReplayedGame& game, const JournalRecord& record, const char* what, ReplayStats& stats) {
+    if (stats.errors < maxReported) {
+        cerr << "Record " << position << " (game " << hex << record.game << dec << ", "
+             << nameOf(record.type) << "): " << what << endl;
+    } else if (stats.errors == maxReported) {
+        cerr << "Further errors are counted but not described" << endl;
+    }
+    ++stats.errors;
+    game.broken = true;
+    game.previousEnded = false;
+    game.phase = Phase::Idle;
+}
+
+/**
+ * @brief Apply one event to its game's replay, checking it against the rules.
+ * @param record Event to apply
+ * @param stats Totals to update
+ */
+void JournalReplay::apply(const JournalRecord& record, ReplayStats& stats) {
+    // Games are usually journaled in long runs; only look the game up when it changes.
+    if (!last || record.game != lastId) {
+        last = &games[record.game]; // element addresses survive rehashing
+        lastId = record.game;
+    }
+    ReplayedGame& game = *last;
+
+    if (record.type == JournalEvent::GameStart) {
+        if (game.started) return fail(game, record, "game started twice", stats);
+        game.started = true;
+        ++stats.games;
+        return;
+    }
+    if (!game.started) {
+        game.started = true; // describe the game once, then replay it from its next round
+        return fail(game, record, "event before the game's GameStart", stats);
+    }
+    if (record.type == JournalEvent::RoundStart) {
+        if (game.phase != Phase::Idle && !game.broken) fail(game, record, "round started before the last one ended", stats);
+        if (record.value < 1 || record.value > Board::MAX_SIZE) return fail(game, record, "board size out of range", stats);
+        game.boards[0] = game.boards[1] = Board(record.value);
+        game.phase = Phase::Setup;
+        game.broken = false;
+        game.resumed = (record.flags & JOURNAL_RESUMED) != 0;
+        game.setupSeen = 0;
+        game.mover = Side::None;
+        game.advantageOwner = Side::None;
+        game.advantageSquare = 0;
+        game.advantageProtected = false;
+        return;
+    }
+    if (game.broken) return;
+
+    const int seat = seatOf(record.side);
+    const Side side = static_cast<Side>(record.side);
+    switch (record.type) {
+        case JournalEvent::Position: {
+            if (game.phase != Phase::Setup) return fail(game, record, "position outside a round's start", stats);
+            if (seat < 0) return fail(game, record, "not a side", stats);
+            Board& board = game.boards[seat];
+            if ((record.mask & ~board.getFullMask()) != 0) return fail(game, record, "squares off the board", stats);
+            board.applyMove(record.mask, true);
+            game.setupSeen |= SEEN_POSITION << seat;
+            return;
+        }
+        case JournalEvent::Score:
+            if (game.phase != Phase::Setup) return fail(game, record, "score outside a round's start", stats);
+            if (seat < 0) return fail(game, record, "not a side", stats);
+            if (game.previousEnded && !game.resumed && record.mask != static_cast<uint32_t>(game.scores[seat])) {
+                return fail(game, record, "score differs from the total of the rounds replayed", stats);
+            }
+            game.scores[seat] = static_cast<int>(record.mask);
+            game.setupSeen |= SEEN_SCORE << seat;
+            return;
+        case JournalEvent::Advantage:
+            if (game.phase != Phase::Setup) return fail(game, record, "advantage outside a round's start", stats);
+            if (seat < 0) return fail(game, record, "not a side", stats);
+            game.advantageOwner = side;
+            game.advantageSquare = record.value;
+            game.advantageProtected = (record.flags & JOURNAL_PROTECTED) != 0;
+            return;
+        case JournalEvent::FirstPlayer:
+            if (game.phase != Phase::Setup) return fail(game, record, "first player outside a round's start", stats);
+            if (seat < 0) return fail(game, record, "not a side", stats);
+            if (game.setupSeen != SEEN_ALL) return fail(game, record, "round start lacks a position or score", stats);
+            game.firstPlayer = side;
+            if (const char* problem = checkRoundStart(game)) return fail(game, record, problem, stats);
+            game.phase = Phase::Turn;
+            return;
+        case JournalEvent::DiceCount: {
+            if (game.phase != Phase::Turn && game.phase != Phase::Move) return fail(game, record, "dice count out of turn", stats);
+            if (seat < 0) return fail(game, record, "not a side", stats);
+            const bool continuing = side == game.mover;
+            if (game.phase == Phase::Move) {
+                if (const char* problem = checkNoMove(game, continuing)) return fail(game, record, problem, stats);
+            }
+            if (!continuing) {
+                if (game.mover == Side::None) {
+                    // A resumed round starts with whoever was to move when it was saved.
+                    if (!game.resumed && side != game.firstPlayer) return fail(game, record, "first turn is not the first player's", stats);
+                } else if (game.mover != game.advantageOwner) {
+                    // Protection lasts until the advantage owner's opponent has played a turn.
+                    game.advantageProtected = false;
+                }
+                game.mover = side;
+            }
+            if (record.value != 1 && record.value != 2) return fail(game, record, "dice count is not 1 or 2", stats);
+            if (record.value == 1 && !game.boards[seat].canThrowOneDie()) {
+                return fail(game, record, "one die thrown before the one-die rule applies", stats);
+            }
+            game.diceCount = record.value;
+            game.phase = Phase::Roll;
+            return;
+        }
+        case JournalEvent::Roll:
+            if (game.phase != Phase::Roll || side != game.mover) return fail(game, record, "roll without a dice count", stats);
+            if (record.value < game.diceCount || record.value > 6 * game.diceCount) {
+                return fail(game, record, "roll out of range for the dice", stats);
+            }
+            game.sum = record.value;
+            game.phase = Phase::Move;
+            ++stats.rolls;
+            return;
+        case JournalEvent::Move: {
+            if (game.phase != Phase::Move || side != game.mover) return fail(game, record, "move without a roll", stats);
+            const bool covering = (record.flags & JOURNAL_COVER) != 0;
+            Board& target = game.boards[covering ? seat : 1 - seat];
+            if (record.mask == 0 || (record.mask & ~target.getFullMask()) != 0 ||
+                !target.isValidCombination(record.mask, covering)) {
+                return fail(game, record, covering ? "covers squares that are not uncovered" : "uncovers squares that are not covered", stats);
+            }
+            if (strategy::sumOf(record.mask) != game.sum) return fail(game, record, "squares do not add up to the roll", stats);
+            if (!covering && game.advantageProtected && game.advantageOwner != side &&
+                (record.mask & Board::bitOf(game.advantageSquare)) != 0) {
+                return fail(game, record, "uncovers the protected advantage square", stats);
+            }
+            target.applyMove(record.mask, covering);
+            game.phase = Phase::Turn;
+            ++stats.moves;
+            return;
+        }
+        case JournalEvent::RoundEnd: {
+            if (game.phase != Phase::Turn && game.phase != Phase::Move) return fail(game, record, "round ended outside a round", stats);
+            if (game.phase == Phase::Move) {
+                if (const char* problem = checkNoMove(game, false)) return fail(game, record, problem, stats);
+            }
+            const Round::Outcome outcome = Round::outcomeOf(game.boards[0], game.boards[1]);
+            if (outcome.winner == Side::None) return fail(game, record, "round ended with no winning position", stats);
+            if (outcome.winner != side || outcome.byCover != ((record.flags & JOURNAL_BY_COVER) != 0) ||
+                static_cast<uint32_t>(outcome.score) != record.mask) {
+                return fail(game, record, "winner or points differ from the replayed boards", stats);
+            }
+            game.scores[seat] += outcome.score;
+            game.pendingFor = Tournament::handicapRecipient(side, side == game.firstPlayer);
+            game.pendingSquare = Tournament::calculateAdvantageSquare(outcome.score);
+            game.previousEnded = true;
+            game.phase = Phase::Idle;
+            ++stats.rounds;
+            return;
+        }
+        default:
+            return fail(game, record, "unknown event", stats);
+    }
+}
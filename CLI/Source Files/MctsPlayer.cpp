@@ -0,0 +1,130 @@
+/**
+ * @file MctsPlayer.cpp
+ * @brief Implementation of MctsPlayer: each dice choice and move of the
+ *        Computer's turn comes from the Monte Carlo Tree Search.
+ */
+
+#include "../Header Files/MctsPlayer.h"
+#include <bit>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "../Header Files/GameState.h"
+#include "../Header Files/MctsSearch.h"
+#include "../Header Files/Strategy.h"
+#include "../Header Files/TextUI.h"
+
+using namespace std;
+using namespace ui;
+using namespace strategy;
+
+namespace {
+
+    /** @brief Print the squares of a combination mask, comma separated. */
+    void printSquareList(std::uint32_t combo) {
+        for (bool first = true; combo != 0; combo &= combo - 1, first = false) {
+            if (!first) cout << ", ";
+            cout << countr_zero(combo);
+        }
+    }
+
+    /** @brief A search's statistics as a short sentence. */
+    string describeSearch(const MctsResult& result) {
+        return "MCTS: won " + to_string(static_cast<int>(100.0 * result.winRate + 0.5))
+             + "% of its simulations (" + to_string(result.iterations) + " this move, "
+             + to_string(result.reusedVisits) + " carried over, "
+             + to_string(result.treeSize) + " nodes).";
+    }
+
+} // anonymous namespace
+
+/**
+ * @brief Construct an MCTS player bound to its board, the human board and a search.
+ */
+MctsPlayer::MctsPlayer(Board& b, Board& humanBoard, GameContext& context, MctsSearch& search)
+    : Player(b, false, context),
+      boardView(b, "Computer"),
+      humanBoardView(humanBoard, "Human"),
+      humanBoard(humanBoard),
+      search(search) {}
+
+/**
+ * @brief Execute the turn: search the dice count, roll, search the move and
+ *        apply it, until a roll has no legal move or the round is won.
+ * @return true when the turn ends
+ */
+bool MctsPlayer::takeTurn() {
+    section("Computer Turn");
+
+    while (true) {
+        const bool oppProtected =
+            context.getAdvantageApplied() &&
+            context.isHumanAdvantageProtected();
+
+        // Seats as in the Round and Simulator: the human is seat 0, the computer seat 1.
+        const GameState state(humanBoard, board, 1, oppProtected ? context.getAdvantageSquare() : 0);
+
+        const MctsResult diceChoice = search.chooseDiceCount(state);
+        const int diceCount = diceChoice.diceCount;
+        DiceSource& dice = context.getDice();
+        const int d1 = dice.rollDie();
+        const int d2 = (diceCount == 2) ? dice.rollDie() : 0;
+        const int sum = d1 + d2;
+        context.record(JournalEvent::DiceCount, GameContext::Side::Computer, diceCount);
+        context.record(JournalEvent::Roll, GameContext::Side::Computer, sum);
+
+        cout << "Chooses to roll " << (diceCount == 1 ? "1 die" : "2 dice") << " " << c(DIM) << "(";
+        if (!board.canThrowOneDie()) {
+            cout << "must use 2 dice (1-die not allowed until " << Board::ONE_DIE_RULE_START << ".."
+                 << board.getSize() << " are covered)";
+        } else {
+            cout << describeSearch(diceChoice);
+        }
+        cout << ")" << c(RESET) << ".\n";
+        if (diceCount == 2) cout << "Rolled: " << d1 << " + " << d2 << " = " << sum << "\n";
+        else cout << "Rolled: " << d1 << " = " << sum << "\n";
+
+        const MctsResult result = search.bestMove(state, sum);
+        const StrategyResult& best = result.move;
+        if (best.action == StrategyResult::Action::None) {
+            cout << "Computer has no legal moves for this roll. Its turn ends.\n";
+            return true;
+        }
+        const bool isWinning = isComboWinning(best, board, humanBoard);
+        const bool covering = best.action == StrategyResult::Action::Cover;
+
+        section("Computer Explanation");
+        cout << c(GREEN) << (covering ? "Action: COVER" : "Action: UNCOVER") << c(RESET) << ": ";
+        printSquareList(best.combo);
+        cout << "\n";
+        if (isWinning) {
+            cout << c(YELLOW) << "Why: This move immediately wins the round." << c(RESET) << "\n";
+        } else {
+            cout << "Why: " << describeSearch(result) << "\n";
+            if (!covering && oppProtected) {
+                cout << "      Note: The opponent's advantage square is protected, so it was not considered.\n";
+            }
+        }
+        hr();
+
+        applyCombo(covering ? board : humanBoard, best.combo, covering);
+        context.record(JournalEvent::Move, GameContext::Side::Computer, 0, best.combo, covering ? JOURNAL_COVER : 0);
+        cout << "\n";
+
+        boardView.display(
+            context.getAdvantageApplied() &&
+            context.getAdvantageOwner() == GameContext::Side::Computer,
+            context.getAdvantageSquare());
+
+        humanBoardView.display(
+            context.getAdvantageApplied() &&
+            context.getAdvantageOwner() == GameContext::Side::Human,
+            context.getAdvantageSquare());
+
+        cout << "\n";
+
+        // Stop on a win or at the end of the turn (Round::outcomeOfMove).
+        if (board.allCovered()) return true;
+        if (humanBoard.allUncovered()) return true;
+    }
+}
@@ -0,0 +1,586 @@
+/**
+ * @file MctsSearch.cpp
+ * @brief Monte Carlo Tree Search: node arenas, tree reuse, selection,
+ *        expansion, and the timed iteration loop on one or many workers.
+ */
+
+#include "../Header Files/MctsSearch.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <utility>
+#include "../Header Files/DiceSource.h"
+#include "../Header Files/RolloutSearch.h"
+#include "../Header Files/TranspositionTable.h"
+#include "../Header Files/WorkStealingPool.h"
+
+using namespace std;
+using namespace strategy;
+
+namespace {
+    constexpr uint64_t ITERATIONS_PER_CLOCK_CHECK = 64; /**< Iterations between deadline checks */
+    constexpr uint32_t MAX_CHILDREN = 2 * MoveList::CAPACITY; /**< Most children any node can have */
+    constexpr uint32_t NONE = 0xFFFFFFFFu; /**< firstChild of a leaf */
+    constexpr uint32_t EXPANDING = 0xFFFFFFFEu; /**< firstChild while a worker creates the children */
+    constexpr uint32_t WIN_POINTS = 2; /**< points for a win; an unfinished round scores 1 */
+    constexpr uint32_t PRIOR_VISITS = 32; /**< Most visits a transposition table value gives a new node */
+    constexpr uint32_t STORE_VISITS = 16; /**< Visits between a Roll node's stores in the table */
+
+    /** @brief What a node represents. */
+    enum class Kind : uint8_t { Roll, Chance, Sum, Terminal };
+
+    /**
+     * @brief A tree node; 32 bytes, children stored contiguously from firstChild.
+     *
+     * firstChild, visits and points are shared between workers in a
+     * tree-parallel search and are only accessed through atomic_ref; the rest
+     * is written once before the node is published.
+     */
+    struct Node {
+        uint32_t firstChild; /**< arena index of the first child; NONE for a leaf, EXPANDING while claimed */
+        uint32_t visits; /**< iterations through this node, plus virtual losses in flight */
+        uint32_t points; /**< results for owner: WIN_POINTS per win, 1 per unfinished round */
+        uint32_t masks[2]; /**< covered squares of seat 0 and seat 1 */
+        uint32_t combo; /**< squares of the move into this node (children of a Sum node) */
+        Kind kind; /**< node kind */
+        uint8_t mover; /**< seat to act */
+        uint8_t owner; /**< seat whose choice led here; points are from its side */
+        uint8_t childCount; /**< children in the block */
+        uint8_t value; /**< dice count (Chance) or sum (Sum) */
+        uint8_t protectedSquare; /**< opponent square the mover may not uncover */
+        uint8_t action; /**< StrategyResult::Action of the move into this node */
+        uint8_t unused; /**< padding */
+    };
+    static_assert(sizeof(Node) == 32, "Node should stay half a cache line");
+
+    /** @brief Atomic view of a shared node counter. */
+    atomic_ref<uint32_t> shared(const uint32_t& field) {
+        return atomic_ref<uint32_t>(const_cast<uint32_t&>(field));
+    }
+
+    /** @brief Build an unexpanded node for a position. */
+    Node makeNode(const Kind kind, const GameState& state, const int owner, const int value) {
+        Node node{};
+        node.firstChild = NONE;
+        node.masks[0] = state.boards[0].getCoveredMask();
+        node.masks[1] = state.boards[1].getCoveredMask();
+        node.kind = kind;
+        node.mover = static_cast<uint8_t>(state.mover);
+        node.owner = static_cast<uint8_t>(owner);
+        node.value = static_cast<uint8_t>(value);
+        node.protectedSquare = static_cast<uint8_t>(state.protectedSquare);
+        return node;
+    }
+
+    /** @brief Whether two nodes stand for the same decision point. */
+    bool samePosition(const Node& a, const Node& b) {
+        return a.kind == b.kind && a.value == b.value && a.mover == b.mover &&
+               a.masks[0] == b.masks[0] && a.masks[1] == b.masks[1] &&
+               a.protectedSquare == b.protectedSquare;
+    }
+
+    /** @brief Points a result is worth to a node's owner. */
+    uint32_t pointsFor(const Node& node, const int winner) {
+        return winner == node.owner ? WIN_POINTS : (winner < 0 ? 1 : 0);
+    }
+
+    /** @brief A node's statistics as a table entry, from its mover's side. */
+    TranspositionTable::Entry entryFor(const Node& node, const uint32_t visits) {
+        const TranspositionTable::Entry entry{shared(node.points).load(memory_order_relaxed), visits};
+        return node.owner == node.mover ? entry : entry.flipped();
+    }
+
+    /** @brief Start a new Roll node from the table's value for its position, if there is one. */
+    void seedFromTable(const TranspositionTable& table, const uint64_t key, Node& node) {
+        TranspositionTable::Entry entry;
+        if (!table.probe(key, entry)) return;
+        entry = entry.cappedAt(PRIOR_VISITS);
+        if (node.owner != node.mover) entry = entry.flipped();
+        node.visits = entry.samples;
+        node.points = entry.points;
+    }
+}
+
+/**
+ * @brief One search tree: two arenas (live and reuse target) and the
+ *        operations a worker performs on them.
+ */
+class MctsSearch::Tree {
+public:
+    /**
+     * @brief Allocate the arenas; their pages are only touched as nodes are created.
+     * @param config Search settings
+     * @param maxNodes Capacity of each arena
+     */
+    Tree(const MctsConfig& config, const size_t maxNodes)
+        : config(config),
+          capacity(static_cast<uint32_t>(min<size_t>(maxNodes, EXPANDING - 1))),
+          nodes(new Node[capacity]),
+          spare(config.reuseTree ? new Node[capacity] : nullptr) {}
+
+    /** @return Nodes in use. */
+    uint32_t used() const { return min(size.load(memory_order_relaxed), capacity); }
+
+    /** @brief Drop every node. */
+    void clear() {
+        size.store(0, memory_order_relaxed);
+        chosen = NONE;
+    }
+
+    /** @return The root (valid after setRoot). */
+    const Node& root() const { return nodes[0]; }
+
+    /** @return A node by index. */
+    const Node& at(const uint32_t index) const { return nodes[index]; }
+
+    /**
+     * @brief Root the tree at a position, keeping its subtree when reuse is on, and expand it.
+     * @return Nodes created
+     */
+    uint32_t setRoot(const GameState& state, const Kind kind, const int value) {
+        const Node key = makeNode(kind, state, 1 - state.mover, value);
+        if (state.own().getSize() != boardSize) {
+            boardSize = state.own().getSize();
+            clear();
+        }
+
+        const uint32_t found = (config.reuseTree && used() > 0) ? find(key) : NONE;
+        if (found == NONE) {
+            nodes[0] = key;
+            size.store(1, memory_order_relaxed);
+        } else if (found != 0) {
+            // Copy the subtree breadth-first into the spare arena; each node's child
+            // block is appended when the node is reached, so blocks stay contiguous.
+            uint32_t count = 1;
+            spare[0] = nodes[found];
+            for (uint32_t i = 0; i < count; ++i) {
+                const uint32_t from = spare[i].firstChild;
+                if (from >= EXPANDING) continue;
+                spare[i].firstChild = count;
+                copy(&nodes[from], &nodes[from] + spare[i].childCount, &spare[count]);
+                count += spare[i].childCount;
+            }
+            swap(nodes, spare);
+            size.store(count, memory_order_relaxed);
+        }
+        chosen = NONE;
+
+        if (nodes[0].firstChild != NONE) return 0;
+        const uint32_t before = used();
+        if (!expand(0)) {
+            // The arena is full: keep only the root.
+            size.store(1, memory_order_relaxed);
+            expand(0);
+            return used() - 1;
+        }
+        return used() - before;
+    }
+
+    /**
+     * @brief Note the root child a decision picked; the next setRoot looks for its root below it.
+     * @param offset Child's position in the root's child block
+     */
+    void remember(const uint32_t offset) {
+        const uint32_t first = nodes[0].firstChild;
+        chosen = first < EXPANDING ? first + offset : NONE;
+    }
+
+    /**
+     * @brief One select/expand/evaluate/backpropagate pass.
+     * @param dice Dice stream of this iteration
+     * @param virtualLoss Lost visits to hold on the path while the playout runs (0 for a private tree)
+     * @param path Buffer for the visited nodes
+     */
+    void iterate(DiceSource& dice, const uint32_t virtualLoss, vector<uint32_t>& path) {
+        path.clear();
+        uint32_t index = 0;
+        while (true) {
+            path.push_back(index);
+            shared(nodes[index].visits).fetch_add(1 + virtualLoss, memory_order_relaxed);
+            const uint32_t first = shared(nodes[index].firstChild).load(memory_order_acquire);
+            if (first >= EXPANDING) break;
+            index = select(nodes[index], first, dice);
+        }
+
+        const Node& leaf = nodes[index];
+        if (leaf.kind != Kind::Terminal) expand(index);
+        const int winner = evaluate(leaf, dice);
+
+        for (const uint32_t i : path) {
+            Node& node = nodes[i];
+            if (virtualLoss > 0) shared(node.visits).fetch_sub(virtualLoss, memory_order_relaxed);
+            if (const uint32_t points = pointsFor(node, winner)) shared(node.points).fetch_add(points, memory_order_relaxed);
+            if (config.table && node.kind == Kind::Roll) storeEvery(*config.table, node);
+        }
+    }
+
+private:
+    /** @brief Rebuild the position a node stands for. */
+    GameState stateOf(const Node& node) const {
+        GameState state(boardSize, node.mover);
+        state.boards[0].applyMove(node.masks[0], /*covering=*/true);
+        state.boards[1].applyMove(node.masks[1], /*covering=*/true);
+        state.protectedSquare = node.protectedSquare;
+        state.rehash();
+        return state;
+    }
+
+    /**
+     * @brief Index of the most visited node for the key's position, or NONE.
+     *
+     * Only the subtree of the last decision's choice is searched, and only
+     * along lines the opponent's moves could have taken: on the way to the
+     * key the mover's squares can only have been uncovered and the
+     * opponent's only covered.
+     */
+    uint32_t find(const Node& key) {
+        if (samePosition(nodes[0], key)) return 0;
+        if (chosen >= used()) return NONE;
+        const int mover = key.mover, opponent = 1 - key.mover;
+        const auto onTheWay = [&](const Node& node) {
+            return (node.masks[mover] & key.masks[mover]) == key.masks[mover] &&
+                   (node.masks[opponent] & ~key.masks[opponent]) == 0;
+        };
+
+        uint32_t best = NONE;
+        pending.assign(1, chosen);
+        while (!pending.empty()) {
+            const uint32_t i = pending.back();
+            pending.pop_back();
+            const Node& node = nodes[i];
+            if (!onTheWay(node)) continue;
+            if (samePosition(node, key)) {
+                if (best == NONE || node.visits > nodes[best].visits) best = i;
+                continue;
+            }
+            if (node.firstChild >= EXPANDING) continue;
+            for (uint32_t c = 0; c < node.childCount; ++c) pending.push_back(node.firstChild + c);
+        }
+        return best;
+    }
+
+    /** @brief Store a Roll node's statistics each time its visits reach another multiple of STORE_VISITS. */
+    void storeEvery(TranspositionTable& table, const Node& node) const {
+        const uint32_t visits = shared(node.visits).load(memory_order_relaxed);
+        if (visits == 0 || visits % STORE_VISITS != 0) return;
+        table.store(zobrist::hashOf(boardSize, node.masks[0], node.masks[1], node.mover, node.protectedSquare),
+                    entryFor(node, visits));
+    }
+
+    /**
+     * @brief Create a leaf's children, unless another worker has claimed it or the arena is full.
+     * @return true when this call expanded the node
+     */
+    bool expand(const uint32_t index) {
+        uint32_t expected = NONE;
+        if (!shared(nodes[index].firstChild).compare_exchange_strong(expected, EXPANDING, memory_order_acquire)) {
+            return false;
+        }
+
+        // Only the fields fixed at creation are read; the counters may be changing under other workers.
+        const Node& parent = nodes[index];
+        const GameState state = stateOf(parent);
+        const int mover = state.mover;
+        array<Node, MAX_CHILDREN> children;
+        uint32_t count = 0;
+
+        switch (parent.kind) {
+            case Kind::Roll: {
+                // The heuristic's choice first, so that it wins ties.
+                const int preferred = strategy::chooseDiceCount(state.own());
+                children[count++] = makeNode(Kind::Chance, state, mover, preferred);
+                if (state.own().canThrowOneDie()) children[count++] = makeNode(Kind::Chance, state, mover, 3 - preferred);
+                break;
+            }
+            case Kind::Chance:
+                for (int sum = parent.value; sum <= 6 * parent.value; ++sum) {
+                    children[count++] = makeNode(Kind::Sum, state, mover, sum);
+                }
+                break;
+            case Kind::Sum: {
+                const int sum = parent.value;
+                const StrategyResult greedy = computeBestMove(sum, state.own(), state.opponent(), state.protectedSquare);
+                const auto addMove = [&](const StrategyResult& move) {
+                    GameState next = state;
+                    const bool wins = next.isWinningMove(move);
+                    next.makeMove(move);
+                    if (!wins && next.opponent().allUncovered()) next.passTurn();
+                    Node& child = children[count++];
+                    child = makeNode(wins ? Kind::Terminal : Kind::Roll, next, mover, 0);
+                    child.combo = move.combo;
+                    child.action = static_cast<uint8_t>(move.action);
+                    if (!wins && config.table) seedFromTable(*config.table, next.hash, child);
+                };
+
+                if (greedy.action == StrategyResult::Action::None) {
+                    GameState next = state;
+                    next.passTurn();
+                    Node& child = children[count++];
+                    child = makeNode(Kind::Roll, next, mover, 0);
+                    if (config.table) seedFromTable(*config.table, next.hash, child);
+                    break;
+                }
+                // The greedy move first, so that it wins ties.
+                addMove(greedy);
+                for (const uint32_t combo : state.own().findValidMoves(sum, /*forCovering=*/true)) {
+                    if (greedy.action != StrategyResult::Action::Cover || combo != greedy.combo) {
+                        addMove({StrategyResult::Action::Cover, combo});
+                    }
+                }
+                MoveList uncovers = state.opponent().findValidMoves(sum, /*forCovering=*/false);
+                if (state.protectedSquare > 0) uncovers.removeTouching(state.protectedSquare);
+                for (const uint32_t combo : uncovers) {
+                    if (greedy.action != StrategyResult::Action::Uncover || combo != greedy.combo) {
+                        addMove({StrategyResult::Action::Uncover, combo});
+                    }
+                }
+                break;
+            }
+            case Kind::Terminal:
+                break;
+        }
+
+        // Once the arena is full, stop bumping its size so it cannot wrap around.
+        uint32_t first = capacity;
+        if (count > 0 && size.load(memory_order_relaxed) + count <= capacity) {
+            first = size.fetch_add(count, memory_order_relaxed);
+        }
+        if (first + count > capacity) {
+            shared(nodes[index].firstChild).store(NONE, memory_order_release);
+            return false;
+        }
+        copy(children.begin(), children.begin() + count, &nodes[first]);
+        nodes[index].childCount = static_cast<uint8_t>(count);
+        shared(nodes[index].firstChild).store(first, memory_order_release);
+        return true;
+    }
+
+    /** @brief Dice decide at a Chance node; UCT (unvisited children first) elsewhere. */
+    uint32_t select(const Node& node, const uint32_t first, DiceSource& dice) const {
+        if (node.kind == Kind::Chance) {
+            const int sum = dice.rollDie() + (node.value == 2 ? dice.rollDie() : 0);
+            return first + static_cast<uint32_t>(sum - node.value);
+        }
+
+        const double logVisits = log(static_cast<double>(shared(node.visits).load(memory_order_relaxed)));
+        uint32_t best = first;
+        double bestValue = -1.0;
+        for (uint32_t i = first; i < first + node.childCount; ++i) {
+            const uint32_t visits = shared(nodes[i].visits).load(memory_order_relaxed);
+            if (visits == 0) return i;
+            const double n = static_cast<double>(visits);
+            const double mean = static_cast<double>(shared(nodes[i].points).load(memory_order_relaxed)) / (WIN_POINTS * n);
+            const double value = mean + config.exploration * sqrt(logVisits / n);
+            if (value > bestValue) {
+                bestValue = value;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    /** @brief Value a leaf by playing its position out. @return winning seat, -1 at the turn limit */
+    int evaluate(const Node& node, DiceSource& dice) const {
+        if (node.kind == Kind::Terminal) return node.owner;
+        GameState state = stateOf(node);
+        int sum = 0;
+        if (node.kind == Kind::Chance) sum = dice.rollDie() + (node.value == 2 ? dice.rollDie() : 0);
+        else if (node.kind == Kind::Sum) sum = node.value;
+        return RolloutSearch::playout(state, dice, config.greedyPlayouts, sum);
+    }
+
+    MctsConfig config; /**< settings */
+    uint32_t capacity; /**< nodes per arena */
+    unique_ptr<Node[]> nodes; /**< live arena */
+    unique_ptr<Node[]> spare; /**< arena the reused subtree is copied into */
+    atomic<uint32_t> size{0}; /**< nodes allocated from the live arena (may overshoot capacity when full) */
+    uint32_t chosen = NONE; /**< live arena index of the root child the last decision picked, or NONE */
+    vector<uint32_t> pending; /**< find()'s nodes still to visit, kept to reuse its buffer */
+    int boardSize = 0; /**< squares per board in the tree's positions */
+};
+
+/**
+ * @brief Construct a search; root parallelism gets one tree per worker, sharing maxNodes between them.
+ * @param config Settings
+ * @param pool Workers, or nullptr for the calling thread
+ */
+MctsSearch::MctsSearch(const MctsConfig& config, WorkStealingPool* pool) : config(config), pool(pool) {
+    if (this->config.budgetMs <= 0 && this->config.maxIterations == 0) this->config.budgetMs = MctsConfig{}.budgetMs;
+    if (this->config.maxNodes < 1 + MAX_CHILDREN) this->config.maxNodes = 1 + MAX_CHILDREN;
+    if (this->config.virtualLoss < 0) this->config.virtualLoss = 0;
+
+    const int workers = workerCount();
+    const int treeCount = this->config.parallelism == MctsConfig::Parallelism::Root ? workers : 1;
+    const size_t treeNodes = max<size_t>(this->config.maxNodes / static_cast<size_t>(treeCount), 1 + MAX_CHILDREN);
+    for (int t = 0; t < treeCount; ++t) trees.push_back(make_unique<Tree>(this->config, treeNodes));
+    paths.resize(static_cast<size_t>(workers));
+    counts.resize(static_cast<size_t>(workers));
+    for (vector<uint32_t>& path : paths) path.reserve(256);
+}
+
+MctsSearch::~MctsSearch() = default;
+
+/** @return Workers a decision runs on. */
+int MctsSearch::workerCount() const {
+    return pool ? max(pool->size(), 1) : 1;
+}
+
+/** @brief Drop the trees. */
+void MctsSearch::clear() {
+    for (const unique_ptr<Tree>& tree : trees) tree->clear();
+}
+
+/** @return Nodes in all arenas. */
+size_t MctsSearch::treeSize() const {
+    size_t total = 0;
+    for (const unique_ptr<Tree>& tree : trees) total += tree->used();
+    return total;
+}
+
+/**
+ * @brief Root every tree at the position.
+ * @param state Position
+ * @param sumRoot true for a move decision, false for a dice decision
+ * @param sum Rolled sum of a move decision
+ * @param result Receives reuse and expansion counts
+ */
+void MctsSearch::prepare(const GameState& state, const bool sumRoot, const int sum, MctsResult& result) {
+    for (const unique_ptr<Tree>& tree : trees) {
+        result.expansions += tree->setRoot(state, sumRoot ? Kind::Sum : Kind::Roll, sumRoot ? sum : 0);
+        result.reusedVisits += tree->root().visits;
+    }
+    result.treeSize = treeSize();
+}
+
+/**
+ * @brief Run iterations on every worker until the time budget or iteration cap is reached.
+ * @param result Receives iteration and expansion counts
+ */
+void MctsSearch::run(MctsResult& result) {
+    const uint64_t key = config.seed ^ (++decisions * 0x9E3779B97F4A7C15ull);
+    const bool timed = config.budgetMs > 0;
+    const auto deadline = chrono::steady_clock::now() + chrono::milliseconds(config.budgetMs);
+    const int workers = workerCount();
+    const bool rootParallel = trees.size() > 1;
+    const uint32_t virtualLoss = (!rootParallel && workers > 1) ? static_cast<uint32_t>(config.virtualLoss) : 0;
+    const size_t before = treeSize();
+
+    // Iteration i of a decision has its own dice stream for chance nodes and the
+    // playout, whichever worker runs it. A shared tree hands iterations out in
+    // order; each root-parallel tree is one work item that owns every
+    // trees.size()-th iteration, so a tree started late (its item stolen by a
+    // worker that finished another) still gets its share of an iteration cap,
+    // and at least one batch under a time budget.
+    atomic<uint64_t> nextIteration{0};
+    for (WorkerCount& count : counts) count.iterations = 0;
+    const auto work = [&](const uint64_t begin, const uint64_t end, const int worker) {
+        for (uint64_t item = begin; item < end; ++item) {
+            Tree& tree = *trees[rootParallel ? item : 0];
+            for (uint64_t local = 0;; ++local) {
+                if (timed && local > 0 && local % ITERATIONS_PER_CLOCK_CHECK == 0 &&
+                    chrono::steady_clock::now() >= deadline) break;
+                const uint64_t iteration = rootParallel ? item + local * trees.size()
+                                                        : nextIteration.fetch_add(1, memory_order_relaxed);
+                if (config.maxIterations > 0 && iteration >= config.maxIterations) break;
+                DiceSource dice(key, iteration);
+                tree.iterate(dice, virtualLoss, paths[worker]);
+                ++counts[worker].iterations;
+            }
+        }
+    };
+    if (pool && workers > 1) pool->parallelFor(rootParallel ? trees.size() : static_cast<uint64_t>(workers), 1, work);
+    else                     work(0, 1, 0);
+
+    for (const WorkerCount& count : counts) result.iterations += count.iterations;
+    result.treeSize = treeSize();
+    result.expansions += result.treeSize - before;
+}
+
+/**
+ * @brief The root child most visited over all trees.
+ * @param winRate Receives its mean result
+ * @return Its offset in the root's child block
+ */
+int MctsSearch::mostVisitedChild(double& winRate) const {
+    const int childCount = trees[0]->root().childCount;
+    int best = 0;
+    uint64_t bestVisits = 0, bestPoints = 0;
+    for (int c = 0; c < childCount; ++c) {
+        uint64_t visits = 0, points = 0;
+        for (const unique_ptr<Tree>& tree : trees) {
+            const Node& child = tree->at(tree->root().firstChild + static_cast<uint32_t>(c));
+            visits += child.visits;
+            points += child.points;
+        }
+        if (c == 0 || visits > bestVisits) {
+            best = c;
+            bestVisits = visits;
+            bestPoints = points;
+        }
+    }
+    winRate = bestVisits > 0 ? static_cast<double>(bestPoints) / (WIN_POINTS * static_cast<double>(bestVisits)) : 0.0;
+    return best;
+}
+
+/**
+ * @brief Note the chosen root child in every tree, where the next decision looks for its root.
+ * @param offset Child's position in the root's child block
+ */
+void MctsSearch::remember(const int offset) {
+    for (const unique_ptr<Tree>& tree : trees) tree->remember(static_cast<uint32_t>(offset));
+}
+
+/**
+ * @brief Search the dice decision.
+ * @param state Position before the roll
+ * @return Dice count and statistics
+ */
+MctsResult MctsSearch::chooseDiceCount(const GameState& state) {
+    MctsResult result;
+    if (!state.own().canThrowOneDie()) return result;
+
+    prepare(state, /*sumRoot=*/false, 0, result);
+    run(result);
+    const Tree& tree = *trees[0];
+    const int chosen = mostVisitedChild(result.winRate);
+    remember(chosen);
+    result.diceCount = tree.at(tree.root().firstChild + static_cast<uint32_t>(chosen)).value;
+    return result;
+}
+
+/**
+ * @brief Search the move decision for a rolled sum.
+ * @param state Position
+ * @param sum Dice sum
+ * @return Chosen move and statistics
+ */
+MctsResult MctsSearch::bestMove(const GameState& state, const int sum) {
+    MctsResult result;
+    prepare(state, /*sumRoot=*/true, sum, result);
+
+    const Tree& tree = *trees[0];
+    const Node& root = tree.root();
+    const auto moveOf = [&](const uint32_t offset) {
+        const Node& child = tree.at(root.firstChild + offset);
+        return StrategyResult{static_cast<StrategyResult::Action>(child.action), child.combo};
+    };
+    if (moveOf(0).action == StrategyResult::Action::None) {
+        remember(0);
+        return result;
+    }
+    for (uint32_t c = 0; c < root.childCount; ++c) {
+        if (tree.at(root.firstChild + c).kind == Kind::Terminal) {
+            result.move = moveOf(c);
+            result.winRate = 1.0;
+            return result;
+        }
+    }
+
+    if (root.childCount > 1) run(result);
+    const int chosen = mostVisitedChild(result.winRate);
+    remember(chosen);
+    result.move = moveOf(static_cast<uint32_t>(chosen));
+    return result;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file MoveTable.cpp
+ * @brief Builds the subset-sum move table and provides combination mask helpers.
+ */
+
+#include "../Header Files/MoveTable.h"
+#include <algorithm>
+#include <bit>
+
+using namespace std;
+
+/**
+ * @brief Enumerate every subset of 1..MAX_SUM once and file it under its sum.
+ */
+MoveTable::MoveTable() {
+    constexpr uint32_t subsets = uint32_t{1} << MAX_SUM;
+
+    for (uint32_t bits = 1; bits < subsets; ++bits) {
+        const uint32_t mask = bits << 1; // bit 0 of `bits` is square 1
+        int sum = 0;
+        for (uint32_t rest = mask; rest != 0; rest &= rest - 1) {
+            sum += countr_zero(rest);
+        }
+        if (sum <= MAX_SUM) {
+            table[sum][counts[sum]++] = mask;
+        }
+    }
+
+    for (int sum = 1; sum <= MAX_SUM; ++sum) {
+        sort(table[sum].begin(), table[sum].begin() + counts[sum], comboLess);
+    }
+}
+
+/**
+ * @brief Returns the shared table; construction happens once and is thread-safe.
+ * @return Reference to the table
+ */
+const MoveTable& MoveTable::instance() {
+    static const MoveTable moveTable;
+    return moveTable;
+}
+
+/**
+ * @brief Number of combinations for a sum.
+ * @param sum Dice sum
+ * @return Count of combinations, 0 for sums outside 1..MAX_SUM
+ */
+int MoveTable::count(const int sum) const {
+    return (sum >= 1 && sum <= MAX_SUM) ? counts[sum] : 0;
+}
+
+/**
+ * @brief Combination masks for a sum.
+ * @param sum Dice sum
+ * @return Pointer to the first mask (only count(sum) entries are meaningful)
+ */
+const uint32_t* MoveTable::combos(const int sum) const {
+    return (sum >= 1 && sum <= MAX_SUM) ? table[sum].data() : table[0].data();
+}
+
+/**
+ * @brief Decode a mask into the set of squares it contains.
+ * @param mask Combination mask
+ * @return Set of square indices
+ */
+set<int> MoveTable::toSet(uint32_t mask) {
+    set<int> combination;
+    for (; mask != 0; mask &= mask - 1) {
+        combination.insert(combination.end(), countr_zero(mask));
+    }
+    return combination;
+}
+
+/**
+ * @brief Encode a set of squares into a mask.
+ * @param combination Squares to encode
+ * @return Combination mask
+ */
+uint32_t MoveTable::toMask(const set<int>& combination) {
+    uint32_t mask = 0;
+    for (const int square : combination) {
+        if (square >= 1 && square <= 31) mask |= uint32_t{1} << square;
+    }
+    return mask;
+}
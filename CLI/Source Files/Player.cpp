@@ -12,8 +12,9 @@ using namespace std;
  * @brief Construct a Player with an associated board and human flag.
  * @param b Reference to the player's board
  * @param human true when the player is human
+ * @param context Advantage state and dice of the game
  */
-Player::Player(Board& b, const bool human) : board(b), isHuman(human) {}
+Player::Player(Board& b, const bool human, GameContext& context) : board(b), isHuman(human), context(context) {}
 
 /**
  * @brief Roll a die (or two) with optional manual entry for testing.
@@ -57,13 +58,13 @@ int Player::rollDie() const {
         }
     } else {
         if (choice == '1') {
-            diceSum = rand() % 6 + 1;
+            diceSum = context.getDice().rollDie();
             if (!isHuman) {
                 cout << "Computer rolls 1 die: " << diceSum << endl;
             }
         } else {
-            const int die1 = rand() % 6 + 1;
-            const int die2 = rand() % 6 + 1;
+            const int die1 = context.getDice().rollDie();
+            const int die2 = context.getDice().rollDie();
             diceSum = die1 + die2;
             if (!isHuman) {
                 cout << "Computer rolls 2 dice: " << die1 << " and " << die2 << endl;
@@ -87,12 +88,7 @@ const Board& Player::getBoard() const {
  * @return true when the one-die rule applies
  */
 bool Player::canThrowOneDie() const {
-    for (int i = 7; i <= board.getSize(); ++i) {
-        if (!board.isSquareCovered(i)) {
-            return false;
-        }
-    }
-    return true;
+    return board.canThrowOneDie();
 }
 
 /**
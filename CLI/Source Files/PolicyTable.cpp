@@ -0,0 +1,306 @@
+/**
+ * @file PolicyTable.cpp
+ * @brief Move encoding, checksums and the memory-mapped loader for solved
+ *        policy tables.
+ */
+
+#include "../Header Files/PolicyTable.h"
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../Header Files/Board.h"
+#include "../Header Files/MoveTable.h"
+#include "../Header Files/Solver.h"
+
+using namespace std;
+using namespace strategy;
+
+namespace {
+    static_assert(sizeof(PolicyTableHeader) == 80, "policy table header must keep its layout");
+    static_assert(endian::native == endian::little, "policy tables are mapped as they are laid out, which must be little-endian");
+
+    /**
+     * @brief Check a mapped header against the format and this build's rules.
+     * @param header Header at the start of the file
+     * @param fileSize Actual size of the file
+     * @param boardSize Required board size, or 0 for any
+     * @return nullptr when valid, otherwise the reason it is not
+     */
+    const char* validateHeader(const PolicyTableHeader& header, const uint64_t fileSize, const int boardSize) {
+        if (memcmp(header.magic, PolicyTable::MAGIC, sizeof(header.magic)) != 0) return "not a policy table";
+        if (header.version != PolicyTable::VERSION) return "unsupported format version";
+        if (PolicyTable::checksum(&header, offsetof(PolicyTableHeader, headerChecksum)) != header.headerChecksum) {
+            return "header checksum mismatch";
+        }
+        if (header.boardSize < 1 || header.boardSize > static_cast<uint32_t>(Solver::MAX_BOARD_SIZE)) {
+            return "unsupported board size";
+        }
+        if (boardSize != 0 && header.boardSize != static_cast<uint32_t>(boardSize)) return "wrong board size";
+        if (header.ruleFlags != (PolicyTable::RULE_ONE_DIE | PolicyTable::RULE_TURN_ENDS_ON_EMPTY)) {
+            return "solved with different rules";
+        }
+        if (header.movesPerState != PolicyTable::MOVES_PER_STATE) return "unexpected move record size";
+
+        const uint64_t count = header.stateCount;
+        const uint64_t a = PolicyTable::SECTION_ALIGNMENT;
+        if (count != uint64_t{1} << (2 * header.boardSize)) return "wrong position count";
+        if (header.fileSize != fileSize) return "file size does not match header";
+        if (header.valuesOffset % a || header.movesOffset % a || header.diceOffset % a) return "misaligned section";
+        if (header.valuesOffset < sizeof(PolicyTableHeader) ||
+            header.valuesOffset + count * sizeof(float) > header.movesOffset ||
+            header.movesOffset + count * PolicyTable::MOVES_PER_STATE > header.diceOffset ||
+            header.diceOffset + (count + 7) / 8 > header.fileSize) {
+            return "sections out of range";
+        }
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Store a move as its index in the move table plus an uncover flag.
+ * @param sum Dice sum
+ * @param move Move to encode
+ * @return Move byte, NO_MOVE when there is no move or it is not in the table
+ */
+uint8_t PolicyTable::encodeMove(const int sum, const StrategyResult& move) {
+    if (move.action == StrategyResult::Action::None) return NO_MOVE;
+    const MoveTable& moveTable = MoveTable::instance();
+    const uint32_t* combos = moveTable.combos(sum);
+    for (int i = 0; i < moveTable.count(sum); ++i) {
+        if (combos[i] == move.combo) {
+            const uint8_t uncover = move.action == StrategyResult::Action::Uncover ? UNCOVER_BIT : 0;
+            return static_cast<uint8_t>(i) | uncover;
+        }
+    }
+    return NO_MOVE;
+}
+
+/**
+ * @brief Recover a move from its byte.
+ * @param sum Dice sum
+ * @param code Move byte
+ * @return The move, Action::None when the byte does not name one
+ */
+StrategyResult PolicyTable::decodeMove(const int sum, const uint8_t code) {
+    const int index = code & COMBO_INDEX_MASK;
+    if (code == NO_MOVE || index >= MoveTable::instance().count(sum)) {
+        return {StrategyResult::Action::None, 0};
+    }
+    const StrategyResult::Action action =
+        (code & UNCOVER_BIT) ? StrategyResult::Action::Uncover : StrategyResult::Action::Cover;
+    return {action, MoveTable::instance().combos(sum)[index]};
+}
+
+/**
+ * @brief FNV-1a over a buffer.
+ * @param data Bytes to hash
+ * @param length Byte count
+ * @param hash Running hash
+ * @return Updated hash
+ */
+uint64_t PolicyTable::checksum(const void* data, const size_t length, uint64_t hash) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Map the table for a board size once per process.
+ * @param boardSize Squares per board
+ * @return The table, or nullptr when no valid table file exists
+ */
+const PolicyTable* PolicyTable::forBoardSize(const int boardSize) {
+    static PolicyTable tables[Solver::MAX_BOARD_SIZE + 1];
+    static once_flag opened[Solver::MAX_BOARD_SIZE + 1];
+    if (boardSize < 1 || boardSize > Solver::MAX_BOARD_SIZE) return nullptr;
+
+    call_once(opened[boardSize], [boardSize] {
+        const char* directory = getenv("CANOGA_POLICY_DIR");
+        filesystem::path path = (directory && *directory) ? filesystem::path(directory) : filesystem::path();
+        path /= "canoga_policy_" + to_string(boardSize) + ".bin";
+        // A missing table is normal (the heuristic strategy is used); a broken one is reported by open().
+        if (error_code ignored; filesystem::exists(path, ignored)) tables[boardSize].open(path.string(), boardSize);
+    });
+    return tables[boardSize].isOpen() ? &tables[boardSize] : nullptr;
+}
+
+/**
+ * @brief Unmap on destruction.
+ */
+PolicyTable::~PolicyTable() {
+    close();
+}
+
+/**
+ * @brief Map a table read-only and check its header; the sections are not read.
+ * @param filename Path of the table
+ * @param boardSize Required board size, or 0 for any
+ * @return true on success
+ */
+bool PolicyTable::open(const string& filename, const int boardSize) {
+    close();
+
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Unable to open policy table " << filename << endl;
+        return false;
+    }
+    struct stat info{};
+    void* base = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<uint64_t>(info.st_size) >= sizeof(PolicyTableHeader)) {
+        base = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd); // the mapping keeps the file alive
+    if (base == MAP_FAILED) {
+        cerr << "Unable to map policy table " << filename << endl;
+        return false;
+    }
+
+    const auto* mapped = static_cast<const PolicyTableHeader*>(base);
+    if (const char* problem = validateHeader(*mapped, static_cast<uint64_t>(info.st_size), boardSize)) {
+        munmap(base, static_cast<size_t>(info.st_size));
+        cerr << "Invalid policy table " << filename << ": " << problem << endl;
+        return false;
+    }
+
+    // Lookups jump around the table; don't let the kernel read ahead.
+    madvise(base, static_cast<size_t>(info.st_size), MADV_RANDOM);
+
+    const auto* bytes = static_cast<const unsigned char*>(base);
+    mapping    = base;
+    mappedSize = static_cast<size_t>(info.st_size);
+    header     = mapped;
+    values     = reinterpret_cast<const float*>(bytes + mapped->valuesOffset);
+    moves      = bytes + mapped->movesOffset;
+    dice       = bytes + mapped->diceOffset;
+    this->boardSize = static_cast<int>(mapped->boardSize);
+    fullMask   = ((uint32_t{1} << this->boardSize) - 1) << 1;
+    return true;
+}
+
+/**
+ * @brief Release the mapping.
+ */
+void PolicyTable::close() {
+    if (mapping) munmap(mapping, mappedSize);
+    mapping    = nullptr;
+    mappedSize = 0;
+    header     = nullptr;
+    values     = nullptr;
+    moves      = nullptr;
+    dice       = nullptr;
+    boardSize  = 0;
+    fullMask   = 0;
+}
+
+/**
+ * @brief Recompute the payload checksum.
+ * @return true when it matches the header
+ */
+bool PolicyTable::verifyPayload() const {
+    if (!isOpen()) return false;
+    const auto* bytes = static_cast<const unsigned char*>(mapping);
+    return checksum(bytes + header->valuesOffset, header->fileSize - header->valuesOffset) == header->payloadChecksum;
+}
+
+/**
+ * @brief Look up a position's value.
+ * @param myMask Mover's covered mask
+ * @param oppMask Opponent's covered mask
+ * @return Mover's win probability (0 when closed)
+ */
+double PolicyTable::value(const uint32_t myMask, const uint32_t oppMask) const {
+    if (!isOpen()) return 0.0;
+    return values[indexOf(myMask & fullMask, oppMask & fullMask)];
+}
+
+/**
+ * @brief Look up the dice choice.
+ * @param myMask Mover's covered mask
+ * @param oppMask Opponent's covered mask
+ * @return 1 when the table prefers one die, otherwise 2
+ */
+int PolicyTable::diceCount(const uint32_t myMask, const uint32_t oppMask) const {
+    if (!isOpen()) return 2;
+    const size_t index = indexOf(myMask & fullMask, oppMask & fullMask);
+    return (dice[index / 8] >> (index % 8)) & 1u ? 1 : 2;
+}
+
+/**
+ * @brief Look up the best move, re-ranking only when protection forbids the stored one.
+ * @param myMask Mover's covered mask
+ * @param oppMask Opponent's covered mask
+ * @param sum Dice sum
+ * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+ * @return Chosen move, Action::None when there is none
+ */
+StrategyResult PolicyTable::bestMove(const uint32_t myMask, const uint32_t oppMask, const int sum,
+                                     const int protectedSquare) const {
+    if (!isOpen() || sum < 1 || sum > MoveTable::MAX_SUM) return {StrategyResult::Action::None, 0};
+    const uint32_t mine = myMask & fullMask, theirs = oppMask & fullMask;
+
+    const StrategyResult stored =
+        decodeMove(sum, moves[indexOf(mine, theirs) * MOVES_PER_STATE + static_cast<size_t>(sum - 1)]);
+    const uint32_t guarded = protectedSquare > 0 ? Board::bitOf(protectedSquare) : 0;
+    if (stored.action != StrategyResult::Action::Uncover || (stored.combo & guarded) == 0) return stored;
+    return rankMoves(mine, theirs, sum, guarded);
+}
+
+/**
+ * @brief Stored value of the position a move leads to, for the mover.
+ * @param myMask Mover's covered mask
+ * @param oppMask Opponent's covered mask
+ * @param move A legal move
+ * @return Win probability in [0, 1] (0 when no table is open or there is no move)
+ */
+double PolicyTable::valueAfter(const uint32_t myMask, const uint32_t oppMask, const StrategyResult& move) const {
+    if (!isOpen() || move.action == StrategyResult::Action::None) return 0.0;
+    return successorValue(myMask & fullMask, oppMask & fullMask, move.combo & fullMask,
+                          move.action == StrategyResult::Action::Cover);
+}
+
+/**
+ * @brief Rank every legal move by the stored value of the position it leads to.
+ * @param mine Mover's covered mask
+ * @param theirs Opponent's covered mask
+ * @param sum Dice sum
+ * @param guarded Opponent squares that may not be uncovered
+ * @return Best move, Action::None when there is none
+ */
+StrategyResult PolicyTable::rankMoves(const uint32_t mine, const uint32_t theirs, const int sum,
+                                      const uint32_t guarded) const {
+    StrategyResult best{StrategyResult::Action::None, 0};
+    double bestValue = -1.0;
+    const MoveTable& moveTable = MoveTable::instance();
+    const uint32_t uncoverable = theirs & ~guarded;
+
+    for (int i = 0; i < moveTable.count(sum); ++i) {
+        const uint32_t combo = moveTable.combos(sum)[i];
+        if ((combo & ~fullMask) != 0) continue;
+        if ((combo & mine) == 0) {
+            const double v = successorValue(mine, theirs, combo, true);
+            if (v > bestValue) {
+                bestValue = v;
+                best = {StrategyResult::Action::Cover, combo};
+            }
+        }
+        if ((combo & ~uncoverable) == 0) {
+            const double v = successorValue(mine, theirs, combo, false);
+            if (v > bestValue) {
+                bestValue = v;
+                best = {StrategyResult::Action::Uncover, combo};
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file RolloutSearch.cpp
+ * @brief Monte Carlo move choice: candidate moves, playouts and the timed,
+ *        multithreaded playout loop.
+ */
+
+#include "../Header Files/RolloutSearch.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+#include "../Header Files/DiceSource.h"
+#include "../Header Files/Simulator.h"
+#include "../Header Files/TranspositionTable.h"
+#include "../Header Files/WorkStealingPool.h"
+
+using namespace std;
+using namespace strategy;
+
+namespace {
+    constexpr uint64_t FIRST_BATCH = 8; /**< Playouts per candidate in the first round */
+    constexpr uint64_t MAX_BATCH = 1024; /**< Largest round, so the budget is checked regularly */
+    constexpr uint64_t PLAYOUTS_PER_CHUNK = 8; /**< Playouts between deadline checks */
+    constexpr uint32_t PRIOR_PLAYOUTS = 64; /**< Most playouts a transposition table value adds to a candidate */
+
+    /** @brief Per-worker playout tallies, padded so workers never share a cache line. */
+    struct alignas(64) WorkerTally {
+        array<uint64_t, RolloutSearch::MAX_CANDIDATES> points{}; /**< 2 per win, 1 per unfinished playout */
+        array<uint64_t, RolloutSearch::MAX_CANDIDATES> plays{}; /**< playouts run */
+    };
+
+    /** @brief A uniformly random legal move for the mover, Action::None when there is none. */
+    StrategyResult randomMove(const GameState& state, const int sum, DiceSource& dice) {
+        const MoveList covers = state.own().findValidMoves(sum, /*forCovering=*/true);
+        MoveList uncovers = state.opponent().findValidMoves(sum, /*forCovering=*/false);
+        if (state.protectedSquare > 0) uncovers.removeTouching(state.protectedSquare);
+
+        const uint32_t total = static_cast<uint32_t>(covers.size() + uncovers.size());
+        if (total == 0) return {StrategyResult::Action::None, 0};
+        const int pick = static_cast<int>(dice.uniform(total));
+        if (pick < covers.size()) return {StrategyResult::Action::Cover, covers[pick]};
+        return {StrategyResult::Action::Uncover, uncovers[pick - covers.size()]};
+    }
+
+    /**
+     * @brief Apply a non-winning move, ending the turn as Round::outcomeOfMove does.
+     */
+    void playMove(GameState& state, const StrategyResult& move, DiceSource& dice) {
+        state.makeMove(move);
+        if (state.opponent().allUncovered()) {
+            state.passTurn();
+            dice.nextTurn();
+        }
+    }
+}
+
+/**
+ * @brief Construct a search.
+ * @param config Settings
+ * @param pool Workers, or nullptr for the calling thread
+ */
+RolloutSearch::RolloutSearch(const RolloutConfig& config, WorkStealingPool* pool) : config(config), pool(pool) {
+    if (this->config.budgetMs <= 0 && this->config.maxPlayouts == 0) this->config.budgetMs = RolloutConfig{}.budgetMs;
+}
+
+/**
+ * @brief Play out a position with the greedy or random policy.
+ * @param state Position; modified
+ * @param dice Dice for the playout
+ * @param greedy Greedy moves rather than random ones
+ * @param firstSum Sum already rolled by the mover, 0 for none
+ * @return Winning seat, or -1 at the turn limit
+ */
+int RolloutSearch::playout(GameState& state, DiceSource& dice, const bool greedy, int firstSum) {
+    for (int turn = 0; turn < Simulator::MAX_TURNS_PER_ROUND;) {
+        int sum = firstSum;
+        firstSum = 0;
+        if (sum == 0) {
+            const int diceCount = chooseDiceCount(state.own());
+            sum = dice.rollDie() + (diceCount == 2 ? dice.rollDie() : 0);
+        }
+        const StrategyResult move = greedy
+            ? computeBestMove(sum, state.own(), state.opponent(), state.protectedSquare)
+            : randomMove(state, sum, dice);
+
+        if (move.action == StrategyResult::Action::None) {
+            state.passTurn();
+            dice.nextTurn();
+            ++turn;
+            continue;
+        }
+        if (state.isWinningMove(move)) return state.mover;
+        const int mover = state.mover;
+        playMove(state, move, dice);
+        if (state.mover != mover) ++turn;
+    }
+    return -1;
+}
+
+/**
+ * @brief Score every legal move by playouts and return the best.
+ * @param state Position
+ * @param sum Dice sum
+ * @return Chosen move and statistics
+ */
+RolloutResult RolloutSearch::bestMove(const GameState& state, const int sum) const {
+    RolloutResult result;
+
+    // The greedy choice goes first so that it wins ties (and stands when no playout finished in time).
+    const StrategyResult greedy = computeBestMove(sum, state.own(), state.opponent(), state.protectedSquare);
+    if (greedy.action == StrategyResult::Action::None) return result;
+
+    array<StrategyResult, MAX_CANDIDATES> candidates;
+    int count = 0;
+    candidates[count++] = greedy;
+    MoveList uncovers = state.opponent().findValidMoves(sum, /*forCovering=*/false);
+    if (state.protectedSquare > 0) uncovers.removeTouching(state.protectedSquare);
+    for (const uint32_t combo : state.own().findValidMoves(sum, /*forCovering=*/true)) {
+        if (greedy.action != StrategyResult::Action::Cover || combo != greedy.combo) {
+            candidates[count++] = {StrategyResult::Action::Cover, combo};
+        }
+    }
+    for (const uint32_t combo : uncovers) {
+        if (greedy.action != StrategyResult::Action::Uncover || combo != greedy.combo) {
+            candidates[count++] = {StrategyResult::Action::Uncover, combo};
+        }
+    }
+    result.candidates = count;
+    result.move = greedy;
+
+    for (int c = 0; c < count; ++c) {
+        if (state.isWinningMove(candidates[c])) {
+            result.move = candidates[c];
+            result.winRate = 1.0;
+            return result;
+        }
+    }
+    if (count == 1) return result;
+
+    // Table values are from the side of whoever moves in the candidate's position.
+    array<uint64_t, MAX_CANDIDATES> positionKeys{};
+    array<bool, MAX_CANDIDATES> opponentMoves{};
+    array<TranspositionTable::Entry, MAX_CANDIDATES> priors{};
+    if (config.table) {
+        for (int c = 0; c < count; ++c) {
+            GameState position = state;
+            position.makeMove(candidates[c]);
+            if (position.opponent().allUncovered()) position.passTurn();
+            positionKeys[c] = position.hash;
+            opponentMoves[c] = position.mover != state.mover;
+            if (config.table->probe(position.hash, priors[c])) {
+                priors[c] = priors[c].cappedAt(PRIOR_PLAYOUTS);
+                if (opponentMoves[c]) priors[c] = priors[c].flipped();
+            }
+        }
+    }
+
+    // Playout k of every candidate rolls the same dice: key = (seed, position), game = k.
+    const uint64_t key = config.seed ^ static_cast<uint64_t>(sum) ^
+        ((uint64_t{state.own().getCoveredMask()} << 32 | state.opponent().getCoveredMask()) * 0x9E3779B97F4A7C15ull);
+    const bool timed = config.budgetMs > 0;
+    const auto deadline = chrono::steady_clock::now() + chrono::milliseconds(config.budgetMs);
+    vector<WorkerTally> tallies(pool ? pool->size() : 1);
+
+    uint64_t scheduled = 0; // playouts per candidate issued so far
+    uint64_t batch = FIRST_BATCH;
+    while (true) {
+        if (config.maxPlayouts > 0) batch = min(batch, config.maxPlayouts - scheduled);
+        const uint64_t first = scheduled;
+        const auto runPlayouts = [&](const uint64_t begin, const uint64_t end, const int worker) {
+            if (timed && chrono::steady_clock::now() >= deadline) return;
+            WorkerTally& tally = tallies[worker];
+            for (uint64_t i = begin; i < end; ++i) {
+                const int c = static_cast<int>(i % static_cast<uint64_t>(count));
+                DiceSource dice(key, first + i / static_cast<uint64_t>(count));
+                GameState position = state;
+                playMove(position, candidates[c], dice);
+                const int winner = playout(position, dice, config.greedyPlayouts);
+                tally.points[c] += winner == state.mover ? 2 : (winner < 0 ? 1 : 0);
+                ++tally.plays[c];
+            }
+        };
+
+        const uint64_t items = batch * static_cast<uint64_t>(count);
+        if (pool) {
+            pool->parallelFor(items, PLAYOUTS_PER_CHUNK, runPlayouts);
+        } else {
+            for (uint64_t begin = 0; begin < items; begin += PLAYOUTS_PER_CHUNK) {
+                runPlayouts(begin, min(items, begin + PLAYOUTS_PER_CHUNK), 0);
+            }
+        }
+        scheduled += batch;
+
+        if (timed && chrono::steady_clock::now() >= deadline) break;
+        if (config.maxPlayouts > 0 && scheduled >= config.maxPlayouts) break;
+        batch = min(batch * 2, MAX_BATCH);
+    }
+
+    double bestRate = -1.0;
+    for (int c = 0; c < count; ++c) {
+        uint64_t points = 0, plays = 0;
+        for (const WorkerTally& tally : tallies) {
+            points += tally.points[c];
+            plays += tally.plays[c];
+        }
+        result.playouts += plays;
+        points += priors[c].points;
+        plays += priors[c].samples;
+        if (plays == 0) continue;
+        if (config.table) {
+            const TranspositionTable::Entry entry{static_cast<uint32_t>(min<uint64_t>(points, UINT32_MAX)),
+                                                  static_cast<uint32_t>(min<uint64_t>(plays, UINT32_MAX / 2))};
+            config.table->store(positionKeys[c], opponentMoves[c] ? entry.flipped() : entry);
+        }
+        const double rate = static_cast<double>(points) / (2.0 * static_cast<double>(plays));
+        if (rate > bestRate) {
+            bestRate = rate;
+            result.move = candidates[c];
+            result.winRate = rate;
+        }
+    }
+    return result;
+}
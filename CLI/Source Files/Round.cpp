@@ -5,10 +5,10 @@
 
 #include "../Header Files/Round.h"
 #include <iostream>
-#include <stdlib.h>
 #include <limits>
 #include <cctype>
 #include "../Header Files/Player.h"
+#include "../Header Files/Strategy.h"
 #include "../Header Files/Tournament.h"
 #include "../Header Files/BoardView.h"
 #include "../Header Files/TextUI.h"
@@ -32,13 +32,14 @@ Round::Round(Player& p1, Player& p2, Tournament& tournament, const bool isANewGa
  * @return Reference to the Player who won the toss (goes first)
  */
 Player& Round::determineFirstPlayer() const {
+    DiceSource& dice = tournament.getContext().getDice();
     int player1Roll, player2Roll;
 
     do {
-        player1Roll = (rand() % 6 + 1) + (rand() % 6 + 1);
+        player1Roll = dice.rollDie() + dice.rollDie();
         cout << "Human rolled: " << player1Roll << endl;
 
-        player2Roll = (rand() % 6 + 1) + (rand() % 6 + 1);
+        player2Roll = dice.rollDie() + dice.rollDie();
         cout << "Computer rolled: " << player2Roll << endl;
 
         if (player1Roll > player2Roll) {
@@ -112,19 +113,22 @@ void Round::play() const {
         cout << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n\n";
     }
 
+    GameContext& context = tournament.getContext();
+    journalRoundStart();
+
     section("Starting Board State");
     BoardView humanView(player1.getBoard(), "Human");
     BoardView compView (player2.getBoard(), "Computer");
 
     compView.display (
-    Tournament::getAdvantageApplied() &&
-    Tournament::getAdvantageOwner() == Tournament::Side::Computer,
-    Tournament::getAdvantageSquare());
+    context.getAdvantageApplied() &&
+    context.getAdvantageOwner() == GameContext::Side::Computer,
+    context.getAdvantageSquare());
 
     humanView.display(
-        Tournament::getAdvantageApplied() &&
-        Tournament::getAdvantageOwner() == Tournament::Side::Human,
-        Tournament::getAdvantageSquare());
+        context.getAdvantageApplied() &&
+        context.getAdvantageOwner() == GameContext::Side::Human,
+        context.getAdvantageSquare());
 
     std::cout << "\n";
 
@@ -133,20 +137,21 @@ void Round::play() const {
     int movesSinceLastCheck = 0;
 
     while (true) {
-        // Step 1: Execute Turn
+        // Step 1: Execute Turn (each turn draws from its own dice stream)
+        context.getDice().nextTurn();
         currentPlayer->takeTurn();
 
         // Step 2: Handle Advantage Protection Expiry
         // Protection should expire after the OPPONENT of the advantage owner has completed their turn.
         // That means we clear the protection when the player who just played is the opponent
         // (i.e. currentPlayer is NOT the advantage owner).
-        if (Tournament::getAdvantageApplied()) {
-            if (Tournament::getAdvantageOwner() == Tournament::Side::Human && !currentPlayer->getIsHuman()) {
+        if (context.getAdvantageApplied()) {
+            if (context.getAdvantageOwner() == GameContext::Side::Human && !currentPlayer->getIsHuman()) {
                 // Human had advantage; opponent (computer) just played -> clear human protection
-                Tournament::clearAdvantageProtectionForHuman();
-            } else if (Tournament::getAdvantageOwner() == Tournament::Side::Computer && currentPlayer->getIsHuman()) {
+                context.clearAdvantageProtectionForHuman();
+            } else if (context.getAdvantageOwner() == GameContext::Side::Computer && currentPlayer->getIsHuman()) {
                 // Computer had advantage; opponent (human) just played -> clear computer protection
-                Tournament::clearAdvantageProtectionForComputer();
+                context.clearAdvantageProtectionForComputer();
             }
         }
 
@@ -197,11 +202,36 @@ void Round::play() const {
             cout << "Enter the filename to save: ";
             cin >> filename;
             tournament.saveGame(filename);
+            if (GameJournal* journal = context.getJournal()) journal->flush();
             exit(0);
         }
     }
 }
 
+/**
+ * @brief Record how the round starts: board size, both boards and tournament
+ *        scores, any advantage in play and who moved first.
+ */
+void Round::journalRoundStart() const {
+    const GameContext& context = tournament.getContext();
+    if (!context.getJournal()) return;
+
+    using Side = GameContext::Side;
+    const SavedGame start = tournament.snapshot();
+    context.record(JournalEvent::RoundStart, Side::None, start.boardSize, 0, isANewGame ? 0 : JOURNAL_RESUMED);
+    context.record(JournalEvent::Position, Side::Human, 0, start.humanMask);
+    context.record(JournalEvent::Position, Side::Computer, 0, start.computerMask);
+    context.record(JournalEvent::Score, Side::Human, 0, static_cast<uint32_t>(start.humanScore));
+    context.record(JournalEvent::Score, Side::Computer, 0, static_cast<uint32_t>(start.computerScore));
+    if (start.advantage.applied) {
+        const bool protectedNow = start.advantage.owner == Side::Human ? start.advantage.protectHuman
+                                                                       : start.advantage.protectComputer;
+        context.record(JournalEvent::Advantage, start.advantage.owner, start.advantage.square, 0,
+                       protectedNow ? JOURNAL_PROTECTED : 0);
+    }
+    context.record(JournalEvent::FirstPlayer, start.firstPlayerIsHuman ? Side::Human : Side::Computer);
+}
+
 /**
  * @brief Checks whether any of the win conditions for the round are met.
  * @return true if the round is over
@@ -211,52 +241,64 @@ bool Round::isRoundOver() const {
            player1.getBoard().allUncovered() || player2.getBoard().allUncovered();
 }
 
+/**
+ * @brief Apply the win and scoring rules to the mover's and opponent's masks.
+ * @param own Mover's covered squares after the move
+ * @param opponent Opponent's covered squares after the move
+ * @param fullMask Every square of a board
+ * @param covering Whether the move covered
+ * @return The outcome
+ */
+Round::MoveOutcome Round::outcomeOfMove(const uint32_t own, const uint32_t opponent, const uint32_t fullMask,
+                                        const bool covering) {
+    if (own == fullMask) return {true, true, strategy::sumOf(fullMask & ~opponent), false};
+    if (opponent == 0 && !covering) return {true, false, strategy::sumOf(own), false};
+    return {false, false, 0, opponent == 0};
+}
+
+/**
+ * @brief Apply declareWinner's scoring rules to a pair of boards.
+ * @param human The Human's board
+ * @param computer The Computer's board
+ * @return The outcome
+ */
+Round::Outcome Round::outcomeOf(const Board& human, const Board& computer) {
+    using Side = GameContext::Side;
+    const uint32_t humanMask = human.getCoveredMask(), computerMask = computer.getCoveredMask();
+    const MoveOutcome forHuman = outcomeOfMove(humanMask, computerMask, human.getFullMask(), /*covering=*/false);
+    if (forHuman.won) return {Side::Human, forHuman.byCover, forHuman.score};
+    const MoveOutcome forComputer = outcomeOfMove(computerMask, humanMask, computer.getFullMask(), /*covering=*/false);
+    if (forComputer.won) return {Side::Computer, forComputer.byCover, forComputer.score};
+    return {};
+}
+
 /**
  * @brief Determine which side won and update the tournament accordingly; also display messages.
  * @param currentPlayer Pointer to the player that most recently moved
  * @param winnerWasFirstPlayer True if the winner had been the first player this round
  */
 void Round::declareWinner(const Player* currentPlayer, const bool winnerWasFirstPlayer) const {
+    const GameContext& context = tournament.getContext();
 
     cout << "\n\n~~~~~~~~~~~~[Round Over]~~~~~~~~~~~~" << endl;
-    if (player1.getBoard().allCovered()) {
-        // Human wins by covering all own squares
-        int score = player2.getBoard().getUncoveredSum();
-        cout << "Human wins by covering all their squares! (+" << score << " points)" << endl;
-        tournament.updateScores(true, false, false, false,
-                                player1.getBoard().getCoveredSum(),
-                                score);
-        tournament.applyHandicap(winnerWasFirstPlayer, /*winnerIsHuman=*/true, score);
-
-    } else if (player2.getBoard().allCovered()) {
-        // Computer wins by covering all own squares
-        int score = player1.getBoard().getUncoveredSum();
-        cout << "Computer wins by covering all their squares! (+" << score << " points)" << endl;
-        tournament.updateScores(false, false, true, false,
-                                score,
-                                player2.getBoard().getCoveredSum());
-        tournament.applyHandicap(winnerWasFirstPlayer, /*winnerIsHuman=*/false, score);
-
-    } else if (player2.getBoard().allUncovered()) {
-        // Human wins by uncovering all computer squares
-        int score = player1.getBoard().getCoveredSum();
+    const Outcome outcome = outcomeOf(player1.getBoard(), player2.getBoard());
+    if (outcome.winner == GameContext::Side::None) return;
+
+    const bool humanWon = outcome.winner == GameContext::Side::Human;
+    const int score = outcome.score;
+    if (outcome.byCover) {
+        cout << (humanWon ? "Human" : "Computer") << " wins by covering all their squares! (+" << score << " points)" << endl;
+    } else if (humanWon) {
         cout << "Human wins by uncovering all the computer's squares! (+" << score << " points)" << endl;
-        tournament.updateScores(false, true, false, false,
-                                score,
-                                0);
-        tournament.applyHandicap(winnerWasFirstPlayer,
-                                 /*winnerIsHuman=*/true,
-                                 score);
-
-    } else if (player1.getBoard().allUncovered()) {
-        // Computer wins by uncovering all human squares
-        int score = player2.getBoard().getCoveredSum();
+    } else {
         cout << "Computer wins by uncovering all the human's squares! (+" << score << " points)" << endl;
-        tournament.updateScores(false, false, false, true,
-                                0,
-                                score);
-        tournament.applyHandicap(winnerWasFirstPlayer,
-                                 /*winnerIsHuman=*/false,
-                                 score);
     }
+
+    // updateScores reads the points of the winning case from the matching argument.
+    tournament.updateScores(humanWon && outcome.byCover, humanWon && !outcome.byCover,
+                            !humanWon && outcome.byCover, !humanWon && !outcome.byCover,
+                            score, score);
+    context.record(JournalEvent::RoundEnd, outcome.winner, 0, static_cast<uint32_t>(score),
+                   outcome.byCover ? JOURNAL_BY_COVER : 0);
+    tournament.applyHandicap(winnerWasFirstPlayer, humanWon, score);
 }
\ No newline at end of file
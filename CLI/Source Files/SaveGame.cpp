@@ -0,0 +1,353 @@
+/**
+ * @file SaveGame.cpp
+ * @brief Text and binary encodings of SavedGame and the save file I/O.
+ */
+
+#include "../Header Files/SaveGame.h"
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include "../Header Files/Board.h"
+
+using namespace std;
+
+namespace {
+    static_assert(sizeof(SaveFileRecord) == 64, "binary save record must keep its layout");
+    static_assert(endian::native == endian::little, "binary saves are copied to and from memory, which must be little-endian");
+
+    using Side = GameContext::Side;
+
+    /** @brief CRC-32 lookup table for the reflected IEEE polynomial. */
+    constexpr array<uint32_t, 256> CRC_TABLE = [] {
+        array<uint32_t, 256> table{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320u : 0u);
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    /** @return Whether a value is one of the Side enumerators. */
+    bool isSide(const Side side) {
+        return side == Side::None || side == Side::Human || side == Side::Computer;
+    }
+
+    /** @return The side a saved name stands for (Side::None for anything else). */
+    Side sideNamed(const string& name) {
+        return name == "Human" ? Side::Human : name == "Computer" ? Side::Computer : Side::None;
+    }
+
+    /** @return The name a side is saved under. */
+    const char* sideName(const Side side) {
+        switch (side) {
+            case Side::Human:    return "Human";
+            case Side::Computer: return "Computer";
+            default:             return "None";
+        }
+    }
+
+    /** @brief Write one board's "Squares:" line, 0 for a covered square. */
+    void writeSquares(ostream& out, const int boardSize, const uint32_t mask) {
+        out << "   Squares: ";
+        for (int i = 1; i <= boardSize; ++i) {
+            if (mask & Board::bitOf(i)) {
+                out << "0 ";
+            } else {
+                out << i << " ";
+            }
+        }
+        out << endl;
+    }
+
+    /**
+     * @brief Parse a "Squares:" line into a covered mask.
+     * @param line The line
+     * @param boardSize Squares expected, or 0 to take the count from the line
+     * @param mask Receives the covered squares
+     * @return The number of squares read
+     */
+    int readSquares(const string& line, const int boardSize, uint32_t& mask) {
+        const size_t colon = line.find(':');
+        stringstream ss(colon == string::npos ? string() : line.substr(colon + 1));
+        mask = 0;
+        int count = 0;
+        for (int v; (boardSize == 0 || count < boardSize) && count < Board::MAX_SIZE && ss >> v;) {
+            ++count;
+            if (v == 0) mask |= Board::bitOf(count);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Parse a "Score:" line.
+     * @return false when the line holds no number
+     */
+    bool readScore(const string& line, int& score) {
+        const size_t colon = line.find(':');
+        return colon != string::npos && (stringstream(line.substr(colon + 1)) >> score);
+    }
+
+    /** @return nullptr when a game's fields are a position the tournament can resume, otherwise why not. */
+    const char* validate(const SavedGame& game) {
+        if (game.boardSize < 1 || game.boardSize > Board::MAX_SIZE) return "unsupported board size";
+        const uint32_t fullMask = Board(game.boardSize).getFullMask();
+        if ((game.computerMask & ~fullMask) != 0 || (game.humanMask & ~fullMask) != 0) return "square out of range";
+        if (!isSide(game.pendingAdvantageFor) || !isSide(game.advantage.owner)) return "unknown advantage side";
+        if (game.pendingAdvantageFor == Side::None && game.pendingAdvantageSquare != 0) return "advantage square without a side";
+        if (game.pendingAdvantageSquare < 0 || game.pendingAdvantageSquare > UINT8_MAX ||
+            game.advantage.square < 0 || game.advantage.square > UINT8_MAX) {
+            return "advantage square out of range";
+        }
+        return nullptr;
+    }
+}
+
+/**
+ * @param filename Path of the save
+ * @return The format the name's extension selects
+ */
+savegame::Format savegame::formatFor(const string& filename) {
+    const size_t length = strlen(BINARY_EXTENSION);
+    return filename.size() >= length && filename.compare(filename.size() - length, length, BINARY_EXTENSION) == 0
+        ? Format::Binary : Format::Text;
+}
+
+/**
+ * @brief Table-driven CRC-32 over a buffer.
+ * @param data Bytes to checksum
+ * @param length Number of bytes
+ * @param crc Running CRC
+ * @return Updated CRC
+ */
+uint32_t savegame::crc32(const void* data, const size_t length, uint32_t crc) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) crc = CRC_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+/**
+ * @brief Write the boards, scores and turns, then the queued and active
+ *        advantage and the dice position. Readers of the original format skip
+ *        the later lines.
+ * @param out Destination stream
+ * @param game Game to write
+ */
+void savegame::writeText(ostream& out, const SavedGame& game) {
+    out << "Computer:" << endl;
+    writeSquares(out, game.boardSize, game.computerMask);
+    out << "   Score: " << game.computerScore << endl;
+
+    out << "Human:" << endl;
+    writeSquares(out, game.boardSize, game.humanMask);
+    out << "   Score: " << game.humanScore << endl;
+
+    out << "First Turn: " << (game.firstPlayerIsHuman ? "Human" : "Computer") << endl;
+    out << "Next Turn: " << (game.isHumanTurn ? "Human" : "Computer") << endl;
+    out << "Pending Advantage: " << game.pendingAdvantageSquare << " " << sideName(game.pendingAdvantageFor) << endl;
+
+    const GameContext::AdvantageState& advantage = game.advantage;
+    out << "Advantage Square: " << advantage.square << endl;
+    out << "Advantage Owner: " << sideName(advantage.owner) << endl;
+    out << "Advantage Applied: " << (advantage.applied ? "Yes" : "No") << endl;
+    out << "Advantage Protected:";
+    if (advantage.protectHuman)    out << " Human";
+    if (advantage.protectComputer) out << " Computer";
+    if (!advantage.protectHuman && !advantage.protectComputer) out << " None";
+    out << endl;
+    if (game.diceSaved) {
+        out << "Dice: " << game.diceSeed << " " << game.diceGameId << " " << game.diceTurn << endl;
+    }
+}
+
+/**
+ * @brief Parse the text format. The Computer's squares set the board size;
+ *        lines may come in any order after that and unknown lines are skipped.
+ * @param in Source stream
+ * @param game Receives the game
+ * @return nullptr on success, otherwise why the text was rejected
+ */
+const char* savegame::readText(istream& in, SavedGame& game) {
+    SavedGame loaded;
+    string line;
+    while (getline(in, line)) {
+        if (line.find("Computer:") != string::npos) {
+            if (!getline(in, line)) return "missing Computer squares";
+            loaded.boardSize = readSquares(line, 0, loaded.computerMask);
+            if (!getline(in, line) || !readScore(line, loaded.computerScore)) return "missing Computer score";
+        } else if (line.find("Human:") != string::npos) {
+            if (loaded.boardSize == 0) return "Human board before Computer board";
+            if (!getline(in, line)) return "missing Human squares";
+            if (readSquares(line, loaded.boardSize, loaded.humanMask) != loaded.boardSize) return "boards differ in size";
+            if (!getline(in, line) || !readScore(line, loaded.humanScore)) return "missing Human score";
+        } else if (line.rfind("First Turn:", 0) == 0) {
+            loaded.firstPlayerIsHuman = (line.find("Human") != string::npos);
+        } else if (line.rfind("Next Turn:", 0) == 0) {
+            loaded.isHumanTurn = (line.find("Human") != string::npos);
+        } else if (line.rfind("Pending Advantage:", 0) == 0) {
+            stringstream ss(line.substr(line.find(':') + 1));
+            string side;
+            if (!(ss >> loaded.pendingAdvantageSquare >> side)) return "malformed pending advantage";
+            loaded.pendingAdvantageFor = sideNamed(side);
+        } else if (line.rfind("Advantage Square:", 0) == 0) {
+            if (!(stringstream(line.substr(line.find(':') + 1)) >> loaded.advantage.square)) return "malformed advantage square";
+        } else if (line.rfind("Advantage Owner:", 0) == 0) {
+            string side;
+            stringstream(line.substr(line.find(':') + 1)) >> side;
+            loaded.advantage.owner = sideNamed(side);
+        } else if (line.rfind("Advantage Applied:", 0) == 0) {
+            loaded.advantage.applied = (line.find("Yes") != string::npos);
+        } else if (line.rfind("Advantage Protected:", 0) == 0) {
+            loaded.advantage.protectHuman    = (line.find("Human") != string::npos);
+            loaded.advantage.protectComputer = (line.find("Computer") != string::npos);
+        } else if (line.rfind("Dice:", 0) == 0) {
+            stringstream ss(line.substr(line.find(':') + 1));
+            if (!(ss >> loaded.diceSeed >> loaded.diceGameId >> loaded.diceTurn)) return "malformed dice position";
+            loaded.diceSaved = true;
+        }
+    }
+    if (loaded.boardSize == 0) return "no Computer board";
+    if (const char* error = validate(loaded)) return error;
+    game = loaded;
+    return nullptr;
+}
+
+/**
+ * @brief Fill a record's fields and checksum.
+ * @param game Game to encode
+ * @return The record
+ */
+SaveFileRecord savegame::toRecord(const SavedGame& game) {
+    SaveFileRecord record{};
+    copy(begin(MAGIC), end(MAGIC), record.magic);
+    record.version                = VERSION;
+    record.boardSize              = static_cast<uint32_t>(game.boardSize);
+    record.computerMask           = game.computerMask;
+    record.humanMask              = game.humanMask;
+    record.computerScore          = game.computerScore;
+    record.humanScore             = game.humanScore;
+    record.turnFlags              = static_cast<uint8_t>((game.firstPlayerIsHuman ? TURN_FIRST_PLAYER_HUMAN : 0) |
+                                                         (game.isHumanTurn ? TURN_HUMAN_TO_MOVE : 0));
+    record.pendingAdvantageFor    = static_cast<uint8_t>(game.pendingAdvantageFor);
+    record.pendingAdvantageSquare = static_cast<uint8_t>(game.pendingAdvantageSquare);
+    record.advantageOwner         = static_cast<uint8_t>(game.advantage.owner);
+    record.advantageSquare        = static_cast<uint8_t>(game.advantage.square);
+    record.stateFlags             = static_cast<uint8_t>((game.advantage.applied ? STATE_ADVANTAGE_APPLIED : 0) |
+                                                         (game.advantage.protectHuman ? STATE_PROTECT_HUMAN : 0) |
+                                                         (game.advantage.protectComputer ? STATE_PROTECT_COMPUTER : 0) |
+                                                         (game.diceSaved ? STATE_DICE_SAVED : 0));
+    record.diceSeed               = game.diceSeed;
+    record.diceGameId             = game.diceGameId;
+    record.diceTurn               = game.diceTurn;
+    record.crc                    = crc32(&record, offsetof(SaveFileRecord, crc));
+    return record;
+}
+
+/**
+ * @brief Check the signature, version, size and CRC before trusting any field.
+ *        A version 1 record is widened to the current layout once its CRC checks.
+ * @param data File contents
+ * @param length Size of the contents
+ * @param game Receives the game
+ * @return nullptr on success, otherwise why the data was rejected
+ */
+const char* savegame::fromBinary(const void* data, const size_t length, SavedGame& game) {
+    SaveFileRecord record{};
+    if (length < offsetof(SaveFileRecord, boardSize) || memcmp(data, MAGIC, sizeof(MAGIC)) != 0) return "not a binary save";
+    memcpy(&record, data, offsetof(SaveFileRecord, boardSize));
+    if (record.version == 1) {
+        // Version 1 stopped at the queued advantage; its CRC follows directly.
+        constexpr size_t crcOffset = offsetof(SaveFileRecord, advantageOwner);
+        if (length != VERSION_1_SIZE) return "wrong record size";
+        memcpy(&record, data, crcOffset);
+        memcpy(&record.crc, static_cast<const char*>(data) + crcOffset, sizeof(record.crc));
+        if (crc32(&record, crcOffset) != record.crc) return "CRC mismatch";
+    } else if (record.version == VERSION) {
+        if (length != sizeof(record)) return "wrong record size";
+        memcpy(&record, data, sizeof(record));
+        if (crc32(&record, offsetof(SaveFileRecord, crc)) != record.crc) return "CRC mismatch";
+    } else {
+        return "unsupported format version";
+    }
+    if ((record.turnFlags & ~(TURN_FIRST_PLAYER_HUMAN | TURN_HUMAN_TO_MOVE)) != 0 ||
+        (record.stateFlags & ~(STATE_ADVANTAGE_APPLIED | STATE_PROTECT_HUMAN | STATE_PROTECT_COMPUTER | STATE_DICE_SAVED)) != 0 ||
+        record.reserved != 0 || record.reserved2 != 0) {
+        return "unknown flags";
+    }
+    if (record.boardSize > static_cast<uint32_t>(Board::MAX_SIZE)) return "unsupported board size";
+
+    SavedGame loaded;
+    loaded.boardSize              = static_cast<int>(record.boardSize);
+    loaded.computerMask           = record.computerMask;
+    loaded.humanMask              = record.humanMask;
+    loaded.computerScore          = record.computerScore;
+    loaded.humanScore             = record.humanScore;
+    loaded.firstPlayerIsHuman     = (record.turnFlags & TURN_FIRST_PLAYER_HUMAN) != 0;
+    loaded.isHumanTurn            = (record.turnFlags & TURN_HUMAN_TO_MOVE) != 0;
+    loaded.pendingAdvantageFor    = static_cast<Side>(record.pendingAdvantageFor);
+    loaded.pendingAdvantageSquare = record.pendingAdvantageSquare;
+    loaded.advantage.applied         = (record.stateFlags & STATE_ADVANTAGE_APPLIED) != 0;
+    loaded.advantage.square          = record.advantageSquare;
+    loaded.advantage.owner           = static_cast<Side>(record.advantageOwner);
+    loaded.advantage.protectHuman    = (record.stateFlags & STATE_PROTECT_HUMAN) != 0;
+    loaded.advantage.protectComputer = (record.stateFlags & STATE_PROTECT_COMPUTER) != 0;
+    loaded.diceSaved              = (record.stateFlags & STATE_DICE_SAVED) != 0;
+    loaded.diceSeed               = record.diceSeed;
+    loaded.diceGameId             = record.diceGameId;
+    loaded.diceTurn               = record.diceTurn;
+    if (const char* error = validate(loaded)) return error;
+    game = loaded;
+    return nullptr;
+}
+
+/**
+ * @brief Encode and write a save in one go.
+ * @param filename Path of the file
+ * @param game Game to save
+ * @param format Format to write
+ * @return true on success
+ */
+bool savegame::save(const string& filename, const SavedGame& game, const Format format) {
+    if (const char* error = validate(game)) {
+        cerr << "Unable to save game to " << filename << ": " << error << endl;
+        return false;
+    }
+    if (ofstream file(filename, ios::binary); file.is_open()) {
+        if (format == Format::Binary) {
+            const SaveFileRecord record = toRecord(game);
+            file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        } else {
+            writeText(file, game);
+        }
+        if (file.flush()) return true;
+    }
+    cerr << "Unable to save game to " << filename << endl;
+    return false;
+}
+
+/**
+ * @brief Read a whole save and decode it by its first bytes.
+ * @param filename Path of the file
+ * @param game Receives the game
+ * @return true on success
+ */
+bool savegame::load(const string& filename, SavedGame& game) {
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        cerr << "Unable to load game from " << filename << endl;
+        return false;
+    }
+    const string contents((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    const bool binary = contents.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) == 0;
+    stringstream text(binary ? string() : contents);
+    if (const char* error = binary ? fromBinary(contents.data(), contents.size(), game) : readText(text, game)) {
+        cerr << "Unable to load game from " << filename << ": " << error << endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,295 @@
+/**
+ * @file Simulator.cpp
+ * @brief Headless Computer-vs-Computer rounds and tournaments.
+ */
+
+#include "../Header Files/Simulator.h"
+#include "../Header Files/Board.h"
+#include "../Header Files/BoardSpec.h"
+#include "../Header Files/DiceSource.h"
+#include "../Header Files/GameState.h"
+#include "../Header Files/MctsSearch.h"
+#include "../Header Files/PolicyTable.h"
+#include "../Header Files/RolloutSearch.h"
+#include "../Header Files/Round.h"
+#include "../Header Files/Solver.h"
+#include "../Header Files/Strategy.h"
+#include "../Header Files/Tournament.h"
+#include "../Header Files/WorkStealingPool.h"
+#include <vector>
+
+using namespace std;
+using namespace strategy;
+
+namespace {
+
+    /** @brief Advantage bookkeeping for one simulated round (mirrors the Tournament fields). */
+    struct AdvantageState {
+        int pendingSquare = 0; /**< square queued for the next round */
+        int pendingFor = -1; /**< seat receiving the queued advantage, -1 for none */
+        int square = 0; /**< square applied this round */
+        int owner = -1; /**< seat owning the applied advantage, -1 for none */
+        bool protectedFlag = false; /**< advantage square may not be uncovered yet */
+    };
+
+    /** @brief How a simulated round finished. */
+    struct RoundResult {
+        int winner = -1; /**< winning seat, -1 when abandoned */
+        bool byCover = false; /**< won by covering all own squares */
+        int score = 0; /**< points awarded to the winner */
+        bool winnerWentFirst = false; /**< winner took the first turn */
+    };
+
+    /** @brief Per-worker statistics slot, padded so workers never share a cache line. */
+    struct alignas(64) WorkerStats {
+        SimStats stats;
+    };
+
+    /** @brief Games handed to a worker at a time; small enough to balance, large enough to amortise stealing. */
+    constexpr uint64_t GAMES_PER_CHUNK = 256;
+
+    /** @brief Side a seat stands for in the rules Tournament shares (seat 0 is the Human slot, as in GameState). */
+    GameContext::Side sideOf(const int seat) {
+        return seat == 0 ? GameContext::Side::Human : GameContext::Side::Computer;
+    }
+
+    /** @brief Seat of a side, the inverse of sideOf. */
+    int seatOf(const GameContext::Side side) {
+        return side == GameContext::Side::Human ? 0 : 1;
+    }
+
+    /** @brief Two-dice roll-off as in Round::determineFirstPlayer. @return starting seat */
+    int determineFirstSeat(DiceSource& dice, SimStats& stats) {
+        while (true) {
+            const int roll0 = dice.rollDie() + dice.rollDie();
+            const int roll1 = dice.rollDie() + dice.rollDie();
+            stats.rolls += 2;
+            if (roll0 != roll1) return roll0 > roll1 ? 0 : 1;
+        }
+    }
+
+    /** @brief Search engines a seat plays with; all null plays the Computer strategy. */
+    struct SeatEngines {
+        const PolicyTable* policy; /**< mapped policy table */
+        const Solver* solver; /**< in-process solver */
+        const RolloutSearch* rollout; /**< Monte Carlo search */
+        MctsSearch* mcts; /**< Monte Carlo Tree Search */
+    };
+
+    /** @brief A Board of the spec's size with the given squares covered, for the searches. */
+    template <class Spec>
+    Board boardOf(const Spec& spec, const uint32_t covered) {
+        Board board(spec.size());
+        board.applyMove(covered, /*covering=*/true);
+        return board;
+    }
+
+    /**
+     * @brief Play one seat's turn with the Computer strategy, optimally when a
+     *        policy table or solver is given, or with the rollout or tree search.
+     *        The boards are covered masks and every size-dependent value comes
+     *        from the spec, so the specialised instantiations check no sizes.
+     * @return true when the turn ended the round (result is filled in)
+     */
+    template <class Spec>
+    bool playTurn(const Spec& spec, const int seat, const SeatEngines& engines, uint32_t (&boards)[2],
+                  AdvantageState& adv, DiceSource& dice, SimStats& stats, RoundResult& result) {
+        const PolicyTable* policy = engines.policy;
+        const Solver* solver = engines.solver;
+        uint32_t& own = boards[seat];
+        uint32_t& opp = boards[1 - seat];
+        const int protectedSquare =
+            (adv.protectedFlag && adv.owner == 1 - seat) ? adv.square : 0;
+        const auto position = [&] {
+            return GameState(boardOf(spec, boards[0]), boardOf(spec, boards[1]), seat, protectedSquare);
+        };
+
+        while (true) {
+            int diceCount;
+            if (policy)      diceCount = policy->diceCount(own, opp);
+            else if (solver) diceCount = solver->bestDiceCount(own, opp, protectedSquare);
+            else if (!engines.rollout && engines.mcts) diceCount = engines.mcts->chooseDiceCount(position()).diceCount;
+            else             diceCount = chooseDiceCount(spec, own);
+            const int sum = dice.rollDie() + (diceCount == 2 ? dice.rollDie() : 0);
+            ++stats.rolls;
+
+            StrategyResult best;
+            if (policy) {
+                best = policy->bestMove(own, opp, sum, protectedSquare);
+            } else if (solver) {
+                best = solver->bestMove(own, opp, sum, protectedSquare);
+            } else if (engines.rollout) {
+                best = engines.rollout->bestMove(position(), sum).move;
+            } else if (engines.mcts) {
+                best = engines.mcts->bestMove(position(), sum).move;
+            } else {
+                best = computeBestMove(spec, sum, own, opp, protectedSquare);
+            }
+            if (best.action == StrategyResult::Action::None) return false;
+
+            const bool covering = best.action == StrategyResult::Action::Cover;
+            if (covering) own |= best.combo & spec.fullMask();
+            else          opp &= ~best.combo;
+            ++stats.moves;
+
+            const Round::MoveOutcome outcome = Round::outcomeOfMove(own, opp, spec.fullMask(), covering);
+            if (outcome.won) {
+                result.winner  = seat;
+                result.byCover = outcome.byCover;
+                result.score   = outcome.score;
+                return true;
+            }
+            if (outcome.turnEnds) return false;
+        }
+    }
+
+    /**
+     * @brief Play a full round on fresh boards, applying any queued advantage first.
+     * @return The round outcome
+     */
+    template <class Spec>
+    RoundResult playRound(const Spec& spec, const SimConfig& config, AdvantageState& adv,
+                          DiceSource& dice, SimStats& stats) {
+        uint32_t boards[2] = {0, 0};
+
+        adv.square = 0;
+        adv.owner = -1;
+        adv.protectedFlag = false;
+        if (adv.pendingFor >= 0 && adv.pendingSquare > 0) {
+            if (adv.pendingSquare <= spec.size()) boards[adv.pendingFor] |= Board::bitOf(adv.pendingSquare);
+            adv.square = adv.pendingSquare;
+            adv.owner = adv.pendingFor;
+            adv.protectedFlag = true;
+        }
+        adv.pendingSquare = 0;
+        adv.pendingFor = -1;
+
+        const int firstSeat = determineFirstSeat(dice, stats);
+        int seat = firstSeat;
+        RoundResult result;
+
+        for (int turn = 0; turn < Simulator::MAX_TURNS_PER_ROUND; ++turn) {
+            ++stats.turns;
+            dice.nextTurn();
+            const SeatEngines engines{config.seatPolicy[seat], config.seatSolver[seat], config.seatRollout[seat],
+                                      config.seatMcts[seat]};
+            const bool over = playTurn(spec, seat, engines, boards, adv, dice, stats, result);
+
+            // Protection expires once the advantage owner's opponent has played.
+            if (adv.protectedFlag && adv.owner != seat) adv.protectedFlag = false;
+
+            if (over) {
+                result.winnerWentFirst = (result.winner == firstSeat);
+                return result;
+            }
+            seat = 1 - seat;
+        }
+        return result;
+    }
+
+} // anonymous namespace
+
+/**
+ * @brief Accumulate another batch's counters.
+ * @param other Statistics to add
+ */
+void SimStats::merge(const SimStats& other) {
+    games += other.games;
+    rounds += other.rounds;
+    abandonedRounds += other.abandonedRounds;
+    firstPlayerRoundWins += other.firstPlayerRoundWins;
+    coverWins += other.coverWins;
+    uncoverWins += other.uncoverWins;
+    gameDraws += other.gameDraws;
+    turns += other.turns;
+    rolls += other.rolls;
+    moves += other.moves;
+    for (int seat = 0; seat < 2; ++seat) {
+        roundWins[seat] += other.roundWins[seat];
+        points[seat] += other.points[seat];
+        gameWins[seat] += other.gameWins[seat];
+    }
+}
+
+/**
+ * @brief Construct a simulator.
+ * @param config Settings for every game
+ */
+Simulator::Simulator(const SimConfig& config) : config(config) {}
+
+/**
+ * @brief Play a single round or a tournament of config.roundsPerGame rounds.
+ * @param gameId Index of the game; selects the dice stream
+ * @param stats Statistics to update
+ */
+void Simulator::playGame(const uint64_t gameId, SimStats& stats) const {
+    DiceSource dice(config.seed, gameId);
+    AdvantageState adv;
+    uint64_t points[2] = {0, 0};
+
+    for (int round = 0; round < config.roundsPerGame; ++round) {
+        // Pick the board size's specialisation once per round.
+        const RoundResult result = visitBoardSpec(config.boardSize, [&](const auto& spec) {
+            return playRound(spec, config, adv, dice, stats);
+        });
+        if (result.winner < 0) {
+            ++stats.abandonedRounds;
+            continue;
+        }
+
+        ++stats.rounds;
+        ++stats.roundWins[result.winner];
+        if (result.winnerWentFirst) ++stats.firstPlayerRoundWins;
+        if (result.byCover) ++stats.coverWins;
+        else                ++stats.uncoverWins;
+        points[result.winner] += result.score;
+
+        if (config.advantageRules) {
+            adv.pendingSquare = Tournament::calculateAdvantageSquare(result.score);
+            adv.pendingFor = seatOf(Tournament::handicapRecipient(sideOf(result.winner), result.winnerWentFirst));
+        }
+    }
+
+    ++stats.games;
+    stats.points[0] += points[0];
+    stats.points[1] += points[1];
+    if (points[0] > points[1])      ++stats.gameWins[0];
+    else if (points[1] > points[0]) ++stats.gameWins[1];
+    else                            ++stats.gameDraws;
+}
+
+/**
+ * @brief Play a contiguous range of games.
+ * @param firstGame Index of the first game
+ * @param count Number of games
+ * @return Statistics for the range
+ */
+SimStats Simulator::run(const uint64_t firstGame, const uint64_t count) const {
+    SimStats stats;
+    for (uint64_t i = 0; i < count; ++i) {
+        playGame(firstGame + i, stats);
+    }
+    return stats;
+}
+
+/**
+ * @brief Play a contiguous range of games on a worker pool.
+ * @param firstGame Index of the first game
+ * @param count Number of games
+ * @param pool Worker pool
+ * @return Statistics for the range
+ */
+SimStats Simulator::run(const uint64_t firstGame, const uint64_t count, WorkStealingPool& pool) const {
+    vector<WorkerStats> perWorker(pool.size());
+
+    pool.parallelFor(count, GAMES_PER_CHUNK, [&](const uint64_t begin, const uint64_t end, const int worker) {
+        SimStats& stats = perWorker[worker].stats;
+        for (uint64_t i = begin; i < end; ++i) {
+            playGame(firstGame + i, stats);
+        }
+    });
+
+    SimStats total;
+    for (const WorkerStats& slot : perWorker) total.merge(slot.stats);
+    return total;
+}
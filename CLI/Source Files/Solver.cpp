@@ -0,0 +1,567 @@
+/**
+ * @file Solver.cpp
+ * @brief Implementation of the exact expectimax solver.
+ */
+
+#include "../Header Files/Solver.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include "../Header Files/BoardSpec.h"
+#include "../Header Files/MoveTable.h"
+#include "../Header Files/PolicyTable.h"
+#include "../Header Files/WorkStealingPool.h"
+
+using namespace std;
+using namespace strategy;
+
+namespace {
+    /** @brief Ways to roll each sum with two dice (index = sum). */
+    constexpr int TWO_DICE_WAYS[13] = {0, 0, 1, 2, 3, 4, 5, 6, 5, 4, 3, 2, 1};
+
+    /** @brief Opponent rows handed to a worker at a time. */
+    constexpr uint64_t ROWS_PER_CHUNK = 4;
+
+    /** @brief Positions of a row whose uncover values are gathered together. */
+    constexpr size_t POSITIONS_PER_BATCH = 64;
+
+    /** @brief Starting value of every position; closer to most answers than 0. */
+    constexpr float INITIAL_VALUE = 0.5f;
+
+    /** @brief Per-worker largest change, padded so workers never share a cache line. */
+    struct alignas(64) WorkerChange {
+        double change = 0.0;
+    };
+
+    /**
+     * @brief Two-term extrapolation between Gauss-Seidel sweeps.
+     *
+     * Once the sweeps settle, the error is mostly two geometric components,
+     * one that keeps its sign from sweep to sweep and one that flips it (a pass
+     * flips the sign of an error), both shrinking by about 0.6 per sweep. Each
+     * sweep's change is then a fixed combination a * last + b * older of the two
+     * before it. a and b are fitted by least squares over the whole table and,
+     * when two successive fits agree, the tail of both components is added in
+     * one step. Convergence is still judged on a plain sweep, so the fixed point
+     * is unchanged; only the number of sweeps to reach it drops.
+     */
+    class SweepExtrapolation {
+    public:
+        explicit SweepExtrapolation(const vector<float>& values)
+            : previous(values), last(values.size(), 0.0f), older(values.size(), 0.0f) {}
+
+        /** @brief Record a finished sweep and jump ahead when its recurrence has settled. */
+        void afterSweep(vector<float>& values, const double change, const double tolerance) {
+            double lastLast = 0.0, lastOlder = 0.0, olderOlder = 0.0, stepLast = 0.0, stepOlder = 0.0;
+            for (size_t i = 0; i < values.size(); ++i) {
+                const double step = values[i] - previous[i];
+                lastLast += static_cast<double>(last[i]) * last[i];
+                lastOlder += static_cast<double>(last[i]) * older[i];
+                olderOlder += static_cast<double>(older[i]) * older[i];
+                stepLast += step * last[i];
+                stepOlder += step * older[i];
+                older[i] = last[i];
+                last[i] = static_cast<float>(step);
+                previous[i] = values[i];
+            }
+
+            // The fit needs three sweeps' changes since the last jump.
+            const double determinant = lastLast * olderOlder - lastOlder * lastOlder;
+            const bool fitted = ++settled >= MIN_SWEEPS && determinant > 1e-12 * lastLast * olderOlder;
+            const double a = fitted ? (stepLast * olderOlder - stepOlder * lastOlder) / determinant : 0.0;
+            const double b = fitted ? (stepOlder * lastLast - stepLast * lastOlder) / determinant : 0.0;
+            if (change > tolerance && fitted && lastFitted && slowestRate(a, b) < MAX_RATE &&
+                fabs(a - lastA) < FIT_AGREEMENT && fabs(b - lastB) < FIT_AGREEMENT) {
+                // The changes still to come add up to ((a + b) * step + b * previous step) / (1 - a - b).
+                const double stepGain = (a + b) / (1.0 - a - b), previousGain = b / (1.0 - a - b);
+                for (size_t i = 0; i < values.size(); ++i) {
+                    const double jumped = values[i] + stepGain * last[i] + previousGain * older[i];
+                    values[i] = previous[i] = static_cast<float>(clamp(jumped, 0.0, 1.0));
+                }
+                settled = 0;
+            }
+            lastFitted = fitted;
+            lastA = a;
+            lastB = b;
+        }
+
+    private:
+        static constexpr int MIN_SWEEPS = 3; /**< plain sweeps before a fit */
+        static constexpr double MAX_RATE = 0.95; /**< slower decay is too uncertain to extrapolate */
+        static constexpr double FIT_AGREEMENT = 0.05; /**< successive fits of a and b must agree this well */
+
+        /** @return Largest magnitude of the roots of x^2 = a x + b: the slowest component's rate. */
+        static double slowestRate(const double a, const double b) {
+            const double discriminant = a * a + 4.0 * b;
+            if (discriminant < 0.0) return sqrt(-b);
+            return (fabs(a) + sqrt(discriminant)) / 2.0;
+        }
+
+        vector<float> previous; /**< values after the last sweep */
+        vector<float> last; /**< change made by the last sweep */
+        vector<float> older; /**< change made by the sweep before */
+        double lastA = 0.0;
+        double lastB = 0.0;
+        bool lastFitted = false;
+        int settled = 0;
+    };
+
+    /** @brief Round a file offset up to the policy table's section alignment. */
+    uint64_t alignSection(const uint64_t offset) {
+        const uint64_t a = PolicyTable::SECTION_ALIGNMENT;
+        return (offset + a - 1) / a * a;
+    }
+}
+
+/**
+ * @brief Build the layer lists and an all-zero value table.
+ * @param boardSize Number of squares (clamped to 1..MAX_BOARD_SIZE)
+ */
+Solver::Solver(const int boardSize)
+    : boardSize(clamp(boardSize, 1, MAX_BOARD_SIZE)) {
+    masksByCount.resize(this->boardSize + 1);
+    for (uint32_t bits = 0; bits < (uint32_t{1} << this->boardSize); ++bits) {
+        masksByCount[popcount(bits)].push_back(bits << 1);
+    }
+
+    // Rows of layer diff are the opponent masks leaving room for diff more own squares.
+    layerRows.resize(2 * this->boardSize + 1);
+    for (int diff = -this->boardSize; diff <= this->boardSize; ++diff) {
+        for (int count = max(0, -diff); count <= min(this->boardSize, this->boardSize - diff); ++count) {
+            vector<uint32_t>& rows = layerRows[diff + this->boardSize];
+            rows.insert(rows.end(), masksByCount[count].begin(), masksByCount[count].end());
+        }
+    }
+
+    // Rollable subsets of each mask, found by extending subsets square by square
+    // in ascending order and stopping once the sum passes the largest roll, then
+    // sorted by sum.
+    subsetStart.reserve((size_t{1} << this->boardSize) + 1);
+    for (uint32_t bits = 0; bits < (uint32_t{1} << this->boardSize); ++bits) {
+        subsetStart.push_back(static_cast<uint32_t>(subsets.size()));
+        const uint32_t mask = bits << 1;
+        const size_t first = subsets.size();
+        for (uint32_t rest = mask; rest != 0; rest &= rest - 1) {
+            const uint32_t square = static_cast<uint32_t>(countr_zero(rest));
+            if (square > MoveTable::MAX_SUM) break;
+            const size_t previous = subsets.size();
+            subsets.push_back((uint32_t{1} << square) << SUBSET_SUM_BITS | square);
+            for (size_t i = first; i < previous; ++i) {
+                const uint32_t sum = (subsets[i] & ((1u << SUBSET_SUM_BITS) - 1)) + square;
+                if (sum <= MoveTable::MAX_SUM) subsets.push_back((subsets[i] | (uint32_t{1} << square) << SUBSET_SUM_BITS) + square);
+            }
+        }
+        stable_sort(subsets.begin() + static_cast<ptrdiff_t>(first), subsets.end(), [](const uint32_t a, const uint32_t b) {
+            return (a & ((1u << SUBSET_SUM_BITS) - 1)) < (b & ((1u << SUBSET_SUM_BITS) - 1));
+        });
+    }
+    subsetStart.push_back(static_cast<uint32_t>(subsets.size()));
+
+    values.assign(size_t{1} << (2 * this->boardSize), INITIAL_VALUE);
+}
+
+/**
+ * @brief Value of one dice outcome for the mover.
+ * @param spec Board size's spec
+ * @param mine Mover's covered mask
+ * @param theirs Opponent's covered mask
+ * @param sum Dice sum
+ * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+ * @param pass Mover's value if the roll has no legal move (the turn passes)
+ * @param best Receives the chosen move when not null
+ * @return Mover's win probability after playing the best move (or passing)
+ */
+template <class Spec>
+double Solver::outcomeValue(const Spec& spec, const uint32_t mine, const uint32_t theirs, const int sum,
+                            const int protectedSquare, const double pass, StrategyResult* best) const {
+    const uint32_t uncoverable = protectedSquare > 0 ? theirs & ~Board::bitOf(protectedSquare) : theirs;
+    const uint32_t open = spec.fullMask() & ~mine;
+
+    // The only winning moves cover every open square or uncover every opponent square.
+    if (spec.squareSum(open) == sum) {
+        if (best) *best = {StrategyResult::Action::Cover, open};
+        return 1.0;
+    }
+    if (theirs != 0 && theirs == uncoverable && spec.squareSum(theirs) == sum) {
+        if (best) *best = {StrategyResult::Action::Uncover, theirs};
+        return 1.0;
+    }
+
+    float bestValue = -1.0f;
+    StrategyResult choice{StrategyResult::Action::None, 0};
+    if (theirs == 0) {
+        // Nothing to uncover, and covering ends the turn (Round::outcomeOfMove).
+        for (const uint32_t combo : spec.combos(sum)) {
+            if ((combo & mine) != 0) continue;
+            const float v = 1.0f - values[indexOf(spec, 0, mine | combo)];
+            if (v > bestValue) {
+                bestValue = v;
+                choice = {StrategyResult::Action::Cover, combo};
+            }
+        }
+    } else {
+        // Cover successors share the opponent's row and uncover successors the
+        // mover's column; illegal moves are masked to -1 instead of branched on.
+        const float* row = &values[indexOf(spec, 0, theirs)];
+        const float* column = &values[indexOf(spec, mine, 0)];
+        for (const uint32_t combo : spec.combos(sum)) {
+            const float cover = (combo & mine) == 0 ? row[(mine | combo) >> 1] : -1.0f;
+            const float uncover = (combo & ~uncoverable) == 0
+                ? column[static_cast<size_t>((theirs & ~combo) >> 1) << spec.size()] : -1.0f;
+            const float v = max(cover, uncover);
+            if (!best) {
+                bestValue = max(bestValue, v);
+            } else if (v > bestValue) {
+                bestValue = v;
+                choice = {cover >= uncover ? StrategyResult::Action::Cover : StrategyResult::Action::Uncover, combo};
+            }
+        }
+    }
+
+    if (best) *best = choice;
+    return bestValue < 0.0f ? pass : bestValue;
+}
+
+/**
+ * @brief Expected value of rolling a given number of dice.
+ * @param spec Board size's spec
+ * @param mine Mover's covered mask
+ * @param theirs Opponent's covered mask
+ * @param diceCount 1 or 2
+ * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+ * @return Mover's win probability
+ */
+template <class Spec>
+double Solver::diceValue(const Spec& spec, const uint32_t mine, const uint32_t theirs, const int diceCount,
+                         const int protectedSquare) const {
+    const uint32_t m = mine & spec.fullMask(), t = theirs & spec.fullMask();
+    const double pass = passValue(spec, m, t);
+    double total = 0.0;
+    if (diceCount == 1) {
+        for (int sum = 1; sum <= 6; ++sum) total += outcomeValue(spec, m, t, sum, protectedSquare, pass, nullptr);
+        return total / 6.0;
+    }
+    for (int sum = 2; sum <= 12; ++sum) {
+        total += TWO_DICE_WAYS[sum] * outcomeValue(spec, m, t, sum, protectedSquare, pass, nullptr);
+    }
+    return total / 36.0;
+}
+
+/**
+ * @brief Expected value of rolling a given number of dice.
+ * @param mine Mover's covered mask
+ * @param theirs Opponent's covered mask
+ * @param diceCount 1 or 2
+ * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+ * @return Mover's win probability
+ */
+double Solver::diceValue(const uint32_t mine, const uint32_t theirs, const int diceCount,
+                         const int protectedSquare) const {
+    return visitBoardSpec(boardSize, [&](const auto& spec) {
+        return diceValue(spec, mine, theirs, diceCount, protectedSquare);
+    });
+}
+
+/**
+ * @brief Best uncover value of every sum for a run of positions sharing an opponent mask.
+ *
+ * Every position of the run has the same uncover moves, so each rollable
+ * subset of `theirs` is one successor row read at every position's own mask.
+ *
+ * @param spec Board size's spec
+ * @param theirs Opponent's covered mask
+ * @param mines Movers' covered masks
+ * @param count Number of positions
+ * @param[out] best (MoveTable::MAX_SUM + 1) * count values: the best for sum s
+ *        and position j at best[s * count + j], -1 when the sum uncovers nothing
+ */
+template <class Spec>
+void Solver::uncoverValues(const Spec& spec, const uint32_t theirs, const uint32_t* mines, const size_t count,
+                           float* best) const {
+    constexpr uint32_t SUM_MASK = (1u << SUBSET_SUM_BITS) - 1;
+    fill(best, best + (MoveTable::MAX_SUM + 1) * count, -1.0f);
+    for (const uint32_t entry : subsetsOf(theirs)) {
+        float* slot = best + (entry & SUM_MASK) * count;
+        const float* successors = &values[indexOf(spec, 0, theirs & ~(entry >> SUBSET_SUM_BITS))];
+        for (size_t j = 0; j < count; ++j) slot[j] = max(slot[j], successors[mines[j] >> 1]);
+    }
+}
+
+/**
+ * @brief Recompute a position: best dice choice over the expected outcome values.
+ *
+ * Gives the values outcomeValue() would for every sum, but walks only the
+ * legal moves: the rollable subsets of the open squares (covers), which come
+ * sorted by sum so that each sum's best is a running maximum, and the
+ * uncovers' bests from uncoverValues(). Sums 1..6 are shared by the one- and
+ * two-dice averages.
+ *
+ * @param spec Board size's spec
+ * @param mine Mover's covered mask
+ * @param theirs Opponent's covered mask
+ * @param uncover Best uncover value of each sum s at uncover[s * stride]
+ * @param stride Distance between the sums in `uncover`
+ * @return Updated win probability
+ */
+template <class Spec>
+double Solver::evaluate(const Spec& spec, const uint32_t mine, const uint32_t theirs, const float* uncover,
+                        const size_t stride) const {
+    constexpr uint32_t SUM_MASK = (1u << SUBSET_SUM_BITS) - 1;
+    const uint32_t open = spec.fullMask() & ~mine;
+    const float* row = &values[indexOf(spec, 0, theirs)];
+    float best[MoveTable::MAX_SUM + 1];
+    fill(begin(best), end(best), -1.0f);
+    float running = -1.0f;
+    uint32_t runningSum = 0;
+    for (const uint32_t entry : subsetsOf(open)) {
+        const uint32_t sum = entry & SUM_MASK;
+        const uint32_t covered = mine | entry >> SUBSET_SUM_BITS;
+        // With nothing to uncover, covering ends the turn (Round::outcomeOfMove).
+        const float v = theirs == 0 ? 1.0f - values[indexOf(spec, 0, covered)] : row[covered >> 1];
+        running = sum == runningSum ? max(running, v) : v;
+        runningSum = sum;
+        best[sum] = running;
+    }
+    for (int sum = 1; sum <= MoveTable::MAX_SUM; ++sum) best[sum] = max(best[sum], uncover[sum * stride]);
+    // Covering every open square or uncovering every opponent square wins.
+    if (theirs != 0 && spec.squareSum(theirs) <= MoveTable::MAX_SUM) best[spec.squareSum(theirs)] = 1.0f;
+    if (open != 0 && spec.squareSum(open) <= MoveTable::MAX_SUM) best[spec.squareSum(open)] = 1.0f;
+
+    const double pass = passValue(spec, mine, theirs);
+    double outcome[MoveTable::MAX_SUM + 1];
+    for (int sum = 1; sum <= MoveTable::MAX_SUM; ++sum) outcome[sum] = best[sum] < 0.0f ? pass : best[sum];
+
+    double twoDice = 0.0;
+    for (int sum = 2; sum <= 12; ++sum) twoDice += TWO_DICE_WAYS[sum] * outcome[sum];
+    twoDice /= 36.0;
+    if (!spec.canThrowOneDie(mine)) return twoDice;
+
+    double oneDie = 0.0;
+    for (int sum = 1; sum <= 6; ++sum) oneDie += outcome[sum];
+    return max(twoDice, oneDie / 6.0);
+}
+
+/**
+ * @brief Recompute one position and store it.
+ * @param spec Board size's spec
+ * @param mine Mover's covered mask
+ * @param theirs Opponent's covered mask
+ * @param uncover Best uncover value of each sum s at uncover[s * stride]
+ * @param stride Distance between the sums in `uncover`
+ * @return Absolute change of the stored value
+ */
+template <class Spec>
+double Solver::update(const Spec& spec, const uint32_t mine, const uint32_t theirs, const float* uncover,
+                      const size_t stride) {
+    float& slot = values[indexOf(spec, mine, theirs)];
+    const double updated = evaluate(spec, mine, theirs, uncover, stride);
+    const double change = fabs(updated - slot);
+    slot = static_cast<float>(updated);
+    return change;
+}
+
+/**
+ * @brief Recompute every position of a layer that has the given opponent mask.
+ *
+ * Positions in a layer only read higher layers and their pass partner in the
+ * mirrored layer, so distinct rows may be updated concurrently. In layer 0 the
+ * pass partner is in the same layer; each row therefore owns the mirror pairs
+ * (mine, theirs) and (theirs, mine) with mine <= theirs, which keeps rows
+ * independent and the result the same for any number of threads. For the same
+ * reason a row's uncover values can be gathered for a batch of its positions
+ * before any of them is updated.
+ *
+ * @param spec Board size's spec
+ * @param diff Layer: covered own minus covered opponent
+ * @param theirs Opponent's covered mask
+ * @return Largest change in the row
+ */
+template <class Spec>
+double Solver::updateRow(const Spec& spec, const int diff, const uint32_t theirs) {
+    const vector<uint32_t>& mines = masksByCount[popcount(theirs) + diff];
+    // Masks are ascending; in layer 0 the ones above theirs belong to other rows.
+    const size_t count = diff != 0 ? mines.size()
+        : static_cast<size_t>(upper_bound(mines.begin(), mines.end(), theirs) - mines.begin());
+    float uncover[(MoveTable::MAX_SUM + 1) * POSITIONS_PER_BATCH];
+    float mirrorUncover[MoveTable::MAX_SUM + 1];
+    double change = 0.0;
+    for (size_t first = 0; first < count; first += POSITIONS_PER_BATCH) {
+        const size_t batch = min(POSITIONS_PER_BATCH, count - first);
+        uncoverValues(spec, theirs, &mines[first], batch, uncover);
+        for (size_t j = 0; j < batch; ++j) {
+            const uint32_t mine = mines[first + j];
+            change = max(change, update(spec, mine, theirs, uncover + j, batch));
+            if (diff == 0 && mine != theirs) {
+                uncoverValues(spec, mine, &theirs, 1, mirrorUncover);
+                change = max(change, update(spec, theirs, mine, mirrorUncover, 1));
+            }
+        }
+    }
+    return change;
+}
+
+/**
+ * @brief Gauss-Seidel sweeps in decreasing (covered own - covered opponent) order,
+ *        extrapolated once their decay settles.
+ * @param tolerance Convergence threshold on the largest change
+ * @param maxSweeps Upper bound on the number of sweeps
+ * @return Sweeps performed
+ */
+int Solver::solve(const double tolerance, const int maxSweeps) {
+    return visitBoardSpec(boardSize, [&](const auto& spec) {
+        SweepExtrapolation extrapolation(values);
+        int sweeps = 0;
+        for (double change = tolerance + 1.0; change > tolerance && sweeps < maxSweeps; ++sweeps) {
+            change = 0.0;
+            for (int diff = boardSize; diff >= -boardSize; --diff) {
+                for (const uint32_t theirs : layerRows[diff + boardSize]) {
+                    change = max(change, updateRow(spec, diff, theirs));
+                }
+            }
+            extrapolation.afterSweep(values, change, tolerance);
+        }
+        return sweeps;
+    });
+}
+
+/**
+ * @brief The same sweeps with each layer's rows spread over a worker pool.
+ * @param tolerance Convergence threshold on the largest change
+ * @param maxSweeps Upper bound on the number of sweeps
+ * @param pool Worker pool
+ * @return Sweeps performed
+ */
+int Solver::solve(const double tolerance, const int maxSweeps, WorkStealingPool& pool) {
+    return visitBoardSpec(boardSize, [&](const auto& spec) {
+        vector<WorkerChange> perWorker(pool.size());
+        SweepExtrapolation extrapolation(values);
+        int sweeps = 0;
+        for (double change = tolerance + 1.0; change > tolerance && sweeps < maxSweeps; ++sweeps) {
+            for (int diff = boardSize; diff >= -boardSize; --diff) {
+                const vector<uint32_t>& rows = layerRows[diff + boardSize];
+                pool.parallelFor(rows.size(), ROWS_PER_CHUNK, [&](const uint64_t begin, const uint64_t end, const int worker) {
+                    double& local = perWorker[worker].change;
+                    for (uint64_t i = begin; i < end; ++i) local = max(local, updateRow(spec, diff, rows[i]));
+                });
+            }
+            change = 0.0;
+            for (WorkerChange& slot : perWorker) {
+                change = max(change, slot.change);
+                slot.change = 0.0;
+            }
+            extrapolation.afterSweep(values, change, tolerance);
+        }
+        return sweeps;
+    });
+}
+
+/**
+ * @brief Look up a position's value.
+ * @param mine Mover's covered mask
+ * @param theirs Opponent's covered mask
+ * @return Mover's win probability
+ */
+double Solver::value(const uint32_t mine, const uint32_t theirs) const {
+    const uint32_t fullMask = ((uint32_t{1} << boardSize) - 1) << 1;
+    return values[indexOf(mine & fullMask, theirs & fullMask)];
+}
+
+/**
+ * @brief Choose between one and two dice.
+ * @param mine Mover's covered mask
+ * @param theirs Opponent's covered mask
+ * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+ * @return 1 or 2
+ */
+int Solver::bestDiceCount(const uint32_t mine, const uint32_t theirs, const int protectedSquare) const {
+    return visitBoardSpec(boardSize, [&](const auto& spec) {
+        if (!spec.canThrowOneDie(mine & spec.fullMask())) return 2;
+        return diceValue(spec, mine, theirs, 1, protectedSquare) > diceValue(spec, mine, theirs, 2, protectedSquare)
+            ? 1 : 2;
+    });
+}
+
+/**
+ * @brief Choose the move with the highest win probability for a rolled sum.
+ * @param mine Mover's covered mask
+ * @param theirs Opponent's covered mask
+ * @param sum Dice sum
+ * @param protectedSquare Opponent square that may not be uncovered (0 for none)
+ * @param winProbability Receives the resulting win probability when not null
+ * @return Chosen move, Action::None when there is none
+ */
+StrategyResult Solver::bestMove(const uint32_t mine, const uint32_t theirs, const int sum,
+                                const int protectedSquare, double* winProbability) const {
+    return visitBoardSpec(boardSize, [&](const auto& spec) {
+        StrategyResult best{StrategyResult::Action::None, 0};
+        const uint32_t m = mine & spec.fullMask(), t = theirs & spec.fullMask();
+        const double pass = passValue(spec, m, t);
+        if (sum < 1 || sum > MoveTable::MAX_SUM) {
+            if (winProbability) *winProbability = pass;
+            return best;
+        }
+        const double v = outcomeValue(spec, m, t, sum, protectedSquare, pass, &best);
+        if (winProbability) *winProbability = v;
+        return best;
+    });
+}
+
+/**
+ * @brief Write the solved values, best moves and dice choices as a policy table.
+ * @param filename Path of the table to create
+ * @return true on success
+ */
+bool Solver::writeTable(const string& filename) const {
+    const uint64_t stateCount = values.size();
+    PolicyTableHeader header{};
+    copy(begin(PolicyTable::MAGIC), end(PolicyTable::MAGIC), header.magic);
+    header.version       = PolicyTable::VERSION;
+    header.boardSize     = static_cast<uint32_t>(boardSize);
+    header.ruleFlags     = PolicyTable::RULE_ONE_DIE | PolicyTable::RULE_TURN_ENDS_ON_EMPTY;
+    header.movesPerState = PolicyTable::MOVES_PER_STATE;
+    header.stateCount    = stateCount;
+    header.valuesOffset  = alignSection(sizeof(PolicyTableHeader));
+    header.movesOffset   = alignSection(header.valuesOffset + stateCount * sizeof(float));
+    header.diceOffset    = alignSection(header.movesOffset + stateCount * PolicyTable::MOVES_PER_STATE);
+    header.fileSize      = header.diceOffset + (stateCount + 7) / 8;
+
+    vector<unsigned char> payload(header.fileSize - header.valuesOffset, 0);
+    unsigned char* valuesSection = payload.data();
+    unsigned char* movesSection  = payload.data() + (header.movesOffset - header.valuesOffset);
+    unsigned char* diceSection   = payload.data() + (header.diceOffset - header.valuesOffset);
+    copy_n(reinterpret_cast<const unsigned char*>(values.data()), stateCount * sizeof(float), valuesSection);
+
+    // The same choices as bestMove() and bestDiceCount(), with the size dispatched once.
+    visitBoardSpec(boardSize, [&](const auto& spec) {
+        for (uint32_t theirsBits = 0; theirsBits < (uint32_t{1} << boardSize); ++theirsBits) {
+            for (uint32_t mineBits = 0; mineBits < (uint32_t{1} << boardSize); ++mineBits) {
+                const uint32_t mine = mineBits << 1, theirs = theirsBits << 1;
+                const size_t index = indexOf(spec, mine, theirs);
+                const double pass = passValue(spec, mine, theirs);
+                for (int sum = 1; sum <= MoveTable::MAX_SUM; ++sum) {
+                    StrategyResult best{StrategyResult::Action::None, 0};
+                    outcomeValue(spec, mine, theirs, sum, 0, pass, &best);
+                    movesSection[index * PolicyTable::MOVES_PER_STATE + (sum - 1)] = PolicyTable::encodeMove(sum, best);
+                }
+                if (spec.canThrowOneDie(mine) && diceValue(spec, mine, theirs, 1, 0) > diceValue(spec, mine, theirs, 2, 0)) {
+                    diceSection[index / 8] |= static_cast<unsigned char>(1u << (index % 8));
+                }
+            }
+        }
+    });
+
+    header.payloadChecksum = PolicyTable::checksum(payload.data(), payload.size());
+    header.headerChecksum  = PolicyTable::checksum(&header, offsetof(PolicyTableHeader, headerChecksum));
+
+    if (ofstream file(filename, ios::binary); file.is_open()) {
+        vector<char> padding(header.valuesOffset - sizeof(PolicyTableHeader), 0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(padding.data(), static_cast<streamsize>(padding.size()));
+        file.write(reinterpret_cast<const char*>(payload.data()), static_cast<streamsize>(payload.size()));
+        if (file) return true;
+    }
+    cerr << "Unable to write policy table to " << filename << endl;
+    return false;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file Strategy.cpp
+ * @brief Implementation of the shared move-selection engine (Java-like greedy strategy).
+ */
+
+#include "../Header Files/Strategy.h"
+#include <bit>
+#include "../Header Files/DiceTable.h"
+
+namespace strategy {
+
+    int sumOf(std::uint32_t combo) {
+        int total = 0;
+        for (; combo != 0; combo &= combo - 1) total += std::countr_zero(combo);
+        return total;
+    }
+
+    int countOf(const std::uint32_t combo) {
+        return std::popcount(combo);
+    }
+
+    int highestSquareOf(const std::uint32_t combo) {
+        return combo ? 31 - std::countl_zero(combo) : 0;
+    }
+
+    int highestUncovered(const Board& b) {
+        return highestSquareOf(b.getAvailableMask(/*forCovering=*/true));
+    }
+
+    int remainingCount(const Board& b) {
+        return countOf(b.getAvailableMask(/*forCovering=*/true));
+    }
+
+    namespace {
+        /**
+         * @brief Choose the best combination by preferring larger count, then higher max value.
+         * @param combos Candidate combinations
+         * @return The chosen combination
+         */
+        std::uint32_t chooseBestComboJava(const MoveList& combos) {
+            std::uint32_t best = 0;
+            int bestCount = -1;
+            int bestHigh  = -1;
+
+            for (const std::uint32_t c : combos) {
+                int cnt  = countOf(c);
+                int high = highestSquareOf(c);
+
+                if (cnt > bestCount || (cnt == bestCount && high > bestHigh)) {
+                    best      = c;
+                    bestCount = cnt;
+                    bestHigh  = high;
+                }
+            }
+            return best;
+        }
+    }
+
+    // -----------------------------------------------------------------
+    // computeBestMove - Java-like strategy
+    // -----------------------------------------------------------------
+    StrategyResult computeBestMove(const int sum,
+                                   const Board& myBoard,
+                                   const Board& oppBoard,
+                                   const int protectedSquare)
+    {
+        StrategyResult res{StrategyResult::Action::None, 0};
+
+        MoveList coverCombos   = myBoard.findValidMoves(sum, /*forCovering=*/true);
+        MoveList uncoverCombos = oppBoard.findValidMoves(sum, /*forCovering=*/false);
+
+        // Filter out combos that hit the protected advantage square on the opponent
+        if (protectedSquare > 0) {
+            uncoverCombos.removeTouching(protectedSquare);
+        }
+
+        // No legal moves at all
+        if (coverCombos.empty() && uncoverCombos.empty()) {
+            return res;
+        }
+
+        // Java Step 1: winning cover by "count == myUncoveredCount"
+        const int myUncoveredCount = remainingCount(myBoard);
+        for (const std::uint32_t combo : coverCombos) {
+            if (countOf(combo) == myUncoveredCount) {
+                res.action = StrategyResult::Action::Cover;
+                res.combo  = combo; // closest to "first match" behavior
+                return res;
+            }
+        }
+
+        // Java Step 2: winning uncover by "count == oppCoveredCount"
+        const int oppCoveredCount = countOf(oppBoard.getCoveredMask());
+        for (const std::uint32_t combo : uncoverCombos) {
+            if (countOf(combo) == oppCoveredCount) {
+                res.action = StrategyResult::Action::Uncover;
+                res.combo  = combo;
+                return res;
+            }
+        }
+
+        // Java Step 3: prefer cover if available
+        const MoveList* candidates = nullptr;
+        StrategyResult::Action chosenAction = StrategyResult::Action::None;
+
+        if (!coverCombos.empty()) {
+            candidates = &coverCombos;
+            chosenAction = StrategyResult::Action::Cover;
+        } else {
+            candidates = &uncoverCombos;
+            chosenAction = StrategyResult::Action::Uncover;
+        }
+
+        if (!candidates || candidates->empty()) {
+            return res;
+        }
+
+        // Java Step 4: best candidate by (count, then highestSquare)
+        res.action = chosenAction;
+        res.combo  = chooseBestComboJava(*candidates);
+        return res;
+    }
+
+    bool isComboWinning(const StrategyResult& res, const Board& myBoard, const Board& oppBoard) {
+        if (res.action == StrategyResult::Action::Cover) {
+            return (myBoard.getCoveredMask() | res.combo) == myBoard.getFullMask();
+        } else if (res.action == StrategyResult::Action::Uncover) {
+            return (oppBoard.getCoveredMask() & ~res.combo) == 0;
+        }
+        return false;
+    }
+
+    int chooseDiceCount(const Board& myBoard) {
+        if (!myBoard.canThrowOneDie()) return 2;
+        if (const DiceTable::Entry* entry = DiceTable::instance().find(myBoard.getSize(), myBoard.getCoveredMask())) {
+            return entry->diceCount;
+        }
+        return heuristicDiceCount(myBoard);
+    }
+
+    int heuristicDiceCount(const Board& myBoard) {
+        if (myBoard.canThrowOneDie() &&
+            (highestUncovered(myBoard) <= 6 || remainingCount(myBoard) <= 3))
+        {
+            return 1;
+        }
+        return 2;
+    }
+
+    void applyCombo(Board& b, const std::uint32_t combo, const bool covering) {
+        b.applyMove(combo, covering);
+    }
+
+} // namespace strategy
@@ -11,20 +11,17 @@
 #include "../Header Files/Board.h"
 #include "../Header Files/Computer.h"
 #include "../Header Files/Human.h"
+#include "../Header Files/MctsPlayer.h"
 #include "../Header Files/Round.h"
+#include "../Header Files/SaveGame.h"
 #include <limits>
+#include <optional>
 
 #include <iostream>
 #include <ostream>
-#include <fstream>
-#include <sstream>
 
 using namespace std;
 
-bool Tournament::protectHumanAdvantage   = false;
-bool Tournament::protectComputerAdvantage= false;
-Tournament::Side Tournament::advantageOwner = Tournament::Side::None;
-
 /**
  * @brief Construct a Tournament with references to both player boards.
  * @param humanBoard Reference to the human's board
@@ -34,17 +31,9 @@ Tournament::Tournament(Board& humanBoard, Board& computerBoard)
     : isHumanTurn(true), humanBoard(humanBoard), computerBoard(computerBoard), isANewGame(true), firstPlayerIsHuman(true) {
 }
 
-bool Tournament::advantageApplied = false;
-int Tournament::advantageSquare = 0;
-
-/** @return true when an advantage has been applied for the upcoming round. */
-bool Tournament::getAdvantageApplied() {
-    return advantageApplied;
-}
-
-/** @return configured advantage square index. */
-int Tournament::getAdvantageSquare() {
-    return advantageSquare;
+/** @return The advantage state owned by this tournament. */
+GameContext& Tournament::getContext() {
+    return context;
 }
 
 /**
@@ -94,8 +83,15 @@ void Tournament::setFirstPlayerIsHuman(bool isHuman) {
  *        running rounds and final winner announcement.
  */
 void Tournament::start() {
-    Human human(humanBoard, computerBoard);
-    Computer computer(computerBoard, humanBoard);
+    Human human(humanBoard, computerBoard, context);
+    Computer computer(computerBoard, humanBoard, context);
+
+    // The Computer's seat is taken by the tree search player when one is configured.
+    Player* opponent = &computer;
+    std::optional<MctsPlayer> mctsPlayer;
+    if (MctsSearch* search = context.getMctsSearch()) {
+        opponent = &mctsPlayer.emplace(computerBoard, humanBoard, context, *search);
+    }
 
     char loadChoice;
     cout << "~~~~~~~~~~~~[LOAD?]~~~~~~~~~~~~" << endl;
@@ -134,7 +130,7 @@ void Tournament::start() {
 
     char playAgain;
     do {
-        Round round(human, computer, *this, isANewGame);  // <- pass *this*, not a second Tournament
+        Round round(human, *opponent, *this, isANewGame);  // <- pass *this*, not a second Tournament
         round.play();
 
         cout << "\n~~~~~~~~~[SCORE BOARD]~~~~~~~~~~\n";
@@ -218,116 +214,80 @@ void Tournament::resetGame() {
 }
 
 /**
- * @brief Save current game state (boards, scores, next turn) to a simple text file.
- * @param filename Path of the file to write
+ * @brief Copy every field of the game into a snapshot.
+ * @return The snapshot
  */
-void Tournament::saveGame(const string& filename) const {
-    if (ofstream file(filename); file.is_open()) {
-        file << "Computer:" << endl;
-        file << "   Squares: ";
-        for (int i = 1; i <= computerBoard.getSize(); ++i) {
-            if (computerBoard.isSquareCovered(i)) {
-                file << "0 ";
-            } else {
-                file << i << " ";
-            }
-        }
-        file << endl;
-        file << "   Score: " << tournamentScoreComputer << endl;
-
-        file << "Human:" << endl;
-        file << "   Squares: ";
-        for (int i = 1; i <= humanBoard.getSize(); ++i) {
-            if (humanBoard.isSquareCovered(i)) {
-                file << "0 ";
-            } else {
-                file << i << " ";
-            }
-        }
-        file << endl;
-        file << "   Score: " << tournamentScoreHuman << endl;
+SavedGame Tournament::snapshot() const {
+    SavedGame game;
+    game.boardSize              = computerBoard.getSize();
+    game.computerMask           = computerBoard.getCoveredMask();
+    game.humanMask              = humanBoard.getCoveredMask();
+    game.computerScore          = tournamentScoreComputer;
+    game.humanScore             = tournamentScoreHuman;
+    game.firstPlayerIsHuman     = firstPlayerIsHuman;
+    game.isHumanTurn            = isHumanTurn;
+    game.pendingAdvantageSquare = pendingAdvantageSquare;
+    game.pendingAdvantageFor    = pendingAdvantageFor;
+    game.advantage              = context.getAdvantageState();
+
+    const DiceSource& dice = context.getDice();
+    game.diceSaved  = true;
+    game.diceSeed   = dice.getSeed();
+    game.diceGameId = dice.getGameId();
+    game.diceTurn   = dice.getTurn();
+    return game;
+}
 
-        file << "First Turn: " << (firstPlayerIsHuman ? "Human" : "Computer") << endl;
-        file << "Next Turn: " << (isHumanTurn ? "Human" : "Computer") << endl;
+/**
+ * @brief Overwrite the game with a snapshot.
+ * @param game Snapshot from snapshot() or a save file
+ */
+void Tournament::restore(const SavedGame& game) {
+    humanBoard    = Board(game.boardSize);
+    computerBoard = Board(game.boardSize);
+    computerBoard.applyMove(game.computerMask, /*covering=*/true);
+    humanBoard.applyMove(game.humanMask, /*covering=*/true);
+
+    tournamentScoreComputer = game.computerScore;
+    tournamentScoreHuman    = game.humanScore;
+    firstPlayerIsHuman      = game.firstPlayerIsHuman;
+    isHumanTurn             = game.isHumanTurn;
+    pendingAdvantageSquare  = game.pendingAdvantageSquare;
+    pendingAdvantageFor     = game.pendingAdvantageFor;
+    context.restoreAdvantageState(game.advantage);
+
+    if (game.diceSaved) {
+        DiceSource dice(game.diceSeed, game.diceGameId);
+        dice.seek(game.diceTurn);
+        context.setDice(dice);
+    }
+}
 
-        file.close();
+/**
+ * @brief Save the complete game state. Names ending in savegame::BINARY_EXTENSION
+ *        get the binary format, others text.
+ * @param filename Path of the file to write
+ */
+void Tournament::saveGame(const string& filename) const {
+    if (savegame::save(filename, snapshot(), savegame::formatFor(filename))) {
         cout << "Game saved successfully to " << filename << endl;
-    } else {
-        cerr << "Unable to save game to " << filename << endl;
     }
 }
 
 /**
- * @brief Load a saved game from a simple text file format produced by saveGame.
+ * @brief Load a saved game in either format written by saveGame.
  * @param filename Path to file to read
  * @return true on successful load, false otherwise
  */
 bool Tournament::loadGame(const string& filename) {
-    if (ifstream file(filename); file.is_open()) {
-        string line;
-        int boardSize = 0;
-
-
-        while (getline(file, line)) {
-            if (line.find("Computer:") != string::npos) {
-                getline(file, line);
-                string squares = line.substr(12);
-
-                {
-                    stringstream ss(squares);
-                    int v;
-                    boardSize = 0;
-                    while (ss >> v) ++boardSize;
-                }
-
-                humanBoard    = Board(boardSize);
-                computerBoard = Board(boardSize);
-
-                {
-                    stringstream ss(squares);
-                    for (int i = 1; i <= boardSize; ++i) {
-                        int v; ss >> v;
-                        if (v == 0) computerBoard.coverSquare(i);
-                        else        computerBoard.uncoverSquare(i);
-                    }
-                }
-
-                // ----- read "   Score: ..." -----
-                getline(file, line);
-                tournamentScoreComputer = stoi(line.substr(10)); // "   Score: " is 10 chars
-            }
-
-            else if (line.find("Human:") != string::npos) {
-                getline(file, line);
-                string squares = line.substr(12);          // FIX: was 11
-
-                {
-                    stringstream ss(squares);
-                    for (int i = 1; i <= boardSize; ++i) {
-                        int v; ss >> v;
-                        if (v == 0) humanBoard.coverSquare(i);
-                        else        humanBoard.uncoverSquare(i);
-                    }
-                }
-
-                getline(file, line);
-                tournamentScoreHuman = stoi(line.substr(10));
-            } else if (line.rfind("First Turn:", 0) == 0) {
-                firstPlayerIsHuman = (line.find("Human") != string::npos);
-            } else if (line.rfind("Next Turn:", 0) == 0) {
-                isHumanTurn = (line.find("Human") != string::npos);
-            }
-        }
-        file.close();
-        cout << "Game loaded successfully from " << filename << endl;
-
-        cout << "FirstPlayer: " << (firstPlayerIsHuman ? "Human" : "Computer") << ", Next Player: " << (isHumanTurn ? "Human" : "Computer") << endl;
-        isANewGame = false;
-        return true;
-    } else {
-        cerr << "Unable to load game from " << filename << endl;
-        return false;
-    }
+    SavedGame game;
+    if (!savegame::load(filename, game)) return false;
+    restore(game);
+
+    cout << "Game loaded successfully from " << filename << endl;
+    cout << "FirstPlayer: " << (firstPlayerIsHuman ? "Human" : "Computer") << ", Next Player: " << (isHumanTurn ? "Human" : "Computer") << endl;
+    isANewGame = false;
+    return true;
 }
 
 /**
@@ -344,27 +304,32 @@ int Tournament::calculateAdvantageSquare(int winningScore) {
     return sum;
 }
 
+/**
+ * @brief The handicap rule: a winner who started first gives the advantage to
+ *        the other side; a winner who did not start keeps it.
+ * @param winner Side that won the round
+ * @param winnerWasFirst True when the winner had started first
+ * @return Side to receive the advantage square
+ */
+Tournament::Side Tournament::handicapRecipient(const Side winner, const bool winnerWasFirst) {
+    if (!winnerWasFirst) return winner;
+    return winner == Side::Human ? Side::Computer : Side::Human;
+}
+
 /**
  * @brief Queue and configure a handicap (advantage) for the next round based on the winner.
  * @param winnerWasFirstPlayer True when the round winner had started first
  * @param winnerIsHuman True when the winner is the human
  * @param winningScore The score to use to compute the advantage square
  */
-void Tournament::applyHandicap(bool winnerWasFirstPlayer, bool winnerIsHuman, int winningScore) const {
-    advantageSquare = calculateAdvantageSquare(winningScore);
+void Tournament::applyHandicap(bool winnerWasFirstPlayer, bool winnerIsHuman, int winningScore) {
+    const int advantageSquare = calculateAdvantageSquare(winningScore);
+    context.setAdvantageSquare(advantageSquare);
 
-    Side forWhom;
-    if (winnerWasFirstPlayer) {
-        // winner started first -> the OTHER side gets advantage
-        forWhom = winnerIsHuman ? Side::Computer : Side::Human;
-    } else {
-        // winner did NOT start first -> the WINNER gets advantage
-        forWhom = winnerIsHuman ? Side::Human : Side::Computer;
-    }
+    const Side forWhom = handicapRecipient(winnerIsHuman ? Side::Human : Side::Computer, winnerWasFirstPlayer);
 
-    auto* self = const_cast<Tournament*>(this);
-    self->pendingAdvantageSquare = advantageSquare;
-    self->pendingAdvantageFor    = forWhom;
+    pendingAdvantageSquare = advantageSquare;
+    pendingAdvantageFor    = forWhom;
 
     cout << "[Advantage queued for next round] Square "
          << advantageSquare << " -> "
@@ -391,53 +356,17 @@ int Tournament::promptBoardSize() {
  * @brief Apply any queued advantage to the new round (cover advantage square and protect it for one turn).
  */
 void Tournament::applyAdvantageToNewRound() {
-    advantageApplied          = false;
-    advantageOwner            = Side::None;
-    protectHumanAdvantage     = false;
-    protectComputerAdvantage  = false;
+    context.clearAdvantage();
 
     if (pendingAdvantageFor == Side::None || pendingAdvantageSquare <= 0) return;
 
     if (pendingAdvantageFor == Side::Human) {
         humanBoard.coverSquare(pendingAdvantageSquare);
-        protectHumanAdvantage = true;
-        advantageOwner = Side::Human;
     } else {
         computerBoard.coverSquare(pendingAdvantageSquare);
-        protectComputerAdvantage = true;
-        advantageOwner = Side::Computer;
     }
 
-    advantageApplied = true;
+    context.applyAdvantage(pendingAdvantageFor, pendingAdvantageSquare);
     pendingAdvantageSquare = 0;
     pendingAdvantageFor    = Side::None;
 }
-
-/** @return true when the human advantage protection flag is set. */
-bool Tournament::isHumanAdvantageProtected()    { return protectHumanAdvantage; }
-/** @return true when the computer advantage protection flag is set. */
-bool Tournament::isComputerAdvantageProtected() { return protectComputerAdvantage; }
-/** @return Which side currently owns the advantage. */
-Tournament::Side Tournament::getAdvantageOwner(){ return advantageOwner; }
-
-/**
- * @brief Clear protection for the human advantage and potentially reset advantage state.
- */
-void Tournament::clearAdvantageProtectionForHuman() {
-    protectHumanAdvantage = false;
-    if (!protectComputerAdvantage) {
-        advantageApplied = false;
-        advantageOwner   = Side::None;
-    }
-}
-
-/**
- * @brief Clear protection for the computer advantage and potentially reset advantage state.
- */
-void Tournament::clearAdvantageProtectionForComputer() {
-    protectComputerAdvantage = false;
-    if (!protectHumanAdvantage) {
-        advantageApplied = false;
-        advantageOwner   = Side::None;
-    }
-}
@@ -0,0 +1,100 @@
+/**
+ * @file TranspositionTable.cpp
+ * @brief Implementation of TranspositionTable: sizing, lock-free probe and
+ *        depth-preferred replacement.
+ */
+
+#include "../Header Files/TranspositionTable.h"
+#include <algorithm>
+#include <bit>
+
+using namespace std;
+
+namespace {
+    /** @brief Pack an entry into a slot's data word. */
+    uint64_t pack(const TranspositionTable::Entry& entry) {
+        return uint64_t{entry.points} << 32 | entry.samples;
+    }
+
+    /** @brief Unpack a slot's data word. */
+    TranspositionTable::Entry unpack(const uint64_t data) {
+        return {static_cast<uint32_t>(data >> 32), static_cast<uint32_t>(data)};
+    }
+}
+
+/**
+ * @brief Scale the value down to a sample budget, keeping its mean.
+ * @param maxSamples Largest sample count
+ * @return The capped value
+ */
+TranspositionTable::Entry TranspositionTable::Entry::cappedAt(const uint32_t maxSamples) const {
+    if (samples <= maxSamples) return *this;
+    const uint64_t scaled = (uint64_t{points} * maxSamples + samples / 2) / samples;
+    return {static_cast<uint32_t>(scaled), maxSamples};
+}
+
+/**
+ * @brief Allocate the largest power-of-two number of buckets that fits the budget.
+ * @param megabytes Memory budget
+ */
+TranspositionTable::TranspositionTable(const size_t megabytes)
+    : bucketCount(bit_floor(max<size_t>(megabytes * 1024 * 1024 / sizeof(Bucket), 1))),
+      buckets(new Bucket[bucketCount]) {}
+
+/**
+ * @brief Find a position in its bucket.
+ * @param key Position hash
+ * @param entry Receives the value
+ * @return true when found
+ */
+bool TranspositionTable::probe(const uint64_t key, Entry& entry) const {
+    const Bucket& bucket = bucketFor(key);
+    for (const Slot* slot : {&bucket.deepest, &bucket.recent}) {
+        const uint64_t data = slot->data.load(memory_order_relaxed);
+        if ((slot->check.load(memory_order_relaxed) ^ data) != key) continue;
+        entry = unpack(data);
+        if (entry.samples > 0) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Store a value. The deep slot takes it when it has at least as many
+ *        samples as the entry there (a different position's entry moves to the
+ *        recent slot), otherwise the recent slot does; a shallower value for the
+ *        position in the deep slot is dropped. Concurrent stores to a bucket may
+ *        lose one of the entries but never leave a slot that verifies wrongly.
+ * @param key Position hash
+ * @param entry Value
+ */
+void TranspositionTable::store(const uint64_t key, const Entry& entry) {
+    if (entry.samples == 0) return;
+    Bucket& bucket = bucketFor(key);
+    const uint64_t data = pack(entry);
+    const auto write = [](Slot& slot, const uint64_t slotKey, const uint64_t slotData) {
+        slot.data.store(slotData, memory_order_relaxed);
+        slot.check.store(slotKey ^ slotData, memory_order_relaxed);
+    };
+
+    const uint64_t deepData = bucket.deepest.data.load(memory_order_relaxed);
+    const uint64_t deepKey = bucket.deepest.check.load(memory_order_relaxed) ^ deepData;
+    const Entry deep = unpack(deepData);
+    if (deepKey == key) {
+        if (entry.samples >= deep.samples) write(bucket.deepest, key, data);
+    } else if (entry.samples >= deep.samples) {
+        if (deep.samples > 0) write(bucket.recent, deepKey, deepData);
+        write(bucket.deepest, key, data);
+    } else {
+        write(bucket.recent, key, data);
+    }
+}
+
+/** @brief Empty every slot. */
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucketCount; ++i) {
+        for (Slot* slot : {&buckets[i].deepest, &buckets[i].recent}) {
+            slot->check.store(0, memory_order_relaxed);
+            slot->data.store(0, memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Implementation of the work-stealing parallel-for pool.
+ */
+
+#include "../Header Files/WorkStealingPool.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief Create the queues and start the workers.
+ * @param threads Number of workers; values below 1 use the hardware concurrency
+ */
+WorkStealingPool::WorkStealingPool(int threads) {
+    if (threads < 1) threads = max(1u, thread::hardware_concurrency());
+
+    for (int i = 0; i < threads; ++i) queues.push_back(make_unique<ChunkQueue>());
+    for (int i = 0; i < threads; ++i) workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+/**
+ * @brief Signal shutdown and join every worker.
+ */
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> guard(jobLock);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (thread& worker : workers) worker.join();
+}
+
+/**
+ * @brief Deal the chunks out to the workers and block until all have been processed.
+ * @param count Number of items
+ * @param grain Items per chunk
+ * @param rangeBody Function processing one chunk
+ */
+void WorkStealingPool::parallelFor(const uint64_t count, uint64_t grain, const RangeBody& rangeBody) {
+    if (count == 0) return;
+    if (grain == 0) grain = 1;
+
+    const uint64_t chunks = (count + grain - 1) / grain;
+    const uint64_t threads = queues.size();
+    for (uint64_t i = 0; i < threads; ++i) {
+        lock_guard<mutex> guard(queues[i]->lock);
+        queues[i]->head = chunks * i / threads;
+        queues[i]->tail = chunks * (i + 1) / threads;
+    }
+
+    unique_lock<mutex> guard(jobLock);
+    body = &rangeBody;
+    itemCount = count;
+    itemGrain = grain;
+    busyWorkers = static_cast<int>(threads);
+    ++generation;
+    jobReady.notify_all();
+    jobDone.wait(guard, [this] { return busyWorkers == 0; });
+    body = nullptr;
+}
+
+/**
+ * @brief Take the next chunk from the front of the worker's own queue.
+ * @param worker Worker index
+ * @param chunk Receives the chunk index
+ * @return true when a chunk was taken
+ */
+bool WorkStealingPool::popLocal(const int worker, uint64_t& chunk) {
+    ChunkQueue& own = *queues[worker];
+    lock_guard<mutex> guard(own.lock);
+    if (own.head >= own.tail) return false;
+    chunk = own.head++;
+    return true;
+}
+
+/**
+ * @brief Move the back half of another worker's chunks into this worker's queue.
+ * @param worker Worker index (the thief)
+ * @param chunk Receives the first stolen chunk
+ * @return true when something was stolen
+ */
+bool WorkStealingPool::steal(const int worker, uint64_t& chunk) {
+    const int threads = size();
+    for (int offset = 1; offset < threads; ++offset) {
+        ChunkQueue& victim = *queues[(worker + offset) % threads];
+        uint64_t begin, end;
+        {
+            lock_guard<mutex> guard(victim.lock);
+            const uint64_t remaining = victim.tail - victim.head;
+            if (victim.head >= victim.tail) continue;
+            end = victim.tail;
+            begin = victim.tail - (remaining + 1) / 2;
+            victim.tail = begin;
+        }
+
+        chunk = begin;
+        ChunkQueue& own = *queues[worker];
+        lock_guard<mutex> guard(own.lock);
+        own.head = begin + 1;
+        own.tail = end;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Worker main loop: wait for a job, drain own and stolen chunks, report completion.
+ * @param worker Worker index
+ */
+void WorkStealingPool::workerLoop(const int worker) {
+    uint64_t seenGeneration = 0;
+
+    while (true) {
+        const RangeBody* job;
+        uint64_t count, grain;
+        {
+            unique_lock<mutex> guard(jobLock);
+            jobReady.wait(guard, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+            job = body;
+            count = itemCount;
+            grain = itemGrain;
+        }
+
+        uint64_t chunk;
+        while (popLocal(worker, chunk) || steal(worker, chunk)) {
+            const uint64_t begin = chunk * grain;
+            (*job)(begin, min(count, begin + grain), worker);
+        }
+
+        lock_guard<mutex> guard(jobLock);
+        if (--busyWorkers == 0) jobDone.notify_one();
+    }
+}
@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "Header Files/Board.h"
+#include "Header Files/BoardView.h"
+#include "Header Files/DiceSource.h"
+#include "Header Files/GameState.h"
+#include "Header Files/MctsSearch.h"
+#include "Header Files/Simulator.h"
+#include "Header Files/Strategy.h"
+#include "Header Files/WorkStealingPool.h"
+
+using namespace std;
+using namespace strategy;
+
+// Every allocation in the process goes through these, so each benchmark can
+// report how many heap allocations one operation performs.
+namespace {
+    atomic<uint64_t> allocationCount{0};
+    atomic<uint64_t> allocatedBytes{0};
+
+    void* countedAllocate(const size_t size) {
+        allocationCount.fetch_add(1, memory_order_relaxed);
+        allocatedBytes.fetch_add(size, memory_order_relaxed);
+        if (void* p = malloc(size ? size : 1)) return p;
+        throw bad_alloc();
+    }
+
+    /** @brief The same for over-aligned types, e.g. per-worker slots padded to a cache line. */
+    void* countedAllocate(const size_t size, const align_val_t alignment) {
+        allocationCount.fetch_add(1, memory_order_relaxed);
+        allocatedBytes.fetch_add(size, memory_order_relaxed);
+        const size_t a = static_cast<size_t>(alignment);
+        // aligned_alloc wants a size that is a multiple of the alignment.
+        if (void* p = aligned_alloc(a, (max<size_t>(size, 1) + a - 1) / a * a)) return p;
+        throw bad_alloc();
+    }
+}
+
+void* operator new(const size_t size) { return countedAllocate(size); }
+void* operator new[](const size_t size) { return countedAllocate(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void* operator new(const size_t size, const align_val_t alignment) { return countedAllocate(size, alignment); }
+void* operator new[](const size_t size, const align_val_t alignment) { return countedAllocate(size, alignment); }
+void operator delete(void* p, align_val_t) noexcept { free(p); }
+void operator delete[](void* p, align_val_t) noexcept { free(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { free(p); }
+void operator delete[](void* p, size_t, align_val_t) noexcept { free(p); }
+
+namespace {
+    constexpr int SAMPLES = 5; /**< Timed batches per benchmark; the fastest is reported */
+    constexpr uint64_t POSITIONS = 64; /**< Fixture positions each benchmark cycles through */
+    constexpr uint64_t FIXTURE_SEED = 0x43414E4F4741ull; /**< Key for generating fixture boards */
+    constexpr uint64_t MCTS_ITERATIONS = 1024; /**< Iterations per benchmarked tree search decision */
+    constexpr int SCALING_DECISIONS = 16; /**< Timed tree search decisions per row of the scaling report */
+    constexpr int SCALING_BOARD_SIZE = 9; /**< Board size of the scaling report positions */
+
+    /** @brief Command-line settings. */
+    struct Options {
+        bool json = false; /**< print JSON instead of a table */
+        string filter; /**< run only benchmarks whose name contains this */
+        double minTimeMs = 250.0; /**< approximate measuring time per benchmark */
+        int scalingThreads = 0; /**< print the MCTS scaling report for 1..N threads instead (0: off) */
+    };
+
+    /** @brief One benchmark's measurements. */
+    struct Result {
+        string name; /**< benchmark name, e.g. "computeBestMove/size=9" */
+        uint64_t iterations = 0; /**< operations per timed batch */
+        double nsPerOp = 0.0; /**< fastest batch's time per operation */
+        double allocsPerOp = 0.0; /**< heap allocations per operation */
+        double bytesPerOp = 0.0; /**< heap bytes requested per operation */
+    };
+
+    /** @brief Stream buffer that discards everything, so rendering cost excludes the terminal. */
+    class NullBuffer : public streambuf {
+    protected:
+        int overflow(const int c) override { return c; }
+        streamsize xsputn(const char*, const streamsize n) override { return n; }
+    };
+
+    /** @brief Keep the optimiser from discarding a computed value. */
+    template <typename T>
+    void keep(const T& value) {
+        asm volatile("" : : "r"(&value) : "memory");
+    }
+
+    /** @brief Print command-line usage. */
+    void printUsage(const char* program) {
+        cout << "Usage: " << program << " [options]\n"
+             << "  --json           print results as JSON\n"
+             << "  --filter TEXT    run only benchmarks whose name contains TEXT\n"
+             << "  --min-time MS    approximate measuring time per benchmark (default 250)\n"
+             << "  --mcts-scaling N report tree search throughput for root and tree parallelism on\n"
+             << "                   1..N threads instead (each row searches for about --min-time)\n";
+    }
+
+    /**
+     * @brief A board with each square covered with the given probability.
+     *        Boards depend only on (size, fill, index), so every run measures the same inputs.
+     */
+    Board fixtureBoard(const int size, const int fillPercent, const uint64_t index) {
+        Board board(size);
+        for (int square = 1; square <= size; ++square) {
+            const uint32_t word = DiceSource::philox(
+                {static_cast<uint32_t>(index), static_cast<uint32_t>(square), static_cast<uint32_t>(size),
+                 static_cast<uint32_t>(fillPercent)},
+                {static_cast<uint32_t>(FIXTURE_SEED), static_cast<uint32_t>(FIXTURE_SEED >> 32)})[0];
+            if (word % 100 < static_cast<uint32_t>(fillPercent)) board.coverSquare(square);
+        }
+        return board;
+    }
+
+    /** @brief POSITIONS fixture boards. */
+    vector<Board> fixtureBoards(const int size, const int fillPercent, const uint64_t salt = 0) {
+        vector<Board> boards;
+        for (uint64_t i = 0; i < POSITIONS; ++i) boards.push_back(fixtureBoard(size, fillPercent, i + salt * POSITIONS));
+        return boards;
+    }
+
+    /** @brief Run `op` for indices [0, count) and return the elapsed seconds. */
+    template <typename Op>
+    double timeBatch(const Op& op, const uint64_t count) {
+        const auto start = chrono::steady_clock::now();
+        for (uint64_t i = 0; i < count; ++i) op(i);
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * @brief Calibrate a batch size, then time SAMPLES batches.
+     * @param name Benchmark name
+     * @param op Operation; receives the iteration index to pick its fixture
+     * @param options Timing settings
+     * @return Fastest time per operation and average allocations per operation
+     */
+    template <typename Op>
+    Result measure(const string& name, const Op& op, const Options& options) {
+        const double batchSeconds = options.minTimeMs / 1000.0 / SAMPLES;
+        uint64_t batch = 1;
+        while (timeBatch(op, batch) < batchSeconds && batch < (uint64_t{1} << 40)) batch *= 2;
+
+        Result result;
+        result.name = name;
+        result.iterations = batch;
+        double best = numeric_limits<double>::infinity();
+        const uint64_t allocationsBefore = allocationCount.load(memory_order_relaxed);
+        const uint64_t bytesBefore = allocatedBytes.load(memory_order_relaxed);
+        for (int sample = 0; sample < SAMPLES; ++sample) best = min(best, timeBatch(op, batch));
+        const double ops = static_cast<double>(batch) * SAMPLES;
+        result.nsPerOp = best * 1e9 / static_cast<double>(batch);
+        result.allocsPerOp = static_cast<double>(allocationCount.load(memory_order_relaxed) - allocationsBefore) / ops;
+        result.bytesPerOp = static_cast<double>(allocatedBytes.load(memory_order_relaxed) - bytesBefore) / ops;
+        return result;
+    }
+
+    /** @brief Escape a benchmark name for a JSON string. */
+    string jsonString(const string& text) {
+        string out = "\"";
+        for (const char ch : text) {
+            if (ch == '"' || ch == '\\') out += '\\';
+            out += ch;
+        }
+        return out + "\"";
+    }
+
+    /** @brief Print results as an aligned table. */
+    void printTable(const vector<Result>& results) {
+        cout << left << setw(52) << "benchmark" << right << setw(14) << "ns/op" << setw(14) << "allocs/op"
+             << setw(14) << "bytes/op" << setw(14) << "iterations" << "\n";
+        cout << fixed;
+        for (const Result& r : results) {
+            cout << left << setw(52) << r.name << right << setprecision(1) << setw(14) << r.nsPerOp
+                 << setprecision(2) << setw(14) << r.allocsPerOp << setprecision(1) << setw(14) << r.bytesPerOp
+                 << setw(14) << r.iterations << "\n";
+        }
+    }
+
+    /** @brief Print results as a JSON document for regression tracking. */
+    void printJson(const vector<Result>& results, const Options& options) {
+        cout << "{\n  \"min_time_ms\": " << options.minTimeMs << ",\n  \"samples\": " << SAMPLES
+             << ",\n  \"benchmarks\": [\n";
+        cout << setprecision(3) << fixed;
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            cout << "    {\"name\": " << jsonString(r.name) << ", \"iterations\": " << r.iterations
+                 << ", \"ns_per_op\": " << r.nsPerOp << ", \"allocs_per_op\": " << r.allocsPerOp
+                 << ", \"bytes_per_op\": " << r.bytesPerOp << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        cout << "  ]\n}\n";
+    }
+}
+
+namespace {
+    /** @brief One row of the MCTS scaling report. */
+    struct ScalingRow {
+        string mode; /**< "root" or "tree" */
+        int threads = 0; /**< workers */
+        double iterationsPerSec = 0.0; /**< iterations per second over all workers */
+        double expansionsPerSec = 0.0; /**< nodes created per second */
+        double speedup = 0.0; /**< iterations per second relative to one thread of the same mode */
+        double sameMove = 0.0; /**< share of decisions choosing the single-thread move */
+    };
+
+    /**
+     * @brief Time the tree search on fixed positions for both parallel schemes and 1..maxThreads workers.
+     * @param maxThreads Largest worker count
+     * @param options Timing settings (each row searches SCALING_DECISIONS positions within minTimeMs)
+     * @return One row per (mode, threads)
+     */
+    vector<ScalingRow> mctsScaling(const int maxThreads, const Options& options) {
+        const vector<Board> own = fixtureBoards(SCALING_BOARD_SIZE, 50), opp = fixtureBoards(SCALING_BOARD_SIZE, 50, 1);
+        MctsConfig config;
+        config.budgetMs = max(1, static_cast<int>(options.minTimeMs / SCALING_DECISIONS));
+        config.maxNodes = size_t{1} << 18;
+        config.reuseTree = false;
+
+        vector<ScalingRow> rows;
+        for (const auto mode : {MctsConfig::Parallelism::Root, MctsConfig::Parallelism::Tree}) {
+            config.parallelism = mode;
+            vector<StrategyResult> singleThreadMoves;
+            double singleThreadRate = 0.0;
+            for (int threads = 1; threads <= maxThreads; ++threads) {
+                WorkStealingPool pool(threads);
+                MctsSearch search(config, &pool);
+                uint64_t iterations = 0, expansions = 0, sameMoves = 0;
+                const auto start = chrono::steady_clock::now();
+                for (int d = 0; d < SCALING_DECISIONS; ++d) {
+                    const MctsResult result = search.bestMove(GameState(own[d], opp[d], 0), 7);
+                    iterations += result.iterations;
+                    expansions += result.expansions;
+                    if (threads == 1) singleThreadMoves.push_back(result.move);
+                    else if (result.move.action == singleThreadMoves[d].action &&
+                             result.move.combo == singleThreadMoves[d].combo) ++sameMoves;
+                }
+                const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+                ScalingRow row;
+                row.mode = mode == MctsConfig::Parallelism::Root ? "root" : "tree";
+                row.threads = threads;
+                row.iterationsPerSec = static_cast<double>(iterations) / seconds;
+                row.expansionsPerSec = static_cast<double>(expansions) / seconds;
+                if (threads == 1) singleThreadRate = row.iterationsPerSec;
+                row.speedup = singleThreadRate > 0.0 ? row.iterationsPerSec / singleThreadRate : 0.0;
+                row.sameMove = threads == 1 ? 1.0 : static_cast<double>(sameMoves) / SCALING_DECISIONS;
+                rows.push_back(row);
+                if (!options.json) cerr << "." << flush;
+            }
+        }
+        if (!options.json) cerr << "\n";
+        return rows;
+    }
+
+    /** @brief Print the scaling report as a table or JSON. */
+    void printScaling(const vector<ScalingRow>& rows, const Options& options) {
+        if (options.json) {
+            cout << "{\n  \"board_size\": " << SCALING_BOARD_SIZE << ",\n  \"decisions\": " << SCALING_DECISIONS
+                 << ",\n  \"rows\": [\n" << setprecision(3) << fixed;
+            for (size_t i = 0; i < rows.size(); ++i) {
+                const ScalingRow& r = rows[i];
+                cout << "    {\"mode\": " << jsonString(r.mode) << ", \"threads\": " << r.threads
+                     << ", \"iterations_per_sec\": " << r.iterationsPerSec
+                     << ", \"expansions_per_sec\": " << r.expansionsPerSec << ", \"speedup\": " << r.speedup
+                     << ", \"same_move\": " << r.sameMove << "}" << (i + 1 < rows.size() ? "," : "") << "\n";
+            }
+            cout << "  ]\n}\n";
+            return;
+        }
+        cout << left << setw(8) << "mode" << right << setw(9) << "threads" << setw(16) << "iterations/s"
+             << setw(16) << "expansions/s" << setw(10) << "speedup" << setw(12) << "efficiency"
+             << setw(12) << "same move" << "\n" << fixed;
+        for (const ScalingRow& r : rows) {
+            cout << left << setw(8) << r.mode << right << setw(9) << r.threads << setprecision(0)
+                 << setw(16) << r.iterationsPerSec << setw(16) << r.expansionsPerSec << setprecision(2)
+                 << setw(10) << r.speedup << setw(11) << 100.0 * r.speedup / r.threads << "%"
+                 << setw(11) << 100.0 * r.sameMove << "%" << "\n";
+        }
+    }
+}
+
+/**
+ * Microbenchmarks for the engine hot paths, for tracking regressions between releases.
+ * @return Exit code.
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--json")                      options.json = true;
+        else if (arg == "--filter" && hasValue)   options.filter = argv[++i];
+        else if (arg == "--min-time" && hasValue) options.minTimeMs = atof(argv[++i]);
+        else if (arg == "--mcts-scaling" && hasValue) options.scalingThreads = atoi(argv[++i]);
+        else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (options.minTimeMs <= 0.0) {
+        cerr << "The minimum time must be positive." << endl;
+        return 1;
+    }
+    if (options.scalingThreads > 0) {
+        printScaling(mctsScaling(options.scalingThreads, options), options);
+        return 0;
+    }
+
+    vector<Result> results;
+    const auto run = [&](const string& name, const auto& op) {
+        if (name.find(options.filter) == string::npos) return;
+        results.push_back(measure(name, op, options));
+        if (!options.json) cerr << "." << flush;
+    };
+    const int sizes[] = {9, 10, 11};
+
+    // Move generation: every board size, dice sum and fill level, both actions.
+    for (const int size : sizes) {
+        for (const int fill : {0, 50, 90}) {
+            const vector<Board> boards = fixtureBoards(size, fill);
+            for (const bool covering : {true, false}) {
+                const string suffix = "/size=" + to_string(size) + "/fill=" + to_string(fill) +
+                                      (covering ? "/cover" : "/uncover");
+                run("Board::findValidCombinations" + suffix, [&](const uint64_t i) {
+                    keep(boards[i % POSITIONS].findValidCombinations(static_cast<int>(i % 12) + 1, covering));
+                });
+                run("Board::findValidMoves" + suffix, [&](const uint64_t i) {
+                    keep(boards[i % POSITIONS].findValidMoves(static_cast<int>(i % 12) + 1, covering));
+                });
+                run("Board::hasValidMove" + suffix, [&](const uint64_t i) {
+                    keep(boards[i % POSITIONS].hasValidMove(static_cast<int>(i % 12) + 1, covering));
+                });
+            }
+        }
+    }
+
+    // Move choice and win detection on mid- and late-game positions.
+    for (const int size : sizes) {
+        const string suffix = "/size=" + to_string(size);
+        const vector<Board> own = fixtureBoards(size, 50), opp = fixtureBoards(size, 50, 1);
+        run("strategy::computeBestMove" + suffix, [&](const uint64_t i) {
+            keep(computeBestMove(static_cast<int>(i % 11) + 2, own[i % POSITIONS], opp[i % POSITIONS], 0));
+        });
+        const vector<Board> lateBoards = fixtureBoards(size, 80);
+        run("strategy::chooseDiceCount" + suffix, [&](const uint64_t i) {
+            keep(chooseDiceCount(lateBoards[i % POSITIONS]));
+        });
+
+        const vector<Board> lateOwn = fixtureBoards(size, 80), lateOpp = fixtureBoards(size, 20, 1);
+        vector<StrategyResult> moves;
+        for (uint64_t i = 0; i < POSITIONS; ++i) {
+            moves.push_back(computeBestMove(static_cast<int>(i % 11) + 2, lateOwn[i], lateOpp[i], 0));
+        }
+        run("strategy::isComboWinning" + suffix, [&](const uint64_t i) {
+            keep(isComboWinning(moves[i % POSITIONS], lateOwn[i % POSITIONS], lateOpp[i % POSITIONS]));
+        });
+    }
+
+    // Lookahead step: make a move, test it for a win, take it back.
+    for (const int size : sizes) {
+        const vector<Board> own = fixtureBoards(size, 50), opp = fixtureBoards(size, 50, 1);
+        vector<GameState> states;
+        vector<StrategyResult> moves;
+        for (uint64_t i = 0; i < POSITIONS; ++i) {
+            states.emplace_back(own[i], opp[i], 0);
+            moves.push_back(computeBestMove(static_cast<int>(i % 11) + 2, own[i], opp[i], 0));
+        }
+        run("GameState::makeMove+unmake/size=" + to_string(size), [&](const uint64_t i) {
+            GameState& state = states[i % POSITIONS];
+            const GameState::Undo undo = state.makeMove(moves[i % POSITIONS]);
+            keep(state.own().getCoveredSum());
+            state.unmake(undo);
+        });
+    }
+
+    // Tree search decisions of a fixed size on fresh trees; the arena makes them allocation-free.
+    for (const int size : sizes) {
+        const vector<Board> own = fixtureBoards(size, 50), opp = fixtureBoards(size, 50, 1);
+        MctsConfig config;
+        config.budgetMs = 0;
+        config.maxIterations = MCTS_ITERATIONS;
+        config.maxNodes = size_t{1} << 16;
+        config.reuseTree = false;
+        MctsSearch search(config);
+        run("MctsSearch::bestMove/" + to_string(MCTS_ITERATIONS) + " iterations/size=" + to_string(size),
+            [&](const uint64_t i) {
+                keep(search.bestMove(GameState(own[i % POSITIONS], opp[i % POSITIONS], 0), 7).expansions);
+            });
+    }
+
+    // Rendering, with the terminal swapped for a sink.
+    {
+        NullBuffer sink;
+        streambuf* const terminal = cout.rdbuf(&sink);
+        for (const int size : sizes) {
+            const vector<Board> boards = fixtureBoards(size, 50);
+            vector<BoardView> views;
+            for (const Board& board : boards) views.emplace_back(board, "Computer");
+            run("BoardView::display/size=" + to_string(size), [&](const uint64_t i) {
+                views[i % POSITIONS].display(true, 5);
+            });
+        }
+        cout.rdbuf(terminal);
+    }
+
+    // A complete round of Computer-vs-Computer play with no terminal I/O.
+    for (const int size : sizes) {
+        SimConfig config;
+        config.boardSize = size;
+        const Simulator simulator(config);
+        SimStats stats;
+        run("Simulator::playGame/round/size=" + to_string(size), [&](const uint64_t i) {
+            simulator.playGame(i, stats);
+        });
+        keep(stats);
+    }
+
+    if (!options.json) cerr << "\n";
+    if (options.json) printJson(results, options);
+    else              printTable(results);
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Header Files/JournalReplay.h"
+
+using namespace std;
+
+namespace {
+    /** @brief Print command-line usage. */
+    void printUsage(const char* program) {
+        cout << "Usage: " << program << " [options] JOURNAL...\n"
+             << "  --max-errors N   errors described on stderr before the rest are only counted (default 20)\n";
+    }
+
+    /** @brief Rate helper that tolerates a zero duration. */
+    double perSecond(const double amount, const double seconds) {
+        return seconds > 0 ? amount / seconds : 0.0;
+    }
+}
+
+/**
+ * Replays game journals without the UI and checks every event against the rules.
+ * @return 0 when every journal replays cleanly, 1 otherwise.
+ */
+int main(int argc, char* argv[]) {
+    uint64_t maxErrors = 20;
+    vector<string> journals;
+
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--max-errors" && hasValue)    maxErrors = strtoull(argv[++i], nullptr, 10);
+        else if (!arg.empty() && arg[0] != '-')   journals.push_back(arg);
+        else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    if (journals.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Game ids are unique across a journal's writers, so every file shares one replay.
+    JournalReplay replay(maxErrors);
+    ReplayStats stats;
+    bool readable = true;
+    const auto start = chrono::steady_clock::now();
+    for (const string& journal : journals) readable = replay.replayFile(journal, stats) && readable;
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << fixed << setprecision(2);
+    cout << "Events: " << stats.events << " in " << seconds << " s ("
+         << perSecond(static_cast<double>(stats.events), seconds) / 1e6 << " M events/sec, "
+         << perSecond(static_cast<double>(stats.bytes), seconds) / (1024.0 * 1024.0) << " MB/sec)\n";
+    cout << "Games: " << stats.games << " (" << perSecond(static_cast<double>(stats.games), seconds)
+         << " games/sec)\n";
+    cout << "Rounds: " << stats.rounds << ", rolls: " << stats.rolls << ", moves: " << stats.moves << "\n";
+    cout << "Errors: " << stats.errors << "\n";
+    return readable && stats.errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include "Header Files/MctsSearch.h"
+#include "Header Files/PolicyTable.h"
+#include "Header Files/RolloutSearch.h"
+#include "Header Files/Simulator.h"
+#include "Header Files/Solver.h"
+#include "Header Files/TranspositionTable.h"
+#include "Header Files/WorkStealingPool.h"
+
+using namespace std;
+
+namespace {
+    /** @brief Print command-line usage. */
+    void printUsage(const char* program) {
+        cout << "Usage: " << program << " [options]\n"
+             << "  --games N        number of games to play (default 100000)\n"
+             << "  --size N         board size 9, 10 or 11 (default 9)\n"
+             << "  --seed N         base seed for the dice streams (default 1)\n"
+             << "  --rounds N       rounds per game; >1 plays tournaments (default 1)\n"
+             << "  --threads N      worker threads (default: all cores)\n"
+             << "  --no-advantage   disable the handicap/advantage square between rounds\n"
+             << "  --solver SEAT    seat 1, 2 or both plays the solved optimal strategy, from\n"
+             << "                   canoga_policy_<size>.bin when present (see CANOGA_POLICY_DIR)\n"
+             << "  --rollout SEAT   seat 1, 2 or both plays the Monte Carlo rollout search; games then\n"
+             << "                   run one at a time with each decision's playouts spread over the threads\n"
+             << "  --budget MS      rollout time per decision (default 100; 0 with --playouts for a fixed count)\n"
+             << "  --playouts N     rollout playouts per candidate move (default: budget only)\n"
+             << "  --random-playouts  rollouts and tree search playouts pick random legal moves instead of\n"
+             << "                   the greedy strategy\n"
+             << "  --mcts SEAT      seat 1, 2 or both plays the Monte Carlo Tree Search (one tree per seat);\n"
+             << "                   games then run one at a time with each decision spread over the threads;\n"
+             << "                   --budget applies to it too\n"
+             << "  --iterations N   tree search iterations per decision (default: budget only)\n"
+             << "  --mcts-mode M    tree (default: the threads share one tree) or root (one tree per thread)\n"
+             << "  --tt-mb N        transposition table the rollout and tree searches share, in MB (default 16;\n"
+             << "                   0 for none)\n";
+    }
+
+    /** @brief Percentage helper that tolerates a zero denominator. */
+    double percent(const uint64_t part, const uint64_t whole) {
+        return whole ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+    }
+}
+
+/**
+ * Headless Computer-vs-Computer self-play.
+ * @return Exit code.
+ */
+int main(int argc, char* argv[]) {
+    SimConfig config;
+    uint64_t games = 100000;
+    int threads = static_cast<int>(thread::hardware_concurrency());
+    string solverSeats;
+    string rolloutSeats;
+    string mctsSeats;
+    RolloutConfig rolloutConfig;
+    MctsConfig mctsConfig;
+    size_t tableMegabytes = 16;
+
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--games" && hasValue)       games = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--size" && hasValue)   config.boardSize = atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue)   config.seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--rounds" && hasValue) config.roundsPerGame = atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) threads = atoi(argv[++i]);
+        else if (arg == "--no-advantage")       config.advantageRules = false;
+        else if (arg == "--solver" && hasValue) solverSeats = argv[++i];
+        else if (arg == "--rollout" && hasValue) rolloutSeats = argv[++i];
+        else if (arg == "--budget" && hasValue)  rolloutConfig.budgetMs = mctsConfig.budgetMs = atoi(argv[++i]);
+        else if (arg == "--playouts" && hasValue) rolloutConfig.maxPlayouts = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--random-playouts")    rolloutConfig.greedyPlayouts = mctsConfig.greedyPlayouts = false;
+        else if (arg == "--mcts" && hasValue)    mctsSeats = argv[++i];
+        else if (arg == "--iterations" && hasValue) mctsConfig.maxIterations = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--mcts-mode" && hasValue && (string(argv[i + 1]) == "tree" || string(argv[i + 1]) == "root")) {
+            mctsConfig.parallelism = string(argv[++i]) == "root" ? MctsConfig::Parallelism::Root
+                                                                  : MctsConfig::Parallelism::Tree;
+        }
+        else if (arg == "--tt-mb" && hasValue)  tableMegabytes = strtoull(argv[++i], nullptr, 10);
+        else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (config.boardSize < 9 || config.boardSize > 11 || config.roundsPerGame < 1) {
+        cerr << "Board size must be 9, 10 or 11 and rounds must be at least 1." << endl;
+        return 1;
+    }
+    for (const string& seats : {solverSeats, rolloutSeats, mctsSeats}) {
+        if (!seats.empty() && seats != "1" && seats != "2" && seats != "both") {
+            cerr << "Solver, rollout and mcts seats must be 1, 2 or both." << endl;
+            return 1;
+        }
+    }
+
+    optional<Solver> solver;
+    if (!solverSeats.empty()) {
+        const bool seat1 = solverSeats != "2", seat2 = solverSeats != "1";
+        if (const PolicyTable* policy = PolicyTable::forBoardSize(config.boardSize)) {
+            cout << "Using mapped policy table for board size " << config.boardSize << "\n";
+            if (seat1) config.seatPolicy[0] = policy;
+            if (seat2) config.seatPolicy[1] = policy;
+        } else {
+            const auto solveStart = chrono::steady_clock::now();
+            const int sweeps = solver.emplace(config.boardSize).solve();
+            cout << "Solved board size " << config.boardSize << " in " << sweeps << " sweeps ("
+                 << chrono::duration<double>(chrono::steady_clock::now() - solveStart).count() << " s)\n";
+            if (seat1) config.seatSolver[0] = &*solver;
+            if (seat2) config.seatSolver[1] = &*solver;
+        }
+    }
+
+    WorkStealingPool pool(threads);
+    optional<TranspositionTable> table;
+    if (tableMegabytes > 0 && !(rolloutSeats.empty() && mctsSeats.empty())) {
+        rolloutConfig.table = mctsConfig.table = &table.emplace(tableMegabytes);
+    }
+    rolloutConfig.seed = config.seed;
+    const RolloutSearch rollout(rolloutConfig, &pool);
+    if (!rolloutSeats.empty()) {
+        if (rolloutSeats != "2") config.seatRollout[0] = &rollout;
+        if (rolloutSeats != "1") config.seatRollout[1] = &rollout;
+    }
+    mctsConfig.seed = config.seed;
+    optional<MctsSearch> mcts[2];
+    if (!mctsSeats.empty()) {
+        if (mctsSeats != "2") config.seatMcts[0] = &mcts[0].emplace(mctsConfig, &pool);
+        if (mctsSeats != "1") config.seatMcts[1] = &mcts[1].emplace(mctsConfig, &pool);
+    }
+
+    const Simulator simulator(config);
+    const auto start = chrono::steady_clock::now();
+    // The rollout and tree searches use the pool for each decision, so their games run one at a time.
+    const SimStats stats = rolloutSeats.empty() && mctsSeats.empty() ? simulator.run(0, games, pool)
+                                                                      : simulator.run(0, games);
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << fixed << setprecision(2);
+    cout << "Board size " << config.boardSize << ", seed " << config.seed
+         << ", " << config.roundsPerGame << " round(s) per game, advantage "
+         << (config.advantageRules ? "on" : "off") << ", " << pool.size() << " thread(s)\n";
+    cout << "Games: " << stats.games << " in " << seconds << " s ("
+         << (seconds > 0 ? static_cast<double>(stats.games) / seconds : 0.0) << " games/sec)\n";
+    cout << "Rounds: " << stats.rounds << " (abandoned " << stats.abandonedRounds << ")\n";
+    cout << "Round wins  seat 1: " << stats.roundWins[0] << " (" << percent(stats.roundWins[0], stats.rounds) << "%)"
+         << "  seat 2: " << stats.roundWins[1] << " (" << percent(stats.roundWins[1], stats.rounds) << "%)\n";
+    cout << "First player won " << percent(stats.firstPlayerRoundWins, stats.rounds) << "% of rounds\n";
+    cout << "Won by cover " << percent(stats.coverWins, stats.rounds) << "%, by uncover "
+         << percent(stats.uncoverWins, stats.rounds) << "%\n";
+    cout << "Game wins   seat 1: " << stats.gameWins[0] << "  seat 2: " << stats.gameWins[1]
+         << "  draws: " << stats.gameDraws << "\n";
+    cout << "Points      seat 1: " << stats.points[0] << "  seat 2: " << stats.points[1] << "\n";
+    cout << "Per round: " << (stats.rounds ? static_cast<double>(stats.turns) / static_cast<double>(stats.rounds) : 0.0)
+         << " turns, " << (stats.rounds ? static_cast<double>(stats.moves) / static_cast<double>(stats.rounds) : 0.0)
+         << " moves, " << (stats.rounds ? static_cast<double>(stats.rolls) / static_cast<double>(stats.rounds) : 0.0)
+         << " rolls\n";
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "Header Files/PolicyTable.h"
+#include "Header Files/Solver.h"
+#include "Header Files/WorkStealingPool.h"
+
+using namespace std;
+
+namespace {
+    /** @brief Print command-line usage. */
+    void printUsage(const char* program) {
+        cout << "Usage: " << program << " [options]\n"
+             << "  --size N         board size 9, 10 or 11 (default 9)\n"
+             << "  --output FILE    table to write (default canoga_policy_<size>.bin)\n"
+             << "  --tolerance X    convergence threshold on win probabilities (default 1e-6)\n"
+             << "  --threads N      worker threads (default: all cores)\n"
+             << "  --verify FILE    check an existing table's header and checksums, then exit\n";
+    }
+
+    /** @brief Seconds elapsed since `start`. */
+    double secondsSince(const chrono::steady_clock::time_point start) {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+}
+
+/**
+ * Offline solve of every position of a board size, written as a policy table.
+ * @return Exit code.
+ */
+int main(int argc, char* argv[]) {
+    int boardSize = 9;
+    string output;
+    double tolerance = 1e-6;
+    int threads = static_cast<int>(thread::hardware_concurrency());
+    string verify;
+
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue)           boardSize = atoi(argv[++i]);
+        else if (arg == "--output" && hasValue)    output = argv[++i];
+        else if (arg == "--tolerance" && hasValue) tolerance = atof(argv[++i]);
+        else if (arg == "--threads" && hasValue)   threads = atoi(argv[++i]);
+        else if (arg == "--verify" && hasValue)    verify = argv[++i];
+        else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (!verify.empty()) {
+        PolicyTable table;
+        if (!table.open(verify)) return 1;
+        if (!table.verifyPayload()) {
+            cerr << "Policy table " << verify << ": payload checksum mismatch" << endl;
+            return 1;
+        }
+        cout << verify << ": board size " << table.getBoardSize() << ", checksums OK\n";
+        return 0;
+    }
+
+    if (boardSize < 9 || boardSize > 11 || tolerance <= 0.0) {
+        cerr << "Board size must be 9, 10 or 11 and the tolerance must be positive." << endl;
+        return 1;
+    }
+    if (output.empty()) output = "canoga_policy_" + to_string(boardSize) + ".bin";
+
+    WorkStealingPool pool(threads);
+    Solver solver(boardSize);
+
+    cout << fixed << setprecision(2);
+    cout << "Solving board size " << boardSize << " (" << (uint64_t{1} << (2 * boardSize))
+         << " positions) on " << pool.size() << " thread(s)\n";
+
+    auto start = chrono::steady_clock::now();
+    const int sweeps = solver.solve(tolerance, 10000, pool);
+    cout << "Converged in " << sweeps << " sweeps (" << secondsSince(start) << " s), first player wins "
+         << setprecision(4) << 100.0 * solver.value(0, 0) << "% with optimal play\n" << setprecision(2);
+
+    start = chrono::steady_clock::now();
+    if (!solver.writeTable(output)) return 1;
+    cout << "Wrote " << output << " (" << secondsSince(start) << " s)\n";
+    return 0;
+}
@@ -1,19 +1,150 @@
+#include <csignal>
+#include <cstdlib>
 #include <iostream>
-#include <ctime>
+#include <optional>
+#include <string>
 #include "Header Files/Tournament.h"
 #include "Header Files/Board.h"
+#include "Header Files/EngineSession.h"
+#include "Header Files/GameJournal.h"
+#include "Header Files/GameServer.h"
+#include "Header Files/MctsSearch.h"
+#include "Header Files/RolloutSearch.h"
+#include "Header Files/TranspositionTable.h"
+#include "Header Files/WorkStealingPool.h"
 
 using namespace std;
 
+namespace {
+    GameServer* activeServer = nullptr; /**< server that SIGINT and SIGTERM stop */
+
+    /** @brief Signal handler: let the server close its sessions and exit. */
+    void stopServer(int) {
+        if (activeServer) activeServer->stop();
+    }
+
+    /** @brief Print command-line usage. */
+    void printUsage(const char* program) {
+        cout << "Usage: " << program << " [options]\n"
+             << "  --seed N         make the dice reproducible (default: random)\n"
+             << "  --ai MODE        greedy (default: heuristic, or the solved table when present),\n"
+             << "                   rollout (the Computer scores its moves with Monte Carlo playouts) or\n"
+             << "                   mcts (the Computer's seat is played by a Monte Carlo Tree Search)\n"
+             << "  --budget MS      thinking time per rollout or mcts decision (default 100)\n"
+             << "  --mcts-mode M    tree (default: all cores share one tree) or root (one tree per core)\n"
+             << "  --tt-mb N        transposition table for rollout and mcts, in MB (default 16; 0 for none)\n"
+             << "  --journal FILE   append every roll, move and round result to a game journal\n"
+             << "  --journal-async  write the journal on a background thread\n"
+             << "  --engine         speak the line-oriented engine protocol on stdin/stdout instead of\n"
+             << "                   playing interactively (see Header Files/EngineSession.h); --seed and\n"
+             << "                   --ai rollout apply to it\n"
+             << "  --serve ADDRESS  serve the engine protocol to many clients, one game per connection,\n"
+             << "                   on a localhost TCP port or a Unix socket path; moves\n"
+             << "                   are greedy, so it does not take --ai rollout or mcts\n";
+    }
+}
+
 /**
  * The main entry point for the game application.
+ * `--seed N` makes the dice reproducible; otherwise they are randomly seeded.
  * @return Exit code.
  */
-int main() {
-    srand(static_cast<unsigned int>(time(nullptr)));
+int main(int argc, char* argv[]) {
+    uint64_t seed = DiceSource::randomSeed();
+    string ai = "greedy";
+    RolloutConfig rolloutConfig;
+    MctsConfig mctsConfig;
+    size_t tableMegabytes = 16;
+    string journalFile;
+    GameJournal::Options journalOptions;
+    bool engine = false;
+    string serveAddress;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--seed" && hasValue)        seed = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--ai" && hasValue && (string(argv[i + 1]) == "greedy" || string(argv[i + 1]) == "rollout" ||
+                                               string(argv[i + 1]) == "mcts")) {
+            ai = argv[++i];
+        }
+        else if (arg == "--budget" && hasValue) rolloutConfig.budgetMs = mctsConfig.budgetMs = atoi(argv[++i]);
+        else if (arg == "--mcts-mode" && hasValue && (string(argv[i + 1]) == "tree" || string(argv[i + 1]) == "root")) {
+            mctsConfig.parallelism = string(argv[++i]) == "root" ? MctsConfig::Parallelism::Root
+                                                                  : MctsConfig::Parallelism::Tree;
+        }
+        else if (arg == "--tt-mb" && hasValue)  tableMegabytes = strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--journal" && hasValue) journalFile = argv[++i];
+        else if (arg == "--journal-async")      journalOptions.background = true;
+        else if (arg == "--engine")             engine = true;
+        else if (arg == "--serve" && hasValue)  serveAddress = argv[++i];
+        else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (engine && ai == "mcts") {
+        cerr << "The engine protocol chooses moves with greedy or rollout, not mcts." << endl;
+        return 1;
+    }
+    if (!serveAddress.empty() && ai != "greedy") {
+        // One thread serves every connection, so a search would stall them all.
+        cerr << "The server chooses moves greedily; --serve does not take --ai " << ai << "." << endl;
+        return 1;
+    }
+
     Board human(11);
     Board computer(11);
     Tournament tour(human, computer);
+    tour.getContext().setDice(DiceSource(seed));
+
+    GameJournal journal;
+    if (!journalFile.empty()) {
+        if (!journal.open(journalFile, journalOptions)) return 1;
+        tour.getContext().setJournal(&journal);
+    }
+
+    optional<WorkStealingPool> pool;
+    optional<RolloutSearch> search;
+    optional<MctsSearch> mcts;
+    optional<TranspositionTable> table;
+    if (ai != "greedy" && tableMegabytes > 0) {
+        rolloutConfig.table = mctsConfig.table = &table.emplace(tableMegabytes);
+    }
+    if (ai == "rollout") {
+        rolloutConfig.seed = seed;
+        search.emplace(rolloutConfig, &pool.emplace(0));
+        tour.getContext().setRolloutSearch(&*search);
+    } else if (ai == "mcts") {
+        mctsConfig.seed = seed;
+        tour.getContext().setMctsSearch(&mcts.emplace(mctsConfig, &pool.emplace(0)));
+    }
+
+    if (!serveAddress.empty()) {
+        GameServer server;
+        if (!server.listen(serveAddress, {seed})) return 1;
+        activeServer = &server;
+        signal(SIGINT, stopServer);
+        signal(SIGTERM, stopServer);
+        cout << "Serving the engine protocol on " << serveAddress << endl;
+        const bool served = server.run();
+        activeServer = nullptr;
+        return served ? 0 : 1;
+    }
+
+    if (engine) {
+        ios::sync_with_stdio(false);
+        EngineSession session(seed, 0, search ? &*search : nullptr);
+        string line, reply;
+        bool running = true;
+        while (running && getline(cin, line)) {
+            reply.clear();
+            running = session.execute(line, reply);
+            cout << reply << flush;
+        }
+        return 0;
+    }
+
     tour.start();
     return 0;
 }
@@ -0,0 +1,55 @@
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include "Header Files/DiceSource.h"
+#include "test_support.h"
+
+using namespace std;
+
+int main() {
+    // Philox4x32-10 known-answer vectors from the Random123 distribution (kat_vectors).
+    expect(DiceSource::philox({0, 0, 0, 0}, {0, 0}) ==
+           array<uint32_t, 4>{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}, "Philox of counter 0, key 0");
+    expect(DiceSource::philox({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, {0xffffffffu, 0xffffffffu}) ==
+           array<uint32_t, 4>{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}, "Philox of all-ones counter and key");
+    expect(DiceSource::philox({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, {0xa4093822u, 0x299f31d0u}) ==
+           array<uint32_t, 4>{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}, "Philox of the digits of pi");
+
+    // The rolls of a turn depend only on (seed, game, turn), however the source got there.
+    DiceSource played(42, 7);
+    int rolls[3][8];
+    for (int turn = 0; turn < 3; ++turn, played.nextTurn()) {
+        for (int& roll : rolls[turn]) roll = played.rollDie();
+    }
+    DiceSource jumped(42, 7);
+    jumped.seek(2);
+    bool same = true;
+    for (const int roll : rolls[2]) same = same && jumped.rollDie() == roll;
+    expect(same, "seeking to a turn replays its rolls");
+    jumped.seek(0);
+    same = true;
+    for (const int roll : rolls[0]) same = same && jumped.rollDie() == roll;
+    expect(same, "seeking back replays the first turn");
+
+    DiceSource otherGame(42, 8);
+    bool differs = false;
+    for (const int roll : rolls[0]) differs = differs || otherGame.rollDie() != roll;
+    expect(differs, "another game draws other rolls");
+
+    // Every face comes up, and nothing outside 1..6.
+    DiceSource faces(1);
+    int counts[7] = {};
+    bool inRange = true;
+    for (int i = 0; i < 60000; ++i) {
+        const int roll = faces.rollDie();
+        inRange = inRange && roll >= 1 && roll <= 6;
+        if (inRange) ++counts[roll];
+    }
+    expect(inRange, "rolls stay in 1..6");
+    bool even = true;
+    for (int face = 1; face <= 6; ++face) even = even && counts[face] > 9000 && counts[face] < 11000;
+    expect(even, "each face comes up about a sixth of the time");
+
+    cout << (failures == 0 ? "All dice source tests passed\n" : "Dice source tests failed\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Header Files/Board.h"
+#include "Header Files/GameJournal.h"
+#include "Header Files/JournalReplay.h"
+#include "test_support.h"
+
+using namespace std;
+
+namespace {
+    constexpr uint8_t HUMAN = static_cast<uint8_t>(GameContext::Side::Human);
+    constexpr uint8_t COMPUTER = static_cast<uint8_t>(GameContext::Side::Computer);
+
+    /** @return Mask of squares first..last. */
+    uint32_t squares(const int first, const int last) {
+        uint32_t mask = 0;
+        for (int i = first; i <= last; ++i) mask |= Board::bitOf(i);
+        return mask;
+    }
+
+    /**
+     * @return Two rounds of one game: a resumed round the Human wins by covering
+     *         square 9 for 40 points, then a new round with the Computer's
+     *         handicap on square 4 (the Human won moving first) that is still on.
+     */
+    vector<JournalRecord> twoRounds(const uint64_t game) {
+        const auto event = [game](const JournalEvent type, const uint8_t side = 0, const uint8_t value = 0,
+                                  const uint32_t mask = 0, const uint8_t flags = 0) {
+            return JournalRecord{game, mask, type, side, value, flags};
+        };
+        return {
+            event(JournalEvent::GameStart),
+            event(JournalEvent::RoundStart, 0, 9, 0, JOURNAL_RESUMED),
+            event(JournalEvent::Position, HUMAN, 0, squares(1, 8)),
+            event(JournalEvent::Position, COMPUTER, 0, squares(2, 3)),
+            event(JournalEvent::Score, HUMAN, 0, 10),
+            event(JournalEvent::Score, COMPUTER, 0, 20),
+            event(JournalEvent::FirstPlayer, HUMAN),
+            event(JournalEvent::DiceCount, HUMAN, 2),
+            event(JournalEvent::Roll, HUMAN, 9),
+            event(JournalEvent::Move, HUMAN, 0, Board::bitOf(9), JOURNAL_COVER),
+            event(JournalEvent::RoundEnd, HUMAN, 0, 40, JOURNAL_BY_COVER),
+
+            event(JournalEvent::RoundStart, 0, 9),
+            event(JournalEvent::Position, HUMAN, 0, 0),
+            event(JournalEvent::Position, COMPUTER, 0, Board::bitOf(4)),
+            event(JournalEvent::Score, HUMAN, 0, 50),
+            event(JournalEvent::Score, COMPUTER, 0, 20),
+            event(JournalEvent::Advantage, COMPUTER, 4, 0, JOURNAL_PROTECTED),
+            event(JournalEvent::FirstPlayer, HUMAN),
+            event(JournalEvent::DiceCount, HUMAN, 2),
+            event(JournalEvent::Roll, HUMAN, 7),
+            event(JournalEvent::Move, HUMAN, 0, Board::bitOf(3) | Board::bitOf(4), JOURNAL_COVER),
+        };
+    }
+
+    /** @return Errors found replaying records in memory. */
+    uint64_t errorsIn(const vector<JournalRecord>& records) {
+        JournalReplay replay(0);
+        ReplayStats stats;
+        replay.replay(records.data(), records.size(), stats);
+        return stats.errors;
+    }
+}
+
+int main() {
+    // A rule-abiding game replays without errors.
+    const vector<JournalRecord> game = twoRounds(1);
+    {
+        JournalReplay replay(0);
+        ReplayStats stats;
+        replay.replay(game.data(), game.size(), stats);
+        expect(stats.errors == 0 && stats.games == 1 && stats.rounds == 1 && stats.rolls == 2 && stats.moves == 2,
+               "a valid game replays cleanly");
+    }
+
+    // Each broken rule is caught.
+    {
+        vector<JournalRecord> broken = game;
+        broken[9].mask = Board::bitOf(8);
+        expect(errorsIn(broken) == 1, "a move that does not match the roll is an error");
+        broken = game;
+        broken[10].mask = 41;
+        expect(errorsIn(broken) == 1, "a misscored round is an error");
+        broken = game;
+        broken[14].mask = 10;
+        expect(errorsIn(broken) == 1, "a score that ignores the last round is an error");
+        broken = game;
+        broken[16].side = HUMAN;
+        expect(errorsIn(broken) == 1, "a handicap for the wrong side is an error");
+        broken = game;
+        broken[12].mask = Board::bitOf(3);
+        expect(errorsIn(broken) == 1, "a new round that does not start from empty boards is an error");
+        broken = game;
+        broken[19].value = 4;
+        broken[20].mask = Board::bitOf(4);
+        broken[20].flags = 0;
+        expect(errorsIn(broken) >= 1, "uncovering the protected advantage square is an error");
+        broken = game;
+        broken[7].value = 1;
+        expect(errorsIn(broken) == 1, "one die before the one-die rule applies is an error");
+    }
+
+    // Through a file: interleaved games, both writers, and a torn tail dropped on reopening.
+    const string path = (filesystem::temp_directory_path() / "canoga_test_journal.bin").string();
+    remove(path.c_str());
+    for (const bool background : {false, true}) {
+        GameJournal::Options options;
+        options.background = background;
+        options.batchRecords = 4;
+        GameJournal journal;
+        expect(journal.open(path, options), "journal opens");
+        const vector<JournalRecord> other = twoRounds(background ? 4 : 2);
+        const vector<JournalRecord> third = twoRounds(background ? 5 : 3);
+        for (size_t i = 0; i < game.size(); ++i) {
+            journal.append(other[i]);
+            journal.append(third[i]);
+        }
+        journal.close();
+    }
+    {
+        ofstream torn(path, ios::binary | ios::app);
+        torn.write("torn", 4);
+    }
+    {
+        GameJournal journal;
+        GameJournal::Options options;
+        expect(journal.open(path, options), "journal with a torn tail reopens");
+        for (const JournalRecord& record : twoRounds(6)) journal.append(record);
+    }
+    {
+        JournalReplay replay(0);
+        ReplayStats stats;
+        expect(replay.replayFile(path, stats), "journal file replays");
+        expect(stats.errors == 0 && stats.games == 5 && stats.rounds == 5 && stats.events == 5 * game.size(),
+               "every journaled game replays cleanly");
+        expect(filesystem::file_size(path) == sizeof(JournalHeader) + 5 * game.size() * sizeof(JournalRecord),
+               "the torn record was dropped");
+    }
+    remove(path.c_str());
+
+    cout << (failures == 0 ? "All journal tests passed\n" : "Journal tests failed\n");
+    return failures == 0 ? 0 : 1;
+}
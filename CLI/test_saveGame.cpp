@@ -0,0 +1,138 @@
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "Header Files/Board.h"
+#include "Header Files/SaveGame.h"
+#include "test_support.h"
+
+using namespace std;
+
+namespace {
+    /** @return A game saved mid-round, with an advantage in play and the dice recorded. */
+    SavedGame midRound() {
+        SavedGame game;
+        game.boardSize = 10;
+        game.computerMask = Board::bitOf(1) | Board::bitOf(4) | Board::bitOf(10);
+        game.humanMask = Board::bitOf(2) | Board::bitOf(3) | Board::bitOf(9);
+        game.computerScore = 27;
+        game.humanScore = 41;
+        game.firstPlayerIsHuman = false;
+        game.isHumanTurn = true;
+        game.pendingAdvantageSquare = 6;
+        game.pendingAdvantageFor = GameContext::Side::Human;
+        game.advantage.applied = true;
+        game.advantage.square = 3;
+        game.advantage.owner = GameContext::Side::Computer;
+        game.advantage.protectComputer = true;
+        game.diceSaved = true;
+        game.diceSeed = 0x0123456789ABCDEFull;
+        game.diceGameId = 7;
+        game.diceTurn = 19;
+        return game;
+    }
+}
+
+int main() {
+    const SavedGame game = midRound();
+
+    // Text format: write and read back.
+    {
+        stringstream text;
+        savegame::writeText(text, game);
+        SavedGame loaded;
+        expect(savegame::readText(text, loaded) == nullptr, "text save reads back");
+        expect(loaded == game, "text save round-trips every field");
+    }
+
+    // Text written before the advantage and dice lines existed still loads.
+    {
+        stringstream text("Computer:\n   Squares: 0 2 3 4 5 6 7 8 0\n   Score: 12\n"
+                          "Human:\n   Squares: 1 0 3 4 5 6 7 8 9\n   Score: 5\n"
+                          "First Turn: Human\nNext Turn: Computer\n");
+        SavedGame loaded;
+        expect(savegame::readText(text, loaded) == nullptr, "original text save reads");
+        expect(loaded.boardSize == 9 && loaded.computerMask == (Board::bitOf(1) | Board::bitOf(9)) &&
+               loaded.humanMask == Board::bitOf(2) && loaded.computerScore == 12 && loaded.humanScore == 5 &&
+               loaded.firstPlayerIsHuman && !loaded.isHumanTurn && !loaded.advantage.applied && !loaded.diceSaved,
+               "original text save keeps its fields and defaults the rest");
+    }
+
+    // Malformed text is rejected rather than half loaded.
+    {
+        stringstream humanFirst("Human:\n   Squares: 1 2 3\n   Score: 0\n");
+        stringstream sizes("Computer:\n   Squares: 1 2 3 4 5 6 7 8 9\n   Score: 0\n"
+                           "Human:\n   Squares: 1 2 3\n   Score: 0\n");
+        stringstream noScore("Computer:\n   Squares: 1 2 3 4 5 6 7 8 9\n");
+        SavedGame loaded = game;
+        expect(savegame::readText(humanFirst, loaded) != nullptr, "text with the Human board first is rejected");
+        expect(savegame::readText(sizes, loaded) != nullptr, "text with boards of different sizes is rejected");
+        expect(savegame::readText(noScore, loaded) != nullptr, "text without a score is rejected");
+        expect(loaded == game, "a rejected text save leaves the game untouched");
+    }
+
+    // Binary format: encode and decode.
+    const SaveFileRecord record = savegame::toRecord(game);
+    {
+        SavedGame loaded;
+        expect(savegame::fromBinary(&record, sizeof(record), loaded) == nullptr, "binary save decodes");
+        expect(loaded == game, "binary save round-trips every field");
+    }
+
+    // Damaged and truncated records are rejected.
+    {
+        SaveFileRecord damaged = record;
+        damaged.humanScore ^= 1;
+        SavedGame loaded;
+        const char* error = savegame::fromBinary(&damaged, sizeof(damaged), loaded);
+        expect(error != nullptr && strcmp(error, "CRC mismatch") == 0, "a changed field fails the CRC");
+        damaged = record;
+        damaged.crc ^= 0x80000000u;
+        expect(savegame::fromBinary(&damaged, sizeof(damaged), loaded) != nullptr, "a changed CRC fails");
+        expect(savegame::fromBinary(&record, sizeof(record) - 1, loaded) != nullptr, "a truncated record is rejected");
+    }
+
+    // A 40-byte version 1 record loads with no advantage in play and no dice.
+    {
+        SaveFileRecord fields = record;
+        fields.version = 1;
+        constexpr size_t crcOffset = offsetof(SaveFileRecord, advantageOwner);
+        unsigned char version1[savegame::VERSION_1_SIZE];
+        memcpy(version1, &fields, crcOffset);
+        const uint32_t crc = savegame::crc32(version1, crcOffset);
+        memcpy(version1 + crcOffset, &crc, sizeof(crc));
+
+        SavedGame loaded;
+        expect(savegame::fromBinary(version1, sizeof(version1), loaded) == nullptr, "version 1 record decodes");
+        SavedGame expected = game;
+        expected.advantage = {};
+        expected.diceSaved = false;
+        expected.diceSeed = expected.diceGameId = expected.diceTurn = 0;
+        expect(loaded == expected, "version 1 record keeps its fields and defaults the rest");
+        version1[12] ^= 1;
+        expect(savegame::fromBinary(version1, sizeof(version1), loaded) != nullptr, "damaged version 1 record fails the CRC");
+    }
+
+    // Files: the name picks the format written, the contents the format read.
+    {
+        const filesystem::path directory = filesystem::temp_directory_path();
+        const string binaryName = (directory / "canoga_test_save.cgs").string();
+        const string textName = (directory / "canoga_test_save.txt").string();
+        expect(savegame::formatFor(binaryName) == savegame::Format::Binary, ".cgs names select binary");
+        expect(savegame::formatFor(textName) == savegame::Format::Text, "other names select text");
+        SavedGame fromBinary, fromText;
+        expect(savegame::save(binaryName, game, savegame::Format::Binary) && savegame::load(binaryName, fromBinary) &&
+               fromBinary == game, "binary save file round-trips");
+        expect(filesystem::file_size(binaryName) == sizeof(SaveFileRecord), "binary save file is one record");
+        expect(savegame::save(textName, game, savegame::Format::Text) && savegame::load(textName, fromText) &&
+               fromText == game, "text save file round-trips");
+        remove(binaryName.c_str());
+        remove(textName.c_str());
+    }
+
+    cout << (failures == 0 ? "All save format tests passed\n" : "Save format tests failed\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+/**
+ * @file test_support.h
+ * @brief Expectation counting shared by the test programs: each one calls
+ *        expect() for its checks and returns nonzero when any has failed.
+ */
+
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+#include <iostream>
+
+/** @brief Expectations that have failed so far. */
+inline int failures = 0;
+
+/** @brief Report a failed expectation. */
+inline void expect(const bool condition, const char* what) {
+    if (!condition) {
+        std::cout << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+#endif //TEST_SUPPORT_H
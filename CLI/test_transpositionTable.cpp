@@ -0,0 +1,127 @@
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "Header Files/DiceSource.h"
+#include "Header Files/GameState.h"
+#include "Header Files/TranspositionTable.h"
+#include "test_support.h"
+
+using namespace std;
+
+namespace {
+    using strategy::StrategyResult;
+}
+
+int main() {
+    // The incremental hash always equals a rehash, and unmake restores it exactly.
+    {
+        DiceSource dice(5);
+        bool incremental = true, restored = true;
+        for (int game = 0; game < 200; ++game) {
+            GameState state(9 + game % 3, game % 2);
+            if (game % 4 == 0) {
+                state.protectedSquare = 2;
+                state.rehash();
+            }
+            vector<GameState::Undo> undo;
+            vector<uint64_t> hashes;
+            for (int step = 0; step < 40; ++step) {
+                const int sum = dice.rollDie() + dice.rollDie();
+                MoveList moves = state.own().findValidMoves(sum, true);
+                StrategyResult move{StrategyResult::Action::Cover, 0};
+                if (moves.empty()) {
+                    moves = state.opponent().findValidMoves(sum, false);
+                    if (state.protectedSquare > 0) moves.removeTouching(state.protectedSquare);
+                    move.action = StrategyResult::Action::Uncover;
+                }
+                hashes.push_back(state.hash);
+                if (moves.empty()) {
+                    undo.push_back(state.passTurn());
+                } else {
+                    move.combo = moves[static_cast<int>(dice.uniform(static_cast<uint32_t>(moves.size())))];
+                    undo.push_back(state.makeMove(move));
+                }
+                const uint64_t hash = state.hash;
+                state.rehash();
+                incremental = incremental && state.hash == hash;
+            }
+            for (size_t i = undo.size(); i-- > 0;) {
+                state.unmake(undo[i]);
+                restored = restored && state.hash == hashes[i];
+            }
+        }
+        expect(incremental, "incremental hash matches a full rehash");
+        expect(restored, "unmake restores the hash");
+    }
+
+    // The same position reached by two move orders has one hash; the side to move changes it.
+    {
+        GameState first(9), second(9);
+        first.makeMove({StrategyResult::Action::Cover, Board::bitOf(3) | Board::bitOf(4)});
+        first.makeMove({StrategyResult::Action::Cover, Board::bitOf(9)});
+        second.makeMove({StrategyResult::Action::Cover, Board::bitOf(9)});
+        second.makeMove({StrategyResult::Action::Cover, Board::bitOf(4) | Board::bitOf(3)});
+        expect(first.hash == second.hash, "transposed move orders hash alike");
+        const uint64_t before = second.hash;
+        second.passTurn();
+        expect(second.hash != before, "the side to move is part of the hash");
+        expect(zobrist::hashOf(9, 0, 0, 0, 0) != zobrist::hashOf(10, 0, 0, 0, 0), "the board size is part of the hash");
+    }
+
+    // Entries: flipping and capping keep the value.
+    {
+        const TranspositionTable::Entry entry{150, 100};
+        expect(entry.flipped().points == 50 && entry.flipped().samples == 100, "flipped gives the other seat's points");
+        const TranspositionTable::Entry capped = entry.cappedAt(10);
+        expect(capped.points == 15 && capped.samples == 10, "capping keeps the mean");
+        expect(entry.cappedAt(1000).samples == 100, "capping above the samples changes nothing");
+    }
+
+    // Store and probe: depth-preferred replacement within a bucket.
+    {
+        TranspositionTable table(1);
+        const uint64_t key = 0x1234'5678'9ABC'DEF0ull;
+        const uint64_t sameBucket = key + (uint64_t{1} << 40);
+        TranspositionTable::Entry entry;
+        expect(!table.probe(key, entry), "an empty table holds nothing");
+        table.store(key, {30, 20});
+        expect(table.probe(key, entry) && entry.points == 30 && entry.samples == 20, "a stored entry is found");
+        table.store(key, {3, 2});
+        expect(table.probe(key, entry) && entry.samples == 20, "a shallower value does not replace a deeper one");
+        table.store(sameBucket, {8, 5});
+        expect(table.probe(key, entry) && entry.samples == 20 && table.probe(sameBucket, entry) && entry.samples == 5,
+               "two positions share a bucket");
+        table.store(sameBucket + (uint64_t{1} << 41), {1, 1});
+        expect(table.probe(key, entry) && entry.samples == 20, "the deepest entry survives newer shallow ones");
+        expect(!table.probe(key ^ 1, entry), "another key misses");
+        table.clear();
+        expect(!table.probe(key, entry), "clear forgets every position");
+    }
+
+    // Concurrent stores and probes never return another position's value.
+    {
+        TranspositionTable table(1);
+        atomic<bool> wrong{false};
+        vector<thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&table, &wrong, t] {
+                DiceSource keys(static_cast<uint64_t>(t));
+                for (int i = 0; i < 200000; ++i) {
+                    // Few distinct keys, so threads keep colliding on the same buckets.
+                    const uint64_t key = (uint64_t{keys.uniform(64)} << 48) | keys.uniform(64);
+                    const uint32_t tag = static_cast<uint32_t>(key >> 48) * 64 + static_cast<uint32_t>(key & 63);
+                    table.store(key, {tag, tag + 1 + static_cast<uint32_t>(i % 7)});
+                    TranspositionTable::Entry entry;
+                    if (table.probe(key, entry) && entry.points != tag) wrong = true;
+                }
+            });
+        }
+        for (thread& worker : threads) worker.join();
+        expect(!wrong, "concurrent probes only return their own position's value");
+    }
+
+    cout << (failures == 0 ? "All transposition table tests passed\n" : "Transposition table tests failed\n");
+    return failures == 0 ? 0 : 1;
+}